@@ -5,7 +5,7 @@
 #include <core/utils/string.hpp>
 #include <dumb_tasks/error_handler.hpp>
 #include <dumb_tasks/scheduler.hpp>
-#include <engine/assets/asset_list.hpp>
+#include <engine/assets/asset_graph.hpp>
 #include <engine/assets/asset_loaders.hpp>
 #include <engine/cameras/freecam.hpp>
 #include <engine/editor/controls/inspector.hpp>
@@ -13,6 +13,7 @@
 #include <engine/input/control.hpp>
 #include <engine/render/model.hpp>
 #include <engine/scene/scene_drawer.hpp>
+#include <engine/scene/scene_index.hpp>
 #include <engine/scene/scene_node.hpp>
 #include <graphics/common.hpp>
 #include <graphics/render/renderers.hpp>
@@ -212,49 +213,52 @@ class DrawDispatch {
 			dl.count = std::min((u32)lights.size(), (u32)dl.lights.size());
 			m_view.lights.write(dl);
 		}
-		for (auto& group : g3D) { update(group); }
-		for (auto& group : gUI) { update(group); }
+		// storage reused across frames
+		for (auto& [_, batches] : m_batches) { batches.clear(); }
+		// blended groups are order sensitive
+		for (auto& group : g3D) { update(group, group.group.pipeline && group.group.pipeline->blended()); }
+		// UI is order sensitive (overlapping / blended)
+		for (auto& group : gUI) { update(group, true); }
 	}
 
-	void update(SceneDrawer::Group const& group) const {
+	void update(SceneDrawer::Group const& group, bool bOrdered) {
 		DescriptorMap map(group.group.pipeline);
 		auto set0 = map.set(0);
 		set0.update(0, m_view.mats);
 		if (group.group.order >= 0) { set0.update(1, m_view.lights); }
-		for (SceneDrawer::Item const& item : group.items) {
-			if (!item.primitives.empty()) {
-				map.set(1).update(0, item.model);
-				for (Primitive const& prim : item.primitives) {
-					Material const& mat = prim.material;
-					if (group.group.order < 0) {
-						ensure(mat.map_Kd, "Null cubemap");
-						set0.update(1, *mat.map_Kd);
-					}
-					auto set2 = map.set(2);
-					set2.update(0, mat.map_Kd ? *mat.map_Kd : *m_defaults.white);
-					set2.update(1, mat.map_d ? *mat.map_d : *m_defaults.white);
-					set2.update(2, mat.map_Ks ? *mat.map_Ks : *m_defaults.black);
-					map.set(3).update(0, ShadeMat::make(mat));
-				}
+		auto& batches = m_batches[group.group];
+		m_instancer.instance(batches, group.items, bOrdered);
+		for (SceneDrawer::Instances const& batch : batches) {
+			Material const& mat = batch.primitive->material;
+			map.set(1).updateArray<glm::mat4>(0, batch.models);
+			if (group.group.order < 0) {
+				ensure(mat.map_Kd, "Null cubemap");
+				set0.update(1, *mat.map_Kd);
 			}
+			auto set2 = map.set(2);
+			set2.update(0, mat.map_Kd ? *mat.map_Kd : *m_defaults.white);
+			set2.update(1, mat.map_d ? *mat.map_d : *m_defaults.white);
+			set2.update(2, mat.map_Ks ? *mat.map_Ks : *m_defaults.black);
+			map.set(3).update(0, ShadeMat::make(mat));
 		}
 	}
 
 	void draw(graphics::CommandBuffer cb, SceneDrawer::Group const& group) const {
 		DescriptorBinder bind(group.group.pipeline, cb);
 		bind(0);
-		for (SceneDrawer::Item const& d : group.items) {
-			if (!d.primitives.empty()) {
-				bind(1);
-				if (d.scissor) { cb.setScissor(*d.scissor); }
-				for (Primitive const& prim : d.primitives) {
-					bind({2, 3});
-					ensure(prim.mesh, "Null mesh");
-					prim.mesh->draw(cb);
-				}
+		if (auto it = m_batches.find(group.group); it != m_batches.end()) {
+			for (SceneDrawer::Instances const& batch : it->second) {
+				if (!bind({1, 2, 3})) { continue; }
+				if (batch.scissor) { cb.setScissor(*batch.scissor); }
+				ensure(batch.primitive->mesh, "Null mesh");
+				batch.primitive->mesh->draw(cb, (u32)batch.models.size());
 			}
 		}
 	}
+
+  private:
+	std::unordered_map<DrawGroup, std::vector<SceneDrawer::Instances>, DrawGroup::Hasher> m_batches;
+	SceneDrawer::Instancer m_instancer;
 };
 
 using graphics::CommandBuffer;
@@ -345,6 +349,7 @@ class App : public input::Receiver {
 			pipelineLD.shaderID = shaderID;
 			pipelineLD.info = pci;
 			pipelineLD.flags = flags;
+			pipelineLD.dynamicSets = {3};
 			return pipelineLD;
 		};
 		m_store.resources().reader(&reader);
@@ -366,13 +371,13 @@ class App : public input::Receiver {
 				ald.modelID = "models/nanosuit";
 				models.add("models/nanosuit", std::move(ald));
 			}
-			m_data.loader.stage(m_store, models, m_tasks);
+			m_data.loader.add(m_store, models);
 		}
 
 		AssetLoadData<BitmapFont> fld(&m_eng->gfx().boot.vram);
 		fld.jsonID = "fonts/default/default.json";
 		fld.samplerID = "samplers/default";
-		m_data.loader.stage(m_store, AssetList<BitmapFont>{{{"fonts/default", std::move(fld)}}}, m_tasks);
+		m_data.loader.add(m_store, AssetList<BitmapFont>{{{"fonts/default", std::move(fld)}}});
 		{
 			graphics::Geometry gcube = graphics::makeCube(0.5f);
 			auto const skyCubeI = gcube.indices;
@@ -392,7 +397,7 @@ class App : public input::Receiver {
 			shaders.add("shaders/lit", loadShader("shaders/lit", "shaders/lit.vert", "shaders/lit.frag"));
 			shaders.add("shaders/ui", loadShader("shaders/ui", "shaders/ui.vert", "shaders/ui.frag"));
 			shaders.add("shaders/skybox", loadShader("shaders/skybox", "shaders/skybox.vert", "shaders/skybox.frag"));
-			auto load_shaders = m_data.loader.stage(m_store, shaders, m_tasks);
+			m_data.loader.add(m_store, shaders);
 
 			AssetList<graphics::Pipeline> pipes;
 			static PCI pci_skybox = eng->gfx().context.pipeInfo();
@@ -405,7 +410,8 @@ class App : public input::Receiver {
 			ui.reset(graphics::PFlags(graphics::PFlag::eDepthTest) | graphics::PFlag::eDepthWrite);
 			pipes.add("pipelines/ui", loadPipe("pipelines/ui", "shaders/ui", true, ui));
 			pipes.add("pipelines/skybox", loadPipe("pipelines/skybox", "shaders/skybox", false, {}, pci_skybox));
-			m_data.loader.stage(m_store, pipes, m_tasks, load_shaders);
+			// pipelines wait for their shaders (inferred from shaderID)
+			m_data.loader.add(m_store, pipes);
 		}
 
 		AssetList<graphics::Texture> texList;
@@ -434,7 +440,8 @@ class App : public input::Receiver {
 		texList.add("textures/white", std::move(textureLD));
 		textureLD.bitmap.bytes = graphics::utils::bitmapPx({0x0});
 		texList.add("textures/blank", std::move(textureLD));
-		m_data.loader.stage(m_store, texList, m_tasks);
+		m_data.loader.add(m_store, texList);
+		m_data.loader.stage(m_tasks);
 		m_eng->pushReceiver(this);
 		eng->m_win->show();
 
@@ -475,7 +482,7 @@ class App : public input::Receiver {
 	}
 
 	bool block(input::State const& state) override {
-		if (state.focus == input::Focus::eGained) { m_store.update(); }
+		if (state.focus == input::Focus::eGained) { m_store.update(&m_tasks); }
 		if (m_controls.editor(state)) { Editor::s_engaged = !Editor::s_engaged; }
 		return false;
 	}
@@ -489,6 +496,7 @@ class App : public input::Receiver {
 	decf::spawn_t<SceneNode> spawn(std::string name, DrawGroup const& group, Span<Primitive const> primitives) {
 		auto ret = spawn(std::move(name));
 		SceneDrawer::attach(m_data.registry, ret, group, primitives);
+		m_data.drawList.add(ret);
 		return ret;
 	};
 
@@ -496,13 +504,14 @@ class App : public input::Receiver {
 		auto m = m_store.get<graphics::Mesh>(meshID);
 		auto ret = spawn(std::move(name));
 		SceneDrawer::attach(m_data.registry, ret, group, Primitive{mat, &*m});
+		m_data.drawList.add(ret);
 		return ret;
 	};
 
 	decf::spawn_t<SceneNode> spawn(std::string name, Hash modelID, DrawGroup const& group) {
-		auto m = m_store.get<Model>(modelID);
 		auto ret = spawn(std::move(name));
-		SceneDrawer::attach(m_data.registry, ret, group, m->primitives());
+		SceneDrawer::attach(m_data.registry, ret, group, m_store.get<Model>(modelID));
+		m_data.drawList.add(ret);
 		return ret;
 	};
 
@@ -601,6 +610,8 @@ class App : public input::Receiver {
 				Primitive prim = model->get().primitives().front();
 				prim.material.Tf = {0xfc4340ff, RGBA::Type::eAbsolute};
 				auto ent0 = spawn("model_1_0", m_data.groups["test_lit"], prim);
+				// prim.mesh points into model: keep it resident
+				m_data.registry.attach<Asset<Model>>(ent0, *model);
 				ent0.get<SceneNode>().position({2.0f, -1.0f, 2.0f});
 				m_data.entities["model_1_0"] = ent0;
 			}
@@ -621,9 +632,13 @@ class App : public input::Receiver {
 			Editor::s_in.registry = &m_data.registry;
 			Editor::s_in.root = &m_data.root;
 			Editor::s_in.customEntities.push_back(m_data.camera);
+			// previous frame's index / camera: picked on the next editor update
+			Editor::s_in.pick = {&m_data.index, m_data.viewProj};
 		}
 
 		if (!m_data.loader.ready(&m_tasks)) { return; }
+		// swap in hot reloads completed on worker threads
+		if (m_store.reloading()) { m_store.update(&m_tasks); }
 		if (m_data.registry.empty()) { init1(); }
 		auto guiStack = m_data.registry.find<gui::ViewStack>(m_data.guiStack);
 		if (guiStack) {
@@ -672,9 +687,14 @@ class App : public input::Receiver {
 	void render() {
 		if (auto frame = m_eng->beginDraw()) {
 			// write / update
-			std::vector<SceneDrawer::Group> gr3D, grUI;
+			Span<SceneDrawer::Group const> gr3D;
+			std::vector<SceneDrawer::Group> grUI;
 			if (auto cam = m_data.registry.find<FreeCam>(m_data.camera)) {
-				gr3D = SceneDrawer::groups(m_data.registry, true);
+				SceneNode::refreshAll(m_data.root);
+				gr3D = m_data.drawList.build(m_data.registry, true, &m_tasks);
+				m_data.index.sync(m_data.registry);
+				m_data.viewProj = cam->perspective(m_eng->sceneSpace()) * cam->view();
+				gr3D = m_data.culler.cull(gr3D, graphics::Frustum::make(m_data.viewProj), m_data.index, &m_tasks);
 				grUI = SceneDrawer::groups<SceneDrawer::PopulatorUI>(m_data.registry, true);
 				m_drawDispatch.write(*cam, m_eng->sceneSpace(), m_data.dirLights, gr3D, grUI);
 			}
@@ -697,7 +717,11 @@ class App : public input::Receiver {
 		decf::entity_t camera;
 		decf::entity_t player;
 		decf::entity_t guiStack;
-		AssetListLoader loader;
+		AssetGraphLoader loader;
+		SceneDrawer::Builder drawList;
+		SceneDrawer::Culler culler;
+		SceneIndex index;
+		glm::mat4 viewProj = glm::mat4(1.0f);
 	};
 
 	Data m_data;
@@ -0,0 +1,158 @@
+#pragma once
+#include <functional>
+#include <string_view>
+#include <vector>
+#include <core/time.hpp>
+#include <dumb_tasks/scheduler.hpp>
+#include <engine/assets/asset_list.hpp>
+
+namespace le {
+///
+/// \brief Assets and Resources that loading an asset depends on
+///
+struct AssetDepends {
+	struct Res {
+		io::Path path;
+		Resource::Type type = Resource::Type::eBinary;
+	};
+	///
+	/// \brief Resources named inside a prefetched text resource (json -> obj / mtl, mtl -> textures, ...): prefetched in turn
+	///
+	struct Named {
+		using Infer = std::vector<Res> (*)(io::Path const& jsonID, Res const& res, std::string_view text);
+
+		io::Path jsonID;
+		Infer infer = {};
+	};
+
+	std::vector<Hash> assets;
+	std::vector<Res> resources;
+	Named named;
+};
+
+namespace detail {
+std::vector<AssetDepends::Res> modelSources(io::Path const& jsonID, AssetDepends::Res const& res, std::string_view text);
+std::vector<AssetDepends::Res> fontAtlas(io::Path const& jsonID, AssetDepends::Res const& res, std::string_view text);
+} // namespace detail
+
+///
+/// \brief Customisation point: infer dependencies from well known AssetLoadData members
+///
+/// Assets: `samplerID`, `shaderID`; Resources: `jsonID`, `imageIDs` (with `prefix` / `ext`); named in the json:
+/// obj / mtl / baked blob and textures in the mtl (with `modelID`), else the atlas (`sheetID`)
+///
+template <typename T>
+AssetDepends assetDepends(AssetLoadData<T> const& data);
+
+///
+/// \brief Customisation point: block until an asset's VRAM transfers have completed (calls `wait()` if present)
+///
+template <typename T>
+void assetWait(T const& asset);
+
+///
+/// \brief Loads AssetLists in parallel, ordering assets by dependencies inferred via assetDepends()
+///
+/// Each asset is split into three stages: I/O (prefetches its Resources), decode (constructs the asset: CPU decode and
+/// VRAM staging), which depends on its I/O and on the decode stages of its dependencies, and upload (waits for its
+/// VRAM transfers via assetWait()), which depends on its decode. Reads, decodes and transfers of independent assets
+/// overlap across workers; dependents don't wait for uploads. Assets already present in the store, and dependencies
+/// not in the graph, are ignored.
+///
+class AssetGraphLoader {
+  public:
+	using Scheduler = dts::scheduler;
+	using StageID = Scheduler::stage_id;
+
+	///
+	/// \brief Wall-clock span of each phase (earliest start to latest end across all assets; phases overlap)
+	///
+	struct Timings {
+		Time_ms io{};
+		Time_ms decode{};
+		Time_ms upload{};
+		Time_ms total{};
+		std::size_t count = 0;
+		std::size_t failed = 0;
+	};
+
+	template <typename T>
+	std::size_t add(AssetStore& store, AssetList<T> const& list);
+
+	std::size_t stage(Scheduler& scheduler);
+	std::size_t load();
+	bool ready(Scheduler const* scheduler) const noexcept;
+	Timings timings() const noexcept;
+
+  private:
+	struct Node {
+		std::string id;
+		AssetDepends depends;
+		std::function<bool()> decode;
+		std::function<void()> upload;
+		not_null<AssetStore*> store;
+		std::vector<Hash> transient; // prefetched, released after decode
+		std::vector<Hash> watched;	 // prefetched, unwatched after decode
+	};
+	struct State;
+
+	std::vector<std::size_t> sorted() const;
+	std::shared_ptr<State> begin();
+
+	std::vector<Node> m_nodes;
+	std::vector<StageID> m_staged;
+	std::shared_ptr<State> m_state;
+};
+
+// impl
+
+template <typename T>
+AssetDepends assetDepends(AssetLoadData<T> const& data) {
+	AssetDepends ret;
+	if constexpr (requires { Hash(data.samplerID); }) {
+		if (data.samplerID != Hash()) { ret.assets.push_back(data.samplerID); }
+	}
+	if constexpr (requires { Hash(data.shaderID); }) {
+		if (data.shaderID != Hash()) { ret.assets.push_back(data.shaderID); }
+	}
+	if constexpr (requires { io::Path(data.jsonID); }) {
+		if (!data.jsonID.empty()) {
+			ret.resources.push_back({data.jsonID, Resource::Type::eText});
+			if constexpr (requires { data.modelID; }) {
+				ret.named = {data.jsonID, &detail::modelSources};
+			} else {
+				ret.named = {data.jsonID, &detail::fontAtlas};
+			}
+		}
+	}
+	if constexpr (requires { data.imageIDs.begin(); }) {
+		for (auto const& imageID : data.imageIDs) {
+			io::Path path = data.prefix / imageID;
+			path += data.ext;
+			ret.resources.push_back({std::move(path), Resource::Type::eBinary});
+		}
+	}
+	return ret;
+}
+
+template <typename T>
+void assetWait(T const& asset) {
+	if constexpr (requires { asset.wait(); }) { asset.wait(); }
+}
+
+template <typename T>
+std::size_t AssetGraphLoader::add(AssetStore& store, AssetList<T> const& list) {
+	std::size_t ret = 0;
+	for (auto const& [id, data] : list.m_data) {
+		if (!store.contains<T>(id)) {
+			auto decode = [&store, id = id, data = data]() mutable { return store.load<T>(id, std::move(data)).has_value(); };
+			auto upload = [&store, id = id]() {
+				if (auto asset = store.find<T>(id)) { assetWait<T>(asset->get()); }
+			};
+			m_nodes.push_back({id.generic_string(), assetDepends<T>(data), std::move(decode), std::move(upload), &store, {}, {}});
+			++ret;
+		}
+	}
+	return ret;
+}
+} // namespace le
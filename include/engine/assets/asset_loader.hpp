@@ -1,4 +1,6 @@
 #pragma once
+#include <type_traits>
+#include <utility>
 #include <vector>
 #include <core/delegate.hpp>
 #include <core/utils/algo.hpp>
@@ -24,11 +26,24 @@ class AssetLoadInfo {
 
 	template <typename Data>
 	AssetLoadInfo(not_null<AssetStore const*> store, not_null<Resources*> resources, not_null<OnModified*> onModified, Data&& data, Hash id);
+	AssetLoadInfo(AssetLoadInfo&& rhs) noexcept;
+	AssetLoadInfo& operator=(AssetLoadInfo&& rhs) noexcept;
+	~AssetLoadInfo();
 
-	Resource const* resource(io::Path const& path, Resource::Type type, bool bMonitor, bool bForceReload = false) const;
+	///
+	/// \brief Load (or obtain cached) resource; monitored resources are watched until this info is destroyed
+	///
+	Resource const* resource(io::Path const& path, Resource::Type type, Resource::Policy policy, bool bForceReload = false) const;
+	///
+	/// \brief Release transient resources obtained via resource() (invoked by AssetStore after each load / reload)
+	///
+	void release() const;
 	io::Reader const& reader() const;
 	bool modified() const;
 	void forceDirty(bool bDirty) const noexcept;
+	Span<Hash const> depends() const noexcept;
+	u64 resourceBytes() const noexcept;
+	AssetLoadInfo<T> clone() const;
 
 	template <typename U>
 	void reloadDepend(Asset<U>& out_asset) const; // impl in asset_store.hpp; must include to instantiate!
@@ -40,9 +55,13 @@ class AssetLoadInfo {
 	Hash m_id;
 
   private:
+	void unwatch() const;
+
 	not_null<Resources*> m_resources;
 	mutable std::unordered_map<Hash, not_null<Resource const*>> m_monitors;
 	mutable std::vector<OnModified::Tk> m_tokens;
+	mutable std::vector<Hash> m_depends;
+	mutable std::vector<Hash> m_transient;
 	mutable bool m_bDirty = false;
 };
 
@@ -52,6 +71,29 @@ struct AssetLoader {
 	bool reload(T& out_t, AssetLoadInfo<T> const& info) const;
 };
 
+///
+/// \brief Customisation point: whether hot reloads may build a fresh T via AssetLoader<T>::load() on a worker thread
+///
+/// The result is move-assigned over the existing asset at a frame boundary (AssetStore::update());
+/// specialise to false where reload() must mutate the existing instance (it then runs on the updating thread).
+///
+template <typename T>
+inline constexpr bool asyncReload_v = std::is_move_assignable_v<T> && std::is_copy_constructible_v<AssetLoadData<T>>;
+
+///
+/// \brief Customisation point: VRAM bytes held by an asset (for residency budgets); uses `t.bytes()` if present
+///
+template <typename T>
+struct AssetSize {
+	u64 operator()(T const& t) const noexcept {
+		if constexpr (requires { u64(t.bytes()); }) {
+			return u64(t.bytes());
+		} else {
+			return 0;
+		}
+	}
+};
+
 // impl
 
 template <typename T>
@@ -59,15 +101,58 @@ template <typename Data>
 AssetLoadInfo<T>::AssetLoadInfo(not_null<AssetStore const*> store, not_null<Resources*> resources, not_null<OnModified*> onModified, Data&& data, Hash id)
 	: m_data(std::forward<Data>(data)), m_store(store), m_onModified(onModified), m_id(id), m_resources(resources) {}
 template <typename T>
-Resource const* AssetLoadInfo<T>::resource(io::Path const& path, Resource::Type type, bool bMonitor, bool bForceReload) const {
-	if (auto pRes = m_resources->load(path, type, bMonitor, bForceReload)) {
+AssetLoadInfo<T>::AssetLoadInfo(AssetLoadInfo&& rhs) noexcept
+	: m_data(std::move(rhs.m_data)), m_store(rhs.m_store), m_onModified(rhs.m_onModified), m_id(rhs.m_id), m_resources(rhs.m_resources),
+	  m_monitors(std::exchange(rhs.m_monitors, {})), m_tokens(std::move(rhs.m_tokens)), m_depends(std::move(rhs.m_depends)),
+	  m_transient(std::exchange(rhs.m_transient, {})), m_bDirty(rhs.m_bDirty) {}
+template <typename T>
+AssetLoadInfo<T>& AssetLoadInfo<T>::operator=(AssetLoadInfo&& rhs) noexcept {
+	if (&rhs != this) {
+		unwatch();
+		m_data = std::move(rhs.m_data);
+		m_store = rhs.m_store;
+		m_onModified = rhs.m_onModified;
+		m_id = rhs.m_id;
+		m_resources = rhs.m_resources;
+		m_monitors = std::exchange(rhs.m_monitors, {});
+		m_tokens = std::move(rhs.m_tokens);
+		m_depends = std::move(rhs.m_depends);
+		m_transient = std::exchange(rhs.m_transient, {});
+		m_bDirty = rhs.m_bDirty;
+	}
+	return *this;
+}
+template <typename T>
+AssetLoadInfo<T>::~AssetLoadInfo() {
+	unwatch();
+}
+template <typename T>
+Resource const* AssetLoadInfo<T>::resource(io::Path const& path, Resource::Type type, Resource::Policy policy, bool bForceReload) const {
+	if (auto pRes = m_resources->load(path, type, policy, bForceReload)) {
 		auto const pathStr = path.generic_string();
-		if (bMonitor && !m_monitors.contains(pathStr)) { m_monitors.emplace(pathStr, pRes); }
+		if (pRes->transient(policy)) {
+			m_transient.push_back(pathStr);
+		} else if (pRes->watched(policy) && !m_monitors.emplace(pathStr, pRes).second) {
+			// one reference per path
+			m_resources->unwatch(pathStr);
+		}
 		return pRes;
 	}
 	return nullptr;
 }
 template <typename T>
+void AssetLoadInfo<T>::release() const {
+	for (Hash const id : m_transient) { m_resources->release(id); }
+	m_transient.clear();
+}
+template <typename T>
+void AssetLoadInfo<T>::unwatch() const {
+	release();
+	// evicted / replaced infos free monitored resources no other asset is watching
+	for (auto const& [id, _] : m_monitors) { m_resources->unwatch(id); }
+	m_monitors.clear();
+}
+template <typename T>
 io::Reader const& AssetLoadInfo<T>::reader() const {
 	return m_resources->reader();
 }
@@ -84,6 +169,21 @@ void AssetLoadInfo<T>::forceDirty(bool bDirty) const noexcept {
 	m_bDirty = bDirty;
 }
 
+template <typename T>
+Span<Hash const> AssetLoadInfo<T>::depends() const noexcept {
+	return Span<Hash const>(m_depends.data(), m_depends.size());
+}
+template <typename T>
+u64 AssetLoadInfo<T>::resourceBytes() const noexcept {
+	u64 ret = 0;
+	for (auto const& [_, resource] : m_monitors) { ret += resource->type() == Resource::Type::eText ? resource->string().size() : resource->bytes().size(); }
+	return ret;
+}
+template <typename T>
+AssetLoadInfo<T> AssetLoadInfo<T>::clone() const {
+	return AssetLoadInfo<T>(m_store, m_resources, m_onModified, m_data, m_id);
+}
+
 template <typename T>
 bool AssetLoader<T>::reload([[maybe_unused]] T& out_t, [[maybe_unused]] AssetLoadInfo<T> const& info) const {
 	return false;
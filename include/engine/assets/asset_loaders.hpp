@@ -1,5 +1,6 @@
 #pragma once
 #include <unordered_map>
+#include <unordered_set>
 #include <engine/assets/asset_loader.hpp>
 #include <engine/render/bitmap_font.hpp>
 #include <engine/render/model.hpp>
@@ -31,6 +32,7 @@ struct AssetLoader<graphics::Shader> {
 template <>
 struct AssetLoadData<graphics::Pipeline> {
 	std::optional<graphics::Pipeline::CreateInfo> info;
+	std::unordered_set<u32> dynamicSets;
 	graphics::PFlags flags;
 	std::string name;
 	not_null<graphics::RenderContext*> context;
@@ -46,6 +48,10 @@ struct AssetLoader<graphics::Pipeline> {
 	bool reload(graphics::Pipeline& out_shader, AssetLoadInfo<graphics::Pipeline> const& info) const;
 };
 
+// reconstruct in place: a fresh Pipeline would lose its variants and shader input
+template <>
+inline constexpr bool asyncReload_v<graphics::Pipeline> = false;
+
 template <>
 struct AssetLoadData<graphics::Texture> {
 	kt::fixed_vector<io::Path, 6> imageIDs;
@@ -1,10 +1,15 @@
 #pragma once
+#include <algorithm>
+#include <array>
+#include <atomic>
 #include <memory>
+#include <shared_mutex>
 #include <stdexcept>
-#include <typeinfo>
 #include <unordered_map>
+#include <unordered_set>
 #include <core/log.hpp>
 #include <core/utils/algo.hpp>
+#include <dumb_tasks/scheduler.hpp>
 #include <engine/assets/asset_loader.hpp>
 #include <engine/utils/logger.hpp>
 #include <kt/tmutex/shared_tmutex.hpp>
@@ -16,15 +21,88 @@ using AssetMapPtr = std::unique_ptr<AssetMap>;
 template <typename T>
 class TAssetMap;
 
+///
+/// \brief Reload dependencies (via AssetLoadInfo::reloadDepend) and dirty / in flight assets of one update batch
+///
+/// Assets in a dependency cycle (strongly connected component) can never be reloaded after each other:
+/// they don't block each other, and are reloaded synchronously in the same pass, as a unit.
+///
+struct ReloadGraph {
+	// copied: synchronous reloads modify dependencies during dispatch
+	std::unordered_map<Hash, std::vector<Hash>> depends;
+	std::unordered_set<Hash> dirty;
+	// cycle index (> 0) of each asset in a dependency cycle, set by build()
+	std::unordered_map<Hash, std::size_t> cycles;
+
+	///
+	/// \brief Find dependency cycles (Tarjan's algorithm) and mark all members of cycles with dirty members dirty;
+	/// call after populating depends and dirty
+	///
+	void build();
+	///
+	/// \brief Obtain the cycle index of id (0 if not in a cycle)
+	///
+	std::size_t cycle(Hash id) const noexcept;
+	///
+	/// \brief Check whether any (transitive) dependency of id outside its cycle is dirty: id must wait for it to be reloaded first
+	///
+	bool blocked(Hash id) const;
+};
+
+///
+/// \brief Excludes AssetStore::update() polling monitored Resources (which rewrites their contents) while loaders restore evicted assets
+///
+/// Reentrant per thread: restoring loaders may restore other assets, and reloads run by update() may restore assets.
+///
+class ResourceLock {
+  public:
+	enum class Mode { eShared, eTryUnique };
+
+	ResourceLock(std::shared_mutex& mutex, Mode mode);
+	ResourceLock(ResourceLock&&) = delete;
+	ResourceLock& operator=(ResourceLock&&) = delete;
+	~ResourceLock();
+
+	explicit operator bool() const noexcept { return m_held; }
+
+  private:
+	std::shared_mutex* m_mutex;
+	Mode m_mode;
+	bool m_locked = false;
+	bool m_held = false;
+};
+
+///
+/// \brief Obtain a unique, dense index per asset type (assigned on first use)
+///
+std::size_t nextTypeIndex() noexcept;
+template <typename Value>
+std::size_t typeIndex() noexcept;
+
+///
+/// \brief Residency of an evictable asset: shared with (and thus counts) Asset<T> handles
+///
+struct Residency {
+	std::atomic<u64> lastUsed = 0;
+};
+
+///
+/// \brief Per-type asset maps, indexed by typeIndex(); maps are created once and live as long as the store
+///
+/// Resolving a type is a single atomic load; creation (first add / load of a type) is serialised.
+///
 struct TAssets final {
+	static constexpr std::size_t maxTypes = 64;
+
 	template <typename Value>
-	TAssetMap<Value>& get() const;
-	template <typename Value>
-	bool contains() const noexcept;
+	TAssetMap<Value>* find() const noexcept;
 	template <typename Value>
-	std::size_t hash() const;
+	TAssetMap<Value>& get();
+	std::vector<AssetMap*> maps() const;
 
-	mutable std::unordered_map<std::size_t, AssetMapPtr> storeMap;
+	std::array<std::atomic<AssetMap*>, maxTypes> slots{};
+	std::vector<AssetMapPtr> storeMap;
+	mutable std::mutex mutex;
 };
 } // namespace detail
 
@@ -34,9 +112,42 @@ class Asset;
 template <typename T>
 using OptAsset = std::optional<Asset<T>>;
 
+///
+/// \brief Per-type residency budget (0: unlimited)
+///
+struct AssetBudget {
+	u64 vram = 0; // AssetSize<T>
+	u64 cpu = 0;  // monitored Resources
+};
+
+struct ResidencyStats {
+	std::size_t resident = 0;
+	std::size_t evicted = 0;
+	u64 vram = 0;
+	u64 cpu = 0;
+	u64 evictions = 0;
+	u64 restores = 0;
+
+	ResidencyStats& operator+=(ResidencyStats const& rhs) noexcept;
+};
+
+///
+/// \brief Thread-safe store of assets, keyed by type and id
+///
+/// Modified assets are reloaded on update(): if a scheduler is passed, assets that support it (asyncReload_v)
+/// are rebuilt on worker threads and swapped in (followed by OnModified) on a subsequent update().
+/// Tasks reference the store: the scheduler must be drained / destroyed before the store.
+///
+/// Types with a budget() evict least recently used loaded assets on update() until within budget, and are transparently
+/// reloaded (via their AssetLoadInfo) on the next find() / get(). Only assets with no live Asset<T> handles (copies count),
+/// no OnModified subscribers and no reload in flight are evicted: raw pointers / references obtained via Asset<T>::get()
+/// do not keep an asset resident (SceneDrawer::attach() holds the Asset<Model> it was passed). Evicting an asset unwatches its
+/// monitored Resources (freed once no other asset watches them). Requires update() once per frame (recency is measured in updates).
+///
 class AssetStore : public NoCopy {
   public:
 	using OnModified = Delegate<>;
+	using Scheduler = dts::scheduler;
 
 	AssetStore() = default;
 	~AssetStore();
@@ -58,7 +169,14 @@ class AssetStore : public NoCopy {
 	template <typename T>
 	bool forceDirty(Hash id) const;
 
-	void update();
+	template <typename T>
+	void budget(AssetBudget budget);
+	template <typename T>
+	ResidencyStats residency() const;
+	ResidencyStats residency() const;
+
+	void update(Scheduler* scheduler = {});
+	bool reloading() const noexcept;
 	void clear();
 
 	template <template <typename...> typename L = std::scoped_lock>
@@ -70,10 +188,18 @@ class AssetStore : public NoCopy {
 	template <typename T>
 	bool reloadAsset(T& out_asset, AssetLoadInfo<T> const& info) const;
 
+	OnModified& onModified(Hash id) const;
+
 	Resources m_resources;
-	kt::shared_strict_tmutex<detail::TAssets> m_assets;
+	detail::TAssets m_assets;
+	// delegates outlive unload / reload (tokens may be held by other assets): only accessed on add / load / reload
 	mutable kt::strict_tmutex<std::unordered_map<Hash, OnModified>> m_onModified;
 	mutable std::mutex m_reloadMutex;
+	// restores (on any thread) share, update() polling Resources is exclusive
+	mutable std::shared_mutex m_resourceMutex;
+	std::atomic<std::size_t> m_inFlight;
+	// update() count: recency of used assets (not a reclamation epoch)
+	std::atomic<u64> m_epoch;
 
 	template <typename T>
 	friend class detail::TAssetMap;
@@ -85,7 +211,7 @@ class Asset {
 	using type = T;
 	using OnModified = AssetStore::OnModified;
 
-	Asset(not_null<type*> t, not_null<OnModified*> onMod, std::string_view id);
+	Asset(not_null<type*> t, not_null<OnModified*> onMod, std::string_view id, std::shared_ptr<detail::Residency> residency = {});
 
 	type& get() const;
 	type& operator*() const;
@@ -97,6 +223,7 @@ class Asset {
   private:
 	not_null<T*> m_t;
 	not_null<OnModified*> m_onModified;
+	std::shared_ptr<detail::Residency> m_residency;
 };
 
 // impl
@@ -104,51 +231,125 @@ class Asset {
 namespace detail {
 template <typename T>
 struct TAsset {
+	using Rebuild = std::optional<T> (*)(AssetLoadInfo<T> const&);
+
+	struct Reload {
+		AssetLoadInfo<T> loadInfo;
+		std::optional<T> t;
+		std::atomic<bool> done;
+
+		Reload(AssetLoadInfo<T>&& info) : loadInfo(std::move(info)), done(false) {}
+	};
+
 	std::string id;
 	std::optional<T> t;
 	std::optional<AssetLoadInfo<T>> loadInfo;
+	std::shared_ptr<Reload> reload; // in flight (owned by worker task too)
+	// only set for loaded (vs added) assets: instantiates AssetLoader<T>::load()
+	Rebuild rebuild = {};
+	// only set for evictable (rebuildable) assets
+	std::shared_ptr<Residency> residency;
+	AssetStore::OnModified* onModified = {};
 };
 
+template <typename T>
+std::optional<T> rebuild(AssetLoadInfo<T> const& info) {
+	auto ret = AssetLoader<T>{}.load(info);
+	info.release();
+	return ret;
+}
+
 class AssetMap {
   public:
+	struct Dispatch {
+		std::vector<Hash> cyclic; // reloaded members of dependency cycles
+		u64 staged = 0;
+		u64 reloaded = 0;
+	};
+
 	virtual ~AssetMap() = default;
-	virtual u64 update(AssetStore const& store) = 0;
+	virtual void clear() = 0;
+	virtual void collect(ReloadGraph& out_graph) const = 0;
+	virtual Dispatch dispatch(AssetStore const& store, ReloadGraph const& graph, AssetStore::Scheduler::stage_t* out_stage) = 0;
+	virtual std::size_t commit(std::vector<Hash>& out_swapped) = 0;
+	virtual void settle(Span<Hash const> ids) = 0;
+	virtual u64 evict(u64 epoch) = 0;
+	virtual ResidencyStats residency() const = 0;
 };
 
+///
+/// \brief Assets of one type, sharded by id: readers of different ids rarely contend on the same lock
+///
+/// Lookups are not lock-free: they take their shard's shared lock (an atomic read-modify-write on a lock word shared by
+/// readers of that shard). Entries are modified in place (evict / restore / reload / unload), and readers aren't tracked,
+/// so there is no safe point to reclaim replaced snapshots.
+///
 template <typename T>
 class TAssetMap : public AssetMap {
   public:
+	static constexpr std::size_t shardCount = 16;
+
+	using Storage = std::unordered_map<Hash, TAsset<T>>;
+	struct alignas(64) Shard {
+		kt::shared_strict_tmutex<Storage> storage;
+	};
+
 	template <typename U>
 	Asset<T> add(AssetStore::OnModified& onMod, io::Path const& id, U&& u);
 	template <typename Data>
 	static std::optional<TAsset<T>> load(AssetStore const& store, AssetStore::OnModified& onMod, Resources& res, std::string id, Data&& data);
 	Asset<T> insert(TAsset<T>&& asset, AssetStore::OnModified& onMod);
+	OptAsset<T> find(Hash id, u64 epoch) const;
+	bool contains(Hash id) const;
 	bool reload(AssetStore const& store, Hash id);
 	bool unload(Hash id);
 	bool forceDirty(Hash id) const;
-	u64 update(AssetStore const& store) override;
+	void clear() override;
+	void collect(ReloadGraph& out_graph) const override;
+	Dispatch dispatch(AssetStore const& store, ReloadGraph const& graph, AssetStore::Scheduler::stage_t* out_stage) override;
+	std::size_t commit(std::vector<Hash>& out_swapped) override;
+	void settle(Span<Hash const> ids) override;
+	u64 evict(u64 epoch) override;
+	ResidencyStats residency() const override;
+	void budget(AssetBudget budget) noexcept;
 
-	using Storage = std::unordered_map<Hash, TAsset<T>>;
-	Storage m_storage;
+  private:
+	Shard& shard(Hash id) const noexcept { return m_shards[id.hash % shardCount]; }
+	OptAsset<T> restore(Hash id, u64 epoch) const;
+	static bool evictable(TAsset<T> const& asset) noexcept;
+
+	// Asset<T> handles are non-const
+	mutable std::array<Shard, shardCount> m_shards;
+	std::atomic<u64> m_vramBudget = 0;
+	std::atomic<u64> m_cpuBudget = 0;
+	std::atomic<u64> m_evictions = 0;
+	mutable std::atomic<u64> m_restores = 0;
 };
 
 template <typename T, typename U>
-constexpr Asset<T> makeAsset(U&& wrap, AssetStore::OnModified& onModified) noexcept {
-	return {&*wrap.t, &onModified, wrap.id};
+Asset<T> makeAsset(U&& wrap, u64 epoch = 0) {
+	if (wrap.residency && wrap.residency->lastUsed.load(std::memory_order_relaxed) < epoch) {
+		// avoid writing to shared cache lines more than once per update
+		wrap.residency->lastUsed.store(epoch, std::memory_order_relaxed);
+	}
+	return {&*wrap.t, wrap.onModified, wrap.id, wrap.residency};
 }
 
 template <typename T>
 template <typename U>
 Asset<T> TAssetMap<T>::add(AssetStore::OnModified& onMod, io::Path const& id, U&& u) {
 	auto idStr = id.generic_string();
-	auto const [it, bNew] = m_storage.insert({idStr, TAsset<T>{}});
+	Hash const hash = idStr;
+	kt::unique_tlock<Storage> lock(shard(hash).storage);
+	auto const [it, bNew] = lock->insert({hash, TAsset<T>{}});
 	if (!bNew) { utils::g_log.log(dl::level::warning, 0, "[Asset] Overwriting [{}]!", idStr); }
 	TAsset<T>& asset = it->second;
 	asset.t.emplace(std::forward<U>(u));
 	asset.loadInfo.reset();
+	asset.onModified = &onMod;
 	utils::g_log.log(dl::level::info, 1, "== [Asset] [{}] added", idStr);
 	asset.id = std::move(idStr);
-	return makeAsset<T>(asset, onMod);
+	return makeAsset<T>(asset);
 }
 template <typename T>
 template <typename Data>
@@ -157,6 +358,11 @@ std::optional<TAsset<T>> TAssetMap<T>::load(AssetStore const& store, AssetStore:
 	TAsset<T> asset;
 	asset.loadInfo = AssetLoadInfo<T>(&store, &res, &onMod, std::forward<Data>(data), id);
 	asset.t = loader.load(*asset.loadInfo);
+	asset.loadInfo->release();
+	if constexpr (asyncReload_v<T>) {
+		asset.rebuild = &rebuild<T>;
+		asset.residency = std::make_shared<Residency>();
+	}
 	if (asset.t) {
 		utils::g_log.log(dl::level::info, 1, "== [Asset] [{}] loaded", id);
 		asset.id = std::move(id);
@@ -168,13 +374,69 @@ std::optional<TAsset<T>> TAssetMap<T>::load(AssetStore const& store, AssetStore:
 template <typename T>
 Asset<T> TAssetMap<T>::insert(TAsset<T>&& asset, AssetStore::OnModified& onMod) {
 	Hash const id = asset.id;
-	auto const [it, bNew] = m_storage.insert({id, std::move(asset)});
+	asset.onModified = &onMod;
+	kt::unique_tlock<Storage> lock(shard(id).storage);
+	auto const [it, bNew] = lock->insert({id, std::move(asset)});
 	if (!bNew) { utils::g_log.log(dl::level::warning, 0, "[Asset] Overwriting [{}]!", asset.id); }
-	return makeAsset<T>(it->second, onMod);
+	return makeAsset<T>(it->second);
+}
+template <typename T>
+OptAsset<T> TAssetMap<T>::find(Hash id, u64 epoch) const {
+	{
+		kt::shared_tlock<Storage> lock(shard(id).storage);
+		auto it = lock.get().find(id);
+		if (it == lock.get().end()) { return std::nullopt; }
+		if (it->second.t) { return makeAsset<T>(it->second, epoch); }
+	}
+	return restore(id, epoch);
+}
+template <typename T>
+OptAsset<T> TAssetMap<T>::restore(Hash id, u64 epoch) const {
+	if constexpr (asyncReload_v<T>) {
+		std::optional<AssetLoadInfo<T>> info;
+		typename TAsset<T>::Rebuild rebuild = {};
+		{
+			kt::shared_tlock<Storage const> lock(shard(id).storage);
+			if (auto it = lock.get().find(id); it != lock.get().end() && !it->second.t && it->second.loadInfo && it->second.rebuild) {
+				info.emplace(it->second.loadInfo->clone());
+				rebuild = it->second.rebuild;
+			}
+		}
+		if (!info) { return std::nullopt; }
+		// load outside the lock: AssetLoader may look up other assets (possibly in this shard)
+		std::optional<T> t;
+		{
+			ResourceLock const resources(info->m_store->m_resourceMutex, ResourceLock::Mode::eShared);
+			t = rebuild(*info);
+		}
+		kt::unique_tlock<Storage> lock(shard(id).storage);
+		if (auto it = lock->find(id); it != lock->end()) {
+			auto& asset = it->second;
+			if (!asset.t) {
+				if (!t) {
+					utils::g_log.log(dl::level::warning, 0, "[Asset] Failed to restore [{}]!", asset.id);
+					return std::nullopt;
+				}
+				asset.t = std::move(t);
+				asset.loadInfo.emplace(std::move(*info));
+				++m_restores;
+				utils::g_log.log(dl::level::info, 1, "== [Asset] [{}] restored", asset.id);
+			}
+			// else restored concurrently: discard ours
+			return makeAsset<T>(asset, epoch);
+		}
+	}
+	return std::nullopt;
+}
+template <typename T>
+bool TAssetMap<T>::contains(Hash id) const {
+	kt::shared_tlock<Storage const> lock(shard(id).storage);
+	return utils::contains(lock.get(), id);
 }
 template <typename T>
 bool TAssetMap<T>::reload(AssetStore const& store, Hash id) {
-	if (auto it = m_storage.find(id); it != m_storage.end()) {
+	kt::shared_tlock<Storage> lock(shard(id).storage);
+	if (auto it = lock.get().find(id); it != lock.get().end() && it->second.t && it->second.loadInfo) {
 		auto& asset = it->second;
 		if (store.reloadAsset<T>(*asset.t, *asset.loadInfo)) {
 			utils::g_log.log(dl::level::info, 1, "== [Asset] [{}] reloaded", asset.id);
@@ -187,29 +449,98 @@ bool TAssetMap<T>::reload(AssetStore const& store, Hash id) {
 }
 template <typename T>
 bool TAssetMap<T>::unload(Hash id) {
-	if (auto it = m_storage.find(id); it != m_storage.end()) {
+	kt::unique_tlock<Storage> lock(shard(id).storage);
+	if (auto it = lock->find(id); it != lock->end()) {
 		utils::g_log.log(dl::level::info, 1, "-- [Asset] [{}] unloaded", it->second.id);
-		m_storage.erase(it);
+		lock->erase(it);
 		return true;
 	}
 	return false;
 }
 template <typename T>
 bool TAssetMap<T>::forceDirty(Hash id) const {
-	if (auto it = m_storage.find(id); it != m_storage.end() && it->second.loadInfo) {
+	kt::shared_tlock<Storage const> lock(shard(id).storage);
+	if (auto it = lock.get().find(id); it != lock.get().end() && it->second.loadInfo) {
 		it->second.loadInfo->forceDirty(true);
 		return true;
 	}
 	return false;
 }
 template <typename T>
-u64 TAssetMap<T>::update(AssetStore const& store) {
-	u64 ret = 0;
-	for (auto& [_, asset] : m_storage) {
-		if (asset.t && asset.loadInfo && asset.loadInfo->modified()) {
+void TAssetMap<T>::clear() {
+	for (auto& shard : m_shards) { kt::unique_tlock<Storage>(shard.storage)->clear(); }
+}
+template <typename T>
+void TAssetMap<T>::collect(ReloadGraph& out_graph) const {
+	for (auto const& shard : m_shards) {
+		kt::shared_tlock<Storage const> lock(shard.storage);
+		for (auto const& [id, asset] : lock.get()) {
+			if (asset.loadInfo) {
+				if (auto const deps = asset.loadInfo->depends(); !deps.empty()) { out_graph.depends[id] = std::vector<Hash>(deps.begin(), deps.end()); }
+				if (asset.reload || (asset.t && asset.loadInfo->modified())) { out_graph.dirty.insert(id); }
+			}
+		}
+	}
+}
+template <typename T>
+AssetMap::Dispatch TAssetMap<T>::dispatch(AssetStore const& store, ReloadGraph const& graph, AssetStore::Scheduler::stage_t* out_stage) {
+	Dispatch ret;
+	// shared locks: only values are mutated (and reload callbacks may need to look up assets)
+	for (auto& shard : m_shards) {
+		kt::shared_tlock<Storage> lock(shard.storage);
+		for (auto& [id, asset] : lock.get()) {
+			if (!asset.t || !asset.loadInfo || asset.reload) { continue; }
+			bool const bCyclic = graph.cycle(id) > 0;
+			// a dirty member dirties its whole cycle (ReloadGraph::build())
+			if (!asset.loadInfo->modified() && !(bCyclic && graph.dirty.contains(id))) { continue; }
+			if (graph.blocked(id)) {
+				// reload once, after dependencies (which will mark this dirty again anyway)
+				asset.loadInfo->forceDirty(true);
+				utils::g_log.log(dl::level::debug, 2, "[Asset] [{}] reload deferred: dependencies reloading", asset.id);
+				continue;
+			}
+			if constexpr (asyncReload_v<T>) {
+				// cycles are reloaded synchronously: members swapped in on different updates would keep dirtying each other
+				if (out_stage && asset.rebuild && !bCyclic) {
+					asset.loadInfo->forceDirty(false);
+					asset.reload = std::make_shared<typename TAsset<T>::Reload>(asset.loadInfo->clone());
+					out_stage->tasks.push_back([reload = asset.reload, rebuild = asset.rebuild]() {
+						reload->t = rebuild(reload->loadInfo);
+						reload->done.store(true, std::memory_order_release);
+					});
+					++ret.staged;
+					continue;
+				}
+			}
 			if (store.reloadAsset<T>(*asset.t, *asset.loadInfo)) {
 				utils::g_log.log(dl::level::info, 1, "== [Asset] [{}] reloaded", asset.id);
+				++ret.reloaded;
+				if (bCyclic) { ret.cyclic.push_back(id); }
+			} else {
+				utils::g_log.log(dl::level::warning, 0, "[Asset] Failed to reload [{}]!", asset.id);
+			}
+		}
+	}
+	return ret;
+}
+template <typename T>
+std::size_t TAssetMap<T>::commit(std::vector<Hash>& out_swapped) {
+	std::size_t ret = 0;
+	for (auto& shard : m_shards) {
+		kt::shared_tlock<Storage> lock(shard.storage);
+		for (auto& [id, asset] : lock.get()) {
+			if (!asset.reload) { continue; }
+			if (!asset.reload->done.load(std::memory_order_acquire)) {
 				++ret;
+				continue;
+			}
+			auto reload = std::move(asset.reload);
+			if (reload->t) {
+				// move-assign: existing Asset<T> handles remain valid
+				*asset.t = std::move(*reload->t);
+				asset.loadInfo.emplace(std::move(reload->loadInfo));
+				utils::g_log.log(dl::level::info, 1, "== [Asset] [{}] reloaded", asset.id);
+				out_swapped.push_back(id);
 			} else {
 				utils::g_log.log(dl::level::warning, 0, "[Asset] Failed to reload [{}]!", asset.id);
 			}
@@ -218,95 +549,197 @@ u64 TAssetMap<T>::update(AssetStore const& store) {
 	return ret;
 }
 
-template <typename Value>
-TAssetMap<Value>& TAssets::get() const {
-	auto search = storeMap.find(hash<Value>());
-	if (search == storeMap.end()) {
-		auto [it, _] = storeMap.emplace(hash<Value>(), std::make_unique<TAssetMap<Value>>());
-		search = it;
+template <typename T>
+void TAssetMap<T>::settle(Span<Hash const> ids) {
+	for (Hash const id : ids) {
+		kt::shared_tlock<Storage const> lock(shard(id).storage);
+		if (auto it = lock.get().find(id); it != lock.get().end() && it->second.loadInfo) { it->second.loadInfo->forceDirty(false); }
 	}
-	return static_cast<TAssetMap<Value>&>(*search->second);
 }
+
+template <typename T>
+bool TAssetMap<T>::evictable(TAsset<T> const& asset) noexcept {
+	// handles (including dependents' via reloadDepend) hold references / subscriptions; reloads own the current loadInfo
+	return asset.t && asset.loadInfo && asset.rebuild && !asset.reload && asset.residency.use_count() == 1 && !(asset.onModified && asset.onModified->alive());
+}
+template <typename T>
+u64 TAssetMap<T>::evict(u64 epoch) {
+	if constexpr (asyncReload_v<T>) {
+		AssetBudget const budget{m_vramBudget.load(), m_cpuBudget.load()};
+		if (budget.vram == 0 && budget.cpu == 0) { return 0; }
+		struct Entry {
+			Hash id;
+			u64 lastUsed;
+			u64 vram;
+			u64 cpu;
+		};
+		std::vector<Entry> candidates;
+		u64 vram = 0, cpu = 0;
+		for (auto const& shard : m_shards) {
+			kt::shared_tlock<Storage const> lock(shard.storage);
+			for (auto const& [id, asset] : lock.get()) {
+				if (!asset.t) { continue; }
+				Entry const entry{id, asset.residency ? asset.residency->lastUsed.load(std::memory_order_relaxed) : 0, AssetSize<T>{}(*asset.t),
+								  asset.loadInfo ? asset.loadInfo->resourceBytes() : 0};
+				vram += entry.vram;
+				cpu += entry.cpu;
+				// never evict assets used during this update
+				if (evictable(asset) && entry.lastUsed < epoch) { candidates.push_back(entry); }
+			}
+		}
+		auto over = [&budget, &vram, &cpu]() { return (budget.vram > 0 && vram > budget.vram) || (budget.cpu > 0 && cpu > budget.cpu); };
+		if (!over()) { return 0; }
+		std::sort(candidates.begin(), candidates.end(), [](Entry const& lhs, Entry const& rhs) { return lhs.lastUsed < rhs.lastUsed; });
+		u64 ret = 0;
+		for (auto const& entry : candidates) {
+			if (!over()) { break; }
+			kt::unique_tlock<Storage> lock(shard(entry.id).storage);
+			// no new handles can be made while locked: re-check
+			if (auto it = lock->find(entry.id); it != lock->end() && evictable(it->second)) {
+				auto& asset = it->second;
+				// fresh info: releases monitored Resources and dependency tokens (re-acquired on restore)
+				auto info = asset.loadInfo->clone();
+				asset.loadInfo.emplace(std::move(info));
+				asset.t.reset();
+				vram -= entry.vram;
+				cpu -= entry.cpu;
+				++ret;
+				utils::g_log.log(dl::level::debug, 2, "-- [Asset] [{}] evicted", asset.id);
+			}
+		}
+		if (over()) { utils::g_log.log(dl::level::debug, 2, "[Asset] Over budget ([{}] / [{}] VRAM bytes): remaining assets in use", vram, budget.vram); }
+		m_evictions += ret;
+		return ret;
+	}
+	return 0;
+}
+template <typename T>
+ResidencyStats TAssetMap<T>::residency() const {
+	ResidencyStats ret;
+	for (auto const& shard : m_shards) {
+		kt::shared_tlock<Storage const> lock(shard.storage);
+		for (auto const& [_, asset] : lock.get()) {
+			if (asset.t) {
+				++ret.resident;
+				ret.vram += AssetSize<T>{}(*asset.t);
+				if (asset.loadInfo) { ret.cpu += asset.loadInfo->resourceBytes(); }
+			} else {
+				++ret.evicted;
+			}
+		}
+	}
+	ret.evictions = m_evictions.load();
+	ret.restores = m_restores.load();
+	return ret;
+}
+template <typename T>
+void TAssetMap<T>::budget(AssetBudget budget) noexcept {
+	m_vramBudget.store(budget.vram);
+	m_cpuBudget.store(budget.cpu);
+}
+
 template <typename Value>
-bool TAssets::contains() const noexcept {
-	return utils::contains(storeMap, hash<Value>());
+std::size_t typeIndex() noexcept {
+	static std::size_t const s_index = nextTypeIndex();
+	return s_index;
 }
 template <typename Value>
-std::size_t TAssets::hash() const {
-	return typeid(std::decay_t<Value>).hash_code();
+TAssetMap<Value>* TAssets::find() const noexcept {
+	return static_cast<TAssetMap<Value>*>(slots[typeIndex<std::decay_t<Value>>()].load(std::memory_order_acquire));
+}
+template <typename Value>
+TAssetMap<Value>& TAssets::get() {
+	auto const index = typeIndex<std::decay_t<Value>>();
+	if (auto ret = find<Value>()) { return *ret; }
+	std::scoped_lock lock(mutex);
+	if (auto ret = find<Value>()) { return *ret; }
+	ensure(index < maxTypes, "Max asset types exceeded");
+	auto map = std::make_unique<TAssetMap<Value>>();
+	auto ret = map.get();
+	storeMap.push_back(std::move(map));
+	slots[index].store(ret, std::memory_order_release);
+	return *ret;
+}
+inline std::vector<AssetMap*> TAssets::maps() const {
+	std::vector<AssetMap*> ret;
+	std::scoped_lock lock(mutex);
+	ret.reserve(storeMap.size());
+	for (auto const& map : storeMap) { ret.push_back(map.get()); }
+	return ret;
 }
 } // namespace detail
 
 template <typename T>
 Asset<T> AssetStore::add(io::Path const& id, T&& t) {
-	kt::unique_tlock<detail::TAssets> lock(m_assets);
-	return lock.get().get<T>().add(kt::tlock(m_onModified).get()[id], id, std::forward<T>(t));
+	return m_assets.get<T>().add(onModified(id), id, std::forward<T>(t));
 }
 template <typename T, typename Data>
 OptAsset<T> AssetStore::load(io::Path const& id, Data&& data) {
 	auto idStr = id.generic_string();
-	auto& onMod = kt::tlock(m_onModified).get()[idStr];
+	auto& onMod = onModified(idStr);
 	// AssetLoader may invoke find() etc which would need shared locks
 	if (auto asset = detail::TAssetMap<T>::load(*this, onMod, m_resources, std::move(idStr), std::forward<Data>(data))) {
-		kt::unique_tlock<detail::TAssets> lock(m_assets);
-		return lock.get().get<T>().insert(std::move(*asset), onMod);
+		return m_assets.get<T>().insert(std::move(*asset), onMod);
 	}
 	return std::nullopt;
 }
 template <typename T>
 OptAsset<T> AssetStore::find(Hash id) const {
-	kt::shared_tlock<detail::TAssets const> lock(m_assets);
-	if (lock.get().contains<T>()) {
-		auto& store = lock.get().get<T>().m_storage;
-		if (auto it = store.find(id); it != store.end() && it->second.t) { return detail::makeAsset<T>(it->second, kt::tlock(m_onModified).get()[id]); }
-	}
+	if (auto map = m_assets.find<T>()) { return map->find(id, m_epoch.load(std::memory_order_relaxed)); }
 	return std::nullopt;
 }
 template <typename T>
 Asset<T> AssetStore::get(Hash id) const {
-	kt::shared_tlock<detail::TAssets const> lock(m_assets);
-	if (lock.get().contains<T>()) {
-		auto& store = lock.get().get<T>().m_storage;
-		if (auto it = store.find(id); it != store.end() && it->second.t) { return detail::makeAsset<T>(it->second, kt::tlock(m_onModified).get()[id]); }
-	}
+	if (auto ret = find<T>(id)) { return *ret; }
 	ensure(false, "Asset not found!");
 	throw std::runtime_error("Asset not present");
 }
 template <typename T>
 bool AssetStore::contains(Hash id) const noexcept {
-	kt::shared_tlock<detail::TAssets const> lock(m_assets);
-	if (lock.get().contains<T>()) { return utils::contains(lock.get().get<T>().m_storage, id); }
+	if (auto map = m_assets.find<T>()) { return map->contains(id); }
 	return false;
 }
 template <typename T>
 bool AssetStore::reload(Hash id) {
-	kt::shared_tlock<detail::TAssets> lock(m_assets);
-	if (lock.get().contains<T>()) { return lock.get().get<T>().reload(id); }
+	if (auto map = m_assets.find<T>()) { return map->reload(*this, id); }
 	return false;
 }
 template <typename T>
 bool AssetStore::forceDirty(Hash id) const {
-	kt::shared_tlock<detail::TAssets const> lock(m_assets);
-	if (lock.get().contains<T>()) { return lock.get().get<T>().forceDirty(id); }
+	if (auto map = m_assets.find<T>()) { return map->forceDirty(id); }
 	return false;
 }
 template <typename T>
 bool AssetStore::unload(Hash id) {
-	kt::unique_tlock<detail::TAssets> lock(m_assets);
-	if (lock.get().contains<T>()) { return lock.get().get<T>().unload(id); }
+	if (auto map = m_assets.find<T>()) { return map->unload(id); }
 	return false;
 }
+template <typename T>
+void AssetStore::budget(AssetBudget budget) {
+	m_assets.get<T>().budget(budget);
+}
+template <typename T>
+ResidencyStats AssetStore::residency() const {
+	if (auto map = m_assets.find<T>()) { return map->residency(); }
+	return {};
+}
 template <template <typename...> typename L>
 L<std::mutex> AssetStore::reloadLock() const {
 	return L<std::mutex>(m_reloadMutex);
 }
+inline bool AssetStore::reloading() const noexcept { return m_inFlight.load() > 0; }
 inline Resources& AssetStore::resources() { return m_resources; }
+inline AssetStore::OnModified& AssetStore::onModified(Hash id) const { return kt::tlock(m_onModified).get()[id]; }
 template <typename T>
 bool AssetStore::reloadAsset(T& out_asset, AssetLoadInfo<T> const& info) const {
+	// before reloadLock: update() acquires them in this order
+	detail::ResourceLock const resources(m_resourceMutex, detail::ResourceLock::Mode::eShared);
 	auto lock = reloadLock();
 	info.forceDirty(false);
 	AssetLoader<T> loader;
-	if (loader.reload(out_asset, info)) {
+	bool const bReloaded = loader.reload(out_asset, info);
+	info.release();
+	if (bReloaded) {
 		kt::tlock(m_onModified).get()[info.m_id]();
 		return true;
 	}
@@ -314,7 +747,8 @@ bool AssetStore::reloadAsset(T& out_asset, AssetLoadInfo<T> const& info) const {
 }
 
 template <typename T>
-Asset<T>::Asset(not_null<type*> t, not_null<OnModified*> onMod, std::string_view id) : m_id(id), m_t(t), m_onModified(onMod) {}
+Asset<T>::Asset(not_null<type*> t, not_null<OnModified*> onMod, std::string_view id, std::shared_ptr<detail::Residency> residency)
+	: m_id(id), m_t(t), m_onModified(onMod), m_residency(std::move(residency)) {}
 template <typename T>
 typename Asset<T>::type& Asset<T>::get() const {
 	return *m_t;
@@ -335,6 +769,9 @@ typename Asset<T>::OnModified::Tk Asset<T>::onModified(OnModified::Callback cons
 template <typename T>
 template <typename U>
 void AssetLoadInfo<T>::reloadDepend(Asset<U>& out_asset) const {
+	// reloads into the same info re-add their dependencies
+	if (std::find(m_depends.begin(), m_depends.end(), Hash(out_asset.m_id)) != m_depends.end()) { return; }
 	m_tokens.push_back(out_asset.onModified([s = m_store, id = m_id]() { s->template forceDirty<T>(id); }));
+	m_depends.push_back(out_asset.m_id);
 }
 } // namespace le
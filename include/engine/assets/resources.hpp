@@ -1,4 +1,5 @@
 #pragma once
+#include <atomic>
 #include <shared_mutex>
 #include <unordered_map>
 #include <variant>
@@ -15,38 +16,94 @@ namespace le {
 class Resource {
   public:
 	enum class Type { eText, eBinary };
+	///
+	/// \brief Lifetime of a Resource's data in Resources
+	///
+	enum class Policy {
+		eTransient, // released once all loads referencing it are released (eg after decode / upload)
+		eRetained,	// cached until Resources::clear()
+		eMonitored, // monitored for changes while watched, see Resources::unwatch() (transient where monitoring is unavailable)
+	};
 
 	io::Path const& path() const { return m_path; }
 	std::string_view string() const noexcept;
 	Span<std::byte const> bytes() const noexcept;
 	Type type() const noexcept;
+	Policy policy() const noexcept;
+	///
+	/// \brief Size of the data (text / bytes) held
+	///
+	std::size_t size() const noexcept;
+	///
+	/// \brief Check whether a load with policy holds a reference to this resource (to be released via Resources::release())
+	///
+	bool transient(Policy policy) const noexcept;
+	///
+	/// \brief Check whether a load with policy watches this resource (to be released via Resources::unwatch())
+	///
+	bool watched(Policy policy) const noexcept;
 
 	bool monitoring() const noexcept;
 	std::optional<io::FileMonitor::Status> status() const;
 
   private:
 	bool load(io::Reader const& reader, io::Path path, Type type, bool bMonitor);
+	bool unreferenced() const noexcept;
 
-	using Data = std::variant<bytearray, std::string>;
+	using Data = std::variant<io::ByteView, std::string>;
 
 	Data m_data;
 	io::Path m_path;
 	Type m_type = Type::eBinary;
+	Policy m_policy = Policy::eTransient;
 	std::optional<io::FileMonitor> m_monitor;
+	u64 m_size = 0;	 // accounted in Resources::s_bytes
+	u32 m_users = 0;	// transient references
+	u32 m_watchers = 0; // monitored references
 
 	friend class Resources;
 };
 
+///
+/// \brief Cache of loaded Resources, keyed by path
+///
+/// Transient loads hold a reference until release(): unreferenced transient resources are freed, so raw file
+/// contents aren't kept alive once decoded / uploaded. Monitored loads hold a reference until unwatch(): unwatched
+/// monitored resources are freed (and re-read by the next load). Retained resources are kept until clear().
+///
 class Resources {
   public:
 	using FMode = io::FileMonitor::Mode;
+	using Policy = Resource::Policy;
+
+	///
+	/// \brief Bytes of resource data held across all Resources instances
+	///
+	inline static auto s_bytes = std::atomic<u64>(0);
+
+	Resources() = default;
+	Resources(Resources&&) = delete;
+	Resources& operator=(Resources&&) = delete;
+	~Resources();
 
 	void reader(not_null<io::Reader const*> reader);
 	io::Reader const& reader() const;
 	io::FileReader& fileReader();
 
 	Resource const* find(Hash id) const noexcept;
-	Resource const* load(io::Path path, Resource::Type type, bool bMonitor = false, bool bForceReload = false);
+	///
+	/// \brief Load (or obtain cached) resource; if resource->transient(policy), release() once done with it;
+	/// if resource->watched(policy), unwatch() once no longer interested in modifications
+	///
+	Resource const* load(io::Path path, Resource::Type type, Policy policy = Policy::eRetained, bool bForceReload = false);
+	///
+	/// \brief Release a transient reference (obtained via load()); frees the resource if unreferenced and transient
+	///
+	void release(Hash id);
+	///
+	/// \brief Release a monitored reference (obtained via load()); frees the resource if unreferenced and not retained
+	///
+	void unwatch(Hash id);
 	bool loaded(Hash id) const noexcept;
 
 	void update();
@@ -55,6 +112,8 @@ class Resources {
   protected:
 	using ResourceMap = std::unordered_map<Hash, Resource>;
 
+	static Resource const* acquire(Resource& out_resource, Policy policy) noexcept;
+
 	kt::shared_strict_tmutex<ResourceMap> m_loaded;
 	io::FileReader m_fileReader;
 	io::Reader const* m_reader = nullptr;
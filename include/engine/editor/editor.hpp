@@ -8,6 +8,7 @@
 #include <engine/editor/types.hpp>
 #include <engine/input/frame.hpp>
 #include <engine/render/viewport.hpp>
+#include <engine/scene/scene_index.hpp>
 #include <engine/scene/scene_node.hpp>
 #include <levk_imgui/levk_imgui.hpp>
 
@@ -25,6 +26,11 @@ struct In {
 	std::vector<decf::entity_t> customEntities;
 	SceneNode::Root* root = {};
 	decf::registry_t* registry = {};
+	// left clicks in the game view inspect the nearest entity in index (if set)
+	struct {
+		SceneIndex const* index = {};
+		glm::mat4 viewProj = glm::mat4(1.0f);
+	} pick;
 };
 struct Out {
 	struct {
@@ -23,8 +23,13 @@ class BitmapFont {
 	bool create(not_null<VRAM*> vram, Sampler const& sampler, CreateInfo const& info);
 
 	bool valid() const noexcept;
+	u64 bytes() const noexcept;
 	Texture const& atlas() const;
 	Span<Glyph const> glyphs() const noexcept;
+	///
+	/// \brief Block until the atlas has been uploaded
+	///
+	void wait() const;
 
   private:
 	struct {
@@ -40,9 +45,13 @@ struct BitmapFont::CreateInfo {
 };
 
 inline bool BitmapFont::valid() const noexcept { return m_storage.atlas.has_value(); }
+inline u64 BitmapFont::bytes() const noexcept { return m_storage.atlas ? m_storage.atlas->bytes() : 0; }
 inline BitmapFont::Texture const& BitmapFont::atlas() const {
 	ensure(m_storage.atlas.has_value(), "Empty atlas");
 	return *m_storage.atlas;
 }
 inline Span<BitmapFont::Glyph const> BitmapFont::glyphs() const noexcept { return m_storage.glyphs; }
+inline void BitmapFont::wait() const {
+	if (m_storage.atlas) { m_storage.atlas->wait(); }
+}
 } // namespace le
@@ -1,6 +1,8 @@
 #pragma once
 #include <map>
+#include <core/services.hpp>
 #include <graphics/render/command_buffer.hpp>
+#include <graphics/render/context.hpp>
 #include <graphics/render/descriptor_set.hpp>
 #include <graphics/render/pipeline.hpp>
 
@@ -12,18 +14,23 @@ class DescriptorHelper {
 	using ShaderBuffer = graphics::ShaderBuffer;
 	using CommandBuffer = graphics::CommandBuffer;
 	using Pipeline = graphics::Pipeline;
+	using UniformArena = graphics::UniformArena;
+
+	static UniformArena* defaultArena() noexcept;
 };
 
 class DescriptorUpdater : public DescriptorHelper {
   public:
 	DescriptorUpdater() = default;
-	explicit DescriptorUpdater(not_null<ShaderInput*> input, u32 setNumber, std::size_t index) noexcept
-		: m_input(input), m_vram(input->m_vram), m_index(index), m_setNumber(setNumber) {}
+	explicit DescriptorUpdater(not_null<ShaderInput*> input, u32 setNumber, std::size_t index, UniformArena* arena = {}) noexcept
+		: m_input(input), m_vram(input->m_vram), m_arena(arena), m_index(index), m_setNumber(setNumber) {}
 
 	bool valid() const noexcept { return m_input && m_vram; }
 
 	template <typename T>
 	bool update(u32 bind, T const& t, vk::DescriptorType type = vk::DescriptorType::eUniformBuffer);
+	template <typename T>
+	bool updateArray(u32 bind, Span<T const> ts, vk::DescriptorType type = vk::DescriptorType::eStorageBuffer);
 	bool update(u32 bind, Texture const& texture) { return check(bind) && m_input->update(texture, m_setNumber, bind, m_index); }
 	bool update(u32 bind, ShaderBuffer const& buffer) { return check(bind) && m_input->update(buffer, m_setNumber, bind, m_index); }
 
@@ -33,13 +40,15 @@ class DescriptorUpdater : public DescriptorHelper {
 	kt::fixed_vector<u32, 16> m_binds;
 	ShaderInput* m_input{};
 	graphics::VRAM* m_vram{};
+	UniformArena* m_arena{};
 	std::size_t m_index{};
 	u32 m_setNumber{};
 };
 
 class DescriptorMap : public DescriptorHelper {
   public:
-	explicit DescriptorMap(not_null<Pipeline*> pipeline) noexcept : m_input(&pipeline->shaderInput()) {}
+	explicit DescriptorMap(not_null<Pipeline*> pipeline, UniformArena* arena = defaultArena()) noexcept
+		: m_input(&pipeline->shaderInput()), m_arena(arena) {}
 
 	bool contains(u32 setNumber) { return m_input->contains(setNumber); }
 	DescriptorUpdater set(u32 setNumber);
@@ -47,14 +56,18 @@ class DescriptorMap : public DescriptorHelper {
   private:
 	std::map<u32, std::size_t> m_meta;
 	not_null<ShaderInput*> m_input;
+	UniformArena* m_arena;
 };
 
 class DescriptorBinder : public DescriptorHelper {
   public:
 	explicit DescriptorBinder(not_null<Pipeline*> pipeline, CommandBuffer cb) noexcept : m_cb(cb), m_pipe(pipeline), m_input(&pipeline->shaderInput()) {}
 
-	void operator()(u32 set);
-	void operator()(std::initializer_list<u32> sets);
+	///
+	/// \brief Bind the next index of set / sets; false if any could not be bound (skip the draw)
+	///
+	bool operator()(u32 set);
+	bool operator()(std::initializer_list<u32> sets);
 
   private:
 	CommandBuffer m_cb;
@@ -65,15 +78,32 @@ class DescriptorBinder : public DescriptorHelper {
 
 // impl
 
+inline DescriptorHelper::UniformArena* DescriptorHelper::defaultArena() noexcept {
+	if (Services::exists<graphics::RenderContext>()) { return &Services::locate<graphics::RenderContext>()->uniformArena(); }
+	return nullptr;
+}
+
 template <typename T>
 bool DescriptorUpdater::update(u32 bind, T const& t, vk::DescriptorType type) {
 	if (check(bind)) {
+		if (m_arena) { return m_input->update(m_arena->write(t), m_setNumber, bind, m_index, type); }
 		graphics::Buffer const buf = m_vram->makeBO(t, graphics::Device::bufferUsage(type));
 		return m_input->update(buf, m_setNumber, bind, m_index, type);
 	}
 	return false;
 }
 
+template <typename T>
+bool DescriptorUpdater::updateArray(u32 bind, Span<T const> ts, vk::DescriptorType type) {
+	if (check(bind) && !ts.empty()) {
+		if (m_arena) { return m_input->update(m_arena->write(ts.data(), ts.size_bytes()), m_setNumber, bind, m_index, type); }
+		graphics::Buffer buf = m_vram->makeBuffer(ts.size_bytes(), graphics::Device::bufferUsage(type), true);
+		buf.write(ts.data(), ts.size_bytes());
+		return m_input->update(buf, m_setNumber, bind, m_index, type);
+	}
+	return false;
+}
+
 inline bool DescriptorUpdater::check(u32 bind) noexcept {
 	if (!valid()) { return false; }
 	for (u32 const b : m_binds) {
@@ -87,14 +117,17 @@ inline bool DescriptorUpdater::check(u32 bind) noexcept {
 }
 
 inline DescriptorUpdater DescriptorMap::set(u32 setNumber) {
-	return contains(setNumber) ? DescriptorUpdater(m_input, setNumber, m_meta[setNumber]++) : DescriptorUpdater();
+	return contains(setNumber) ? DescriptorUpdater(m_input, setNumber, m_meta[setNumber]++, m_arena) : DescriptorUpdater();
 }
 
-inline void DescriptorBinder::operator()(u32 set) {
-	if (m_input->contains(set)) { m_pipe->bindSet(m_cb, set, m_meta[set]++); }
+inline bool DescriptorBinder::operator()(u32 set) {
+	if (m_input->contains(set)) { return m_pipe->bindSet(m_cb, set, m_meta[set]++); }
+	return true;
 }
 
-inline void DescriptorBinder::operator()(std::initializer_list<u32> sets) {
-	for (u32 const set : sets) { (*this)(set); }
+inline bool DescriptorBinder::operator()(std::initializer_list<u32> sets) {
+	bool ret = true;
+	for (u32 const set : sets) { ret &= (*this)(set); }
+	return ret;
 }
 } // namespace le
\ No newline at end of file
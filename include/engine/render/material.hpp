@@ -51,5 +51,7 @@ struct Material {
 	/// \brief Illumination model
 	///
 	s32 illum = 2;
+
+	bool operator==(Material const&) const = default;
 };
 } // namespace le
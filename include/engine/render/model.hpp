@@ -1,15 +1,12 @@
 #pragma once
 #include <core/hash.hpp>
-#include <core/io/path.hpp>
+#include <core/io/reader.hpp>
 #include <engine/scene/primitive.hpp>
 #include <graphics/mesh.hpp>
 #include <graphics/texture.hpp>
 #include <kt/result/result.hpp>
 
 namespace le {
-namespace io {
-class Reader;
-}
 namespace graphics {
 class Sampler;
 }
@@ -28,11 +25,43 @@ class Model {
 	template <typename T>
 	using Result = kt::result<T, std::string>;
 
-	static Result<CreateInfo> load(io::Path modelID, io::Path jsonID, io::Reader const& reader);
+	static constexpr u32 bakeVersion = 3;
+
+	///
+	/// \brief Read the json, obj / mtl (or baked blob) and textures via reader
+	///
+	/// medium is the reader backing reader (if it's an adapter): a baked blob is written only if it's an io::FileReader.
+	/// A baked blob is viewed (not copied) and checked against the json; obj / mtl are also read and checked in debug builds
+	/// only, release builds trust the blob (delete it to rebake).
+	///
+	static Result<CreateInfo> load(io::Path modelID, io::Path jsonID, io::Reader const& reader, io::Reader const* medium = {});
+	///
+	/// \brief Serialise meshes, materials and texture references into a versioned binary blob (texture bytes are not baked)
+	///
+	/// jsonHash and sourceHash identify the json and obj / mtl sources the blob was baked from
+	///
+	static bytearray bake(CreateInfo const& info, u64 jsonHash = 0, u64 sourceHash = 0);
+	///
+	/// \brief Deserialise a baked blob; mesh vertices / indices are views into blob (whose owner the returned CreateInfo holds)
+	///
+	/// Fails if jsonHash / sourceHash is set and doesn't match the baked one (stale blob), or if any count exceeds the blob
+	///
+	static Result<CreateInfo> unbake(io::ByteView blob, std::optional<u64> jsonHash = std::nullopt, std::optional<u64> sourceHash = std::nullopt);
 
-	Result<Span<Primitive const>> construct(not_null<VRAM*> vram, CreateInfo const& info, Sampler const& sampler, std::optional<vk::Format> forceFormat);
+	///
+	/// \brief Upload textures and meshes; texture bytes in info are released as soon as each texture is uploaded
+	///
+	Result<Span<Primitive const>> construct(not_null<VRAM*> vram, CreateInfo info, Sampler const& sampler, std::optional<vk::Format> forceFormat);
 
 	Span<Primitive const> primitives() const noexcept;
+	///
+	/// \brief Block until all textures and meshes have been uploaded
+	///
+	void wait() const;
+	///
+	/// \brief Total VRAM allocated for textures and meshes
+	///
+	u64 bytes() const noexcept;
 
   private:
 	template <typename V>
@@ -49,7 +78,7 @@ class Model {
 struct Model::TexData {
 	io::Path id;
 	io::Path filename;
-	bytearray bytes;
+	io::ByteView bytes;
 	Hash samplerID;
 	Hash hash;
 };
@@ -67,6 +96,9 @@ struct Model::MatData {
 struct Model::MeshData {
 	io::Path id;
 	graphics::Geometry geometry;
+	// views into CreateInfo::blob (if baked), used instead of geometry
+	Span<graphics::Vertex const> vertices;
+	Span<u32 const> indices;
 	std::vector<std::size_t> matIndices;
 	Hash hash;
 };
@@ -76,6 +108,7 @@ struct Model::CreateInfo {
 	std::vector<MeshData> meshes;
 	std::vector<TexData> textures;
 	std::vector<MatData> materials;
+	io::ByteView blob;
 	io::Path id;
 };
 
@@ -0,0 +1,145 @@
+#pragma once
+#include <array>
+#include <vector>
+#include <core/ensure.hpp>
+#include <core/std_types.hpp>
+#include <graphics/geometry.hpp>
+#include <graphics/render/frustum.hpp>
+
+namespace le {
+///
+/// \brief Dynamic bounding volume hierarchy (balanced AABB tree) over user payloads
+///
+/// Leaves store fattened AABBs so that small movements don't require re-insertion;
+/// internal nodes are refitted and rebalanced (tree rotations) on insert / remove.
+/// Queries are const and may run concurrently; mutations may not.
+///
+class BVH {
+  public:
+	using AABB = graphics::Bounds::AABB;
+	using Proxy = s32;
+	static constexpr Proxy null = -1;
+
+	struct Ray {
+		glm::vec3 origin = {};
+		glm::vec3 direction = {};
+		f32 length = 1000.0f;
+	};
+
+	///
+	/// \brief Insert a leaf and return its proxy
+	///
+	Proxy insert(AABB const& aabb, u64 payload);
+	///
+	/// \brief Remove a leaf
+	///
+	void remove(Proxy proxy);
+	///
+	/// \brief Update a leaf's AABB; returns true if the leaf was re-inserted (moved out of its fat AABB)
+	///
+	bool update(Proxy proxy, AABB const& aabb);
+	void clear() noexcept;
+
+	u64 payload(Proxy proxy) const noexcept;
+	AABB const& fatAABB(Proxy proxy) const noexcept;
+	std::size_t size() const noexcept { return m_leaves; }
+	s32 height() const noexcept;
+
+	///
+	/// \brief Invoke f(payload) for each leaf overlapping aabb; f may return false to stop
+	///
+	template <typename F>
+	void query(AABB const& aabb, F f) const;
+	///
+	/// \brief Invoke f(payload) for each leaf intersecting frustum; f may return false to stop
+	///
+	template <typename F>
+	void query(graphics::Frustum const& frustum, F f) const;
+	///
+	/// \brief Invoke f(payload, t) for each leaf whose AABB ray hits at distance t; f may return false to stop
+	///
+	template <typename F>
+	void query(Ray const& ray, F f) const;
+
+	static bool overlap(AABB const& a, AABB const& b) noexcept;
+	static bool intersect(graphics::Frustum const& frustum, AABB const& aabb) noexcept;
+	static bool intersect(Ray const& ray, AABB const& aabb, f32& out_t) noexcept;
+
+	f32 m_margin = 0.1f;
+
+  private:
+	struct Node {
+		AABB aabb;
+		u64 payload = 0;
+		Proxy parent = null; // next free when unused
+		Proxy left = null;
+		Proxy right = null;
+		s32 height = -1;
+
+		bool leaf() const noexcept { return left == null; }
+	};
+
+	static constexpr std::size_t maxDepth = 128;
+
+	template <typename Pred, typename F>
+	void walk(Pred pred, F f) const;
+
+	Proxy allocate();
+	void release(Proxy proxy) noexcept;
+	void insertLeaf(Proxy leaf);
+	void removeLeaf(Proxy leaf);
+	void refit(Proxy index);
+	Proxy balance(Proxy index);
+
+	std::vector<Node> m_nodes;
+	Proxy m_root = null;
+	Proxy m_free = null;
+	std::size_t m_leaves = 0;
+};
+
+// impl
+
+inline u64 BVH::payload(Proxy proxy) const noexcept { return m_nodes[(std::size_t)proxy].payload; }
+inline BVH::AABB const& BVH::fatAABB(Proxy proxy) const noexcept { return m_nodes[(std::size_t)proxy].aabb; }
+inline s32 BVH::height() const noexcept { return m_root == null ? 0 : m_nodes[(std::size_t)m_root].height; }
+
+inline bool BVH::overlap(AABB const& a, AABB const& b) noexcept {
+	return a.min.x <= b.max.x && a.max.x >= b.min.x && a.min.y <= b.max.y && a.max.y >= b.min.y && a.min.z <= b.max.z && a.max.z >= b.min.z;
+}
+
+template <typename Pred, typename F>
+void BVH::walk(Pred pred, F f) const {
+	if (m_root == null) { return; }
+	// depth-first; the tree is balanced so depth is bounded by ~1.44 log2(n)
+	std::array<Proxy, maxDepth> stack;
+	std::size_t top = 0;
+	stack[top++] = m_root;
+	while (top > 0) {
+		Node const& node = m_nodes[(std::size_t)stack[--top]];
+		if (!pred(node.aabb)) { continue; }
+		if (node.leaf()) {
+			if (!f(node)) { return; }
+		} else {
+			ensure(top + 2 <= stack.size(), "BVH stack overflow");
+			stack[top++] = node.left;
+			stack[top++] = node.right;
+		}
+	}
+}
+
+template <typename F>
+void BVH::query(AABB const& aabb, F f) const {
+	walk([&aabb](AABB const& box) { return overlap(aabb, box); }, [&f](Node const& node) { return f(node.payload); });
+}
+
+template <typename F>
+void BVH::query(graphics::Frustum const& frustum, F f) const {
+	walk([&frustum](AABB const& box) { return intersect(frustum, box); }, [&f](Node const& node) { return f(node.payload); });
+}
+
+template <typename F>
+void BVH::query(Ray const& ray, F f) const {
+	f32 t = 0.0f;
+	walk([&ray, &t](AABB const& box) { return intersect(ray, box, t); }, [&f, &t](Node const& node) { return f(node.payload, t); });
+}
+} // namespace le
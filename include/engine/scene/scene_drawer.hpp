@@ -1,13 +1,16 @@
 #pragma once
+#include <atomic>
 #include <compare>
 #include <unordered_set>
 #include <core/span.hpp>
 #include <core/std_types.hpp>
 #include <dumb_ecf/types.hpp>
+#include <dumb_tasks/scheduler.hpp>
 #include <engine/scene/primitive.hpp>
 #include <glm/mat4x4.hpp>
 #include <graphics/render/command_buffer.hpp>
 #include <graphics/render/descriptor_set.hpp>
+#include <graphics/render/frustum.hpp>
 #include <graphics/render/pipeline.hpp>
 
 namespace decf {
@@ -17,6 +20,10 @@ namespace le {
 namespace gui {
 class TreeRoot;
 }
+class Model;
+class SceneIndex;
+template <typename T>
+class Asset;
 
 using PrimList = std::vector<Primitive>;
 
@@ -32,16 +39,25 @@ struct DrawGroup {
 	};
 };
 
+class SceneNode;
+
 class SceneDrawer {
   public:
 	struct Item {
 		glm::mat4 model = glm::mat4(1.0f);
 		std::optional<vk::Rect2D> scissor;
 		Span<Primitive const> primitives;
+		decf::entity_t entity = {}; // source entity (if any)
 	};
 
 	using ItemMap = std::unordered_map<DrawGroup, std::vector<Item>, DrawGroup::Hasher>;
 
+	struct Instances {
+		Primitive const* primitive = {};
+		std::vector<glm::mat4> models;
+		std::optional<vk::Rect2D> scissor;
+	};
+
 	struct Group {
 		DrawGroup group;
 		std::vector<Item> items;
@@ -54,6 +70,9 @@ class SceneDrawer {
 
 	struct Populator3D;
 	struct PopulatorUI;
+	class Builder;
+	class Culler;
+	class Instancer;
 
 	static void add(ItemMap& map, DrawGroup const& group, gui::TreeRoot const& root);
 
@@ -64,6 +83,10 @@ class SceneDrawer {
 	static void draw(Di&& dispatch, PipeSet& out_set, Span<Group const> groups, graphics::CommandBuffer cb);
 
 	static void attach(decf::registry_t& reg, decf::entity_t entity, DrawGroup const& group, Span<Primitive const> primitives);
+	///
+	/// \brief Attach model's primitives; the entity also holds model (as a component), keeping it resident in its AssetStore
+	///
+	static void attach(decf::registry_t& reg, decf::entity_t entity, DrawGroup const& group, Asset<Model> const& model);
 };
 
 struct SceneDrawer::Populator3D {
@@ -76,6 +99,112 @@ struct SceneDrawer::PopulatorUI {
 	void operator()(ItemMap& map, decf::registry_t const& registry) const;
 };
 
+///
+/// \brief Frame-persistent draw list builder for DrawGroup + SceneNode + PrimList entities
+///
+/// The first build() (and the first after clear()) scans the registry; after that the registry is not rescanned:
+/// entities are tracked via add() (new entities, or a changed DrawGroup / PrimList) and remove() events, which
+/// rebuild (and re-sort) groups from the tracked entries on the next build(). remove() must be called before a tracked
+/// entity's SceneNode is destroyed / detached. Otherwise only model matrices of tracked SceneNodes that are stale / have
+/// been recomputed are updated, split across worker threads in batches if a scheduler is passed.
+///
+class SceneDrawer::Builder {
+  public:
+	using Scheduler = dts::scheduler;
+
+	///
+	/// \brief Track entity (or pick up its changed DrawGroup / PrimList) on the next build()
+	///
+	void add(decf::entity_t entity);
+	///
+	/// \brief Stop tracking entity on the next build()
+	///
+	void remove(decf::entity_t entity);
+
+	Span<Group const> build(decf::registry_t const& registry, bool sort, Scheduler* scheduler = {});
+	Span<Group const> groups() const noexcept { return m_groups; }
+	void clear() noexcept;
+
+	std::size_t m_batch = 4096;
+
+  private:
+	struct Entry {
+		decf::entity_t entity;
+		DrawGroup group;
+		SceneNode const* node = {};
+		Span<Primitive const> primitives;
+		std::size_t groupIdx = 0;
+		std::size_t itemIdx = 0;
+		u64 generation = 0;
+	};
+	struct Event {
+		decf::entity_t entity;
+		bool add = false;
+	};
+
+	void scan(decf::registry_t const& registry);
+	void apply(decf::registry_t const& registry);
+	void track(decf::entity_t entity, DrawGroup const& group, SceneNode const& node, PrimList const& primitives);
+	void untrack(decf::entity_t entity);
+	void layout(bool sort);
+	void refresh(Scheduler* scheduler);
+
+	std::vector<Group> m_groups;
+	std::unordered_map<DrawGroup, std::size_t, DrawGroup::Hasher> m_index;
+	std::vector<Entry> m_entries;
+	std::unordered_map<decf::entity_t, std::size_t> m_entryIndex;
+	std::vector<Event> m_events;
+	std::vector<Entry*> m_dirty;
+	bool m_built = false;
+};
+
+///
+/// \brief Buckets items' primitives sharing the same Mesh and Material into instanced entries
+///
+/// Scissored items are never merged. Unordered: all matching primitives in the group are merged into the first entry
+/// (draw order across different meshes changes). Ordered: only adjacent runs are merged, draw order is preserved; required
+/// for groups whose pipeline blends (graphics::Pipeline::blended()) and for overlapping UI.
+/// Bucket storage is reused across calls.
+///
+class SceneDrawer::Instancer {
+  public:
+	void instance(std::vector<Instances>& out_instances, Span<Item const> items, bool bOrdered);
+
+  private:
+	std::unordered_map<graphics::Mesh const*, std::vector<std::size_t>> m_buckets;
+};
+
+///
+/// \brief Frustum culling pass over draw groups, using Mesh bounding spheres
+///
+/// Items are culled if none of their primitives' (world space) bounding spheres intersect the frustum;
+/// primitives without bounds, scissored items, and negative order groups (backgrounds / skyboxes) are never culled.
+/// If a (synced) SceneIndex is passed, the frustum is tested against its BVH once, and items of entities it contains
+/// are visible if they were hit (fat AABBs: conservative); other items are tested individually.
+/// Visibility tests are split across worker threads in batches if a scheduler is passed.
+///
+class SceneDrawer::Culler {
+  public:
+	using Scheduler = dts::scheduler;
+
+	inline static auto s_visible = std::atomic<u32>(0);
+	inline static auto s_culled = std::atomic<u32>(0);
+
+	Span<Group const> cull(Span<Group const> groups, graphics::Frustum const& frustum, Scheduler* scheduler = {});
+	Span<Group const> cull(Span<Group const> groups, graphics::Frustum const& frustum, SceneIndex const& index, Scheduler* scheduler = {});
+
+	std::size_t m_batch = 4096;
+
+  private:
+	static bool visible(Item const& item, graphics::Frustum const& frustum) noexcept;
+	Span<Group const> cull(Span<Group const> groups, graphics::Frustum const& frustum, SceneIndex const* index, Scheduler* scheduler);
+
+	std::unordered_set<decf::entity_t> m_hits;
+	std::vector<Group> m_groups;
+	std::vector<std::size_t> m_offsets;
+	std::vector<u8> m_visible;
+};
+
 // impl
 
 template <typename Po>
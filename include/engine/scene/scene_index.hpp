@@ -0,0 +1,78 @@
+#pragma once
+#include <optional>
+#include <unordered_map>
+#include <dumb_ecf/types.hpp>
+#include <engine/scene/bvh.hpp>
+
+namespace decf {
+class registry_t;
+}
+namespace le {
+///
+/// \brief Spatial index over entities with SceneNode + PrimList, backed by a BVH
+///
+/// sync() inserts new entities, removes stale ones, and refits only those whose SceneNode world transform
+/// has been recomputed since the last sync (tracked via SceneNode generations).
+///
+class SceneIndex {
+  public:
+	using AABB = BVH::AABB;
+	using Ray = BVH::Ray;
+
+	void sync(decf::registry_t const& registry);
+	void clear() noexcept;
+
+	template <typename F>
+	void query(AABB const& aabb, F f) const;
+	template <typename F>
+	void query(graphics::Frustum const& frustum, F f) const;
+	template <typename F>
+	void query(Ray const& ray, F f) const;
+	///
+	/// \brief Obtain the entity whose AABB is nearest along ray (if any); AABBs containing the ray's origin are ignored
+	///
+	std::optional<decf::entity_t> pick(Ray const& ray) const;
+	///
+	/// \brief Obtain the world space ray through ndc (x right, y up) for a camera's projection * view
+	///
+	static Ray unproject(glm::mat4 const& viewProj, glm::vec2 ndc, f32 length = Ray{}.length);
+
+	///
+	/// \brief Check whether entity is in the BVH (has bounds as of the last sync)
+	///
+	bool contains(decf::entity_t entity) const;
+
+	std::size_t size() const noexcept { return m_bvh.size(); }
+	BVH const& bvh() const noexcept { return m_bvh; }
+
+  private:
+	struct Record {
+		BVH::Proxy proxy = BVH::null;
+		u64 generation = 0;
+		u64 frame = 0;
+	};
+
+	std::unordered_map<decf::entity_t, Record> m_records;
+	std::vector<decf::entity_t> m_slots;
+	std::vector<u64> m_freeSlots;
+	BVH m_bvh;
+	u64 m_frame = 0;
+};
+
+// impl
+
+template <typename F>
+void SceneIndex::query(AABB const& aabb, F f) const {
+	m_bvh.query(aabb, [this, &f](u64 slot) { return f(m_slots[(std::size_t)slot]); });
+}
+
+template <typename F>
+void SceneIndex::query(graphics::Frustum const& frustum, F f) const {
+	m_bvh.query(frustum, [this, &f](u64 slot) { return f(m_slots[(std::size_t)slot]); });
+}
+
+template <typename F>
+void SceneIndex::query(Ray const& ray, F f) const {
+	m_bvh.query(ray, [this, &f](u64 slot, f32 t) { return f(m_slots[(std::size_t)slot], t); });
+}
+} // namespace le
@@ -1,26 +1,38 @@
 #pragma once
+#include <utility>
 #include <dumb_ecf/types.hpp>
+#include <engine/scene/transform_pool.hpp>
 #include <engine/utils/ref_tree.hpp>
-#include <glm/gtx/quaternion.hpp>
-#include <glm/mat4x4.hpp>
-#include <glm/vec3.hpp>
 
 namespace le {
-struct SceneTransform {
-	glm::vec3 position = glm::vec3(0.0f);
-	glm::quat orientation = glm::quat(1.0f, 0.0f, 0.0f, 0.0f);
-	glm::vec3 scale = glm::vec3(1.0f);
-
-	static SceneTransform const identity;
-
-	glm::mat4 matrix() const noexcept;
-};
-
+///
+/// \brief Hierarchical transform node: a handle into the shared TransformPool (local TRS + composed matrix)
+///
+/// Local transforms live in SceneNode::pool(); world / normal matrices are cached per node and recomputed when stale.
+///
 class SceneNode : public utils::RefTreeNode<SceneNode> {
   public:
 	using Root = typename RefTreeNode<SceneNode>::Root;
 
 	SceneNode(not_null<Root*> root, decf::entity_t entity = {}, SceneTransform const& transform = {});
+	SceneNode(SceneNode&&) = default;
+	SceneNode& operator=(SceneNode&&) = default;
+	~SceneNode() override;
+
+	///
+	/// \brief Obtain the pool storing all SceneNodes' local transforms
+	///
+	static TransformPool& pool() noexcept;
+	///
+	/// \brief Recompose all dirty local matrices (batched), then refresh all stale nodes under root (parents before children)
+	///
+	static void refreshAll(Root const& root) noexcept;
+
+	using RefTreeNode::parent;
+	///
+	/// \brief Set parent (marks world transform stale)
+	///
+	SceneNode& parent(not_null<Root*> root) noexcept;
 
 	///
 	/// \brief Set (local) position
@@ -50,16 +62,16 @@ class SceneNode : public utils::RefTreeNode<SceneNode> {
 	///
 	/// \brief Obtain local position
 	///
-	glm::vec3 const& position() const noexcept;
+	glm::vec3 position() const noexcept;
 	///
 	/// \brief Obtain local orientation
 	///
-	glm::quat const& orientation() const noexcept;
+	glm::quat orientation() const noexcept;
 	///
 	/// \brief Obtain local scale
 	///
-	glm::vec3 const& scale() const noexcept;
-	SceneTransform const& transform() const noexcept;
+	glm::vec3 scale() const noexcept;
+	SceneTransform transform() const noexcept;
 	///
 	/// \brief Check if scale is uniform across all axes
 	///
@@ -94,86 +106,128 @@ class SceneNode : public utils::RefTreeNode<SceneNode> {
 	///
 	bool stale() const noexcept;
 	///
-	/// \brief Recompute transformation matrices if stale
+	/// \brief Recompute transformation matrices (self and stale parents) if stale
 	///
 	void refresh() const noexcept;
+	///
+	/// \brief Obtain number of times the world transform has been recomputed
+	///
+	u64 generation() const noexcept;
 
 	decf::entity_t entity() const noexcept;
 	void entity(decf::entity_t entity) noexcept;
 
   private:
-	mutable glm::mat4 m_mat = glm::mat4(1.0f);
+	// owns a TransformPool slot; moved-from slots are null
+	struct Slot {
+		TransformPool::Index index = TransformPool::null;
+
+		Slot(SceneTransform const& transform) : index(pool().push(transform)) {}
+		Slot(Slot&& rhs) noexcept : index(std::exchange(rhs.index, TransformPool::null)) {}
+		Slot& operator=(Slot&& rhs) noexcept;
+		~Slot();
+	};
+
+	void setDirty() noexcept;
+	void setStale() noexcept;
+
+	mutable glm::mat4 m_world = glm::mat4(1.0f);
 	mutable glm::mat4 m_normalMat = glm::mat4(1.0f);
-	SceneTransform m_transform;
+	Slot m_slot;
 	decf::entity_t m_entity;
-	mutable bool m_dirty = false;
+	mutable u64 m_generation = 0;
+	mutable bool m_dirty = true;
+	mutable bool m_stale = true;
+	mutable bool m_isotropic = true;
 };
 
-inline SceneTransform const SceneTransform::identity = {};
-
 // impl
 
-inline glm::mat4 SceneTransform::matrix() const noexcept {
-	static constexpr auto base = glm::mat4(1.0f);
-	auto const t = glm::translate(base, position);
-	auto const r = glm::toMat4(orientation);
-	auto const s = glm::scale(base, scale);
-	return t * r * s;
+inline SceneNode::Slot& SceneNode::Slot::operator=(Slot&& rhs) noexcept {
+	if (&rhs != this) {
+		if (index != TransformPool::null) { pool().pop(index); }
+		index = std::exchange(rhs.index, TransformPool::null);
+	}
+	return *this;
+}
+
+inline SceneNode::Slot::~Slot() {
+	if (index != TransformPool::null) { pool().pop(index); }
 }
 
 inline SceneNode::SceneNode(not_null<Root*> parent, decf::entity_t entity, SceneTransform const& transform)
-	: RefTreeNode(parent), m_transform(transform), m_entity(entity) {}
+	: RefTreeNode(parent), m_slot(transform), m_entity(entity) {}
+
+inline SceneNode::~SceneNode() {
+	// children will be re-parented to this node's parent
+	for (auto child : children()) { child->setStale(); }
+}
+
+inline void SceneNode::refreshAll(Root const& root) noexcept {
+	pool().update();
+	Root::walk(root, [](SceneNode const& node) {
+		node.refresh();
+		return true;
+	});
+}
+
+inline SceneNode& SceneNode::parent(not_null<Root*> root) noexcept {
+	RefTreeNode::parent(root);
+	setStale();
+	return *this;
+}
 
 inline SceneNode& SceneNode::reset(SceneTransform const& transform) {
-	m_transform = transform;
+	pool().set(m_slot.index, transform);
+	setDirty();
 	refresh();
 	return *this;
 }
 
 inline SceneNode& SceneNode::position(glm::vec3 const& position) noexcept {
-	m_transform.position = position;
-	m_dirty = true;
+	pool().position(m_slot.index, position);
+	setDirty();
 	return *this;
 }
 inline SceneNode& SceneNode::orient(glm::quat const& orientation) noexcept {
-	m_transform.orientation = orientation;
-	m_dirty = true;
+	pool().orient(m_slot.index, orientation);
+	setDirty();
 	return *this;
 }
 inline SceneNode& SceneNode::rotate(f32 radians, glm::vec3 const& axis) noexcept {
-	m_transform.orientation = glm::rotate(m_transform.orientation, radians, axis);
-	m_dirty = true;
+	pool().orient(m_slot.index, glm::rotate(orientation(), radians, axis));
+	setDirty();
 	return *this;
 }
 inline SceneNode& SceneNode::scale(f32 scale) noexcept {
-	m_transform.scale = {scale, scale, scale};
-	m_dirty = true;
+	pool().scale(m_slot.index, {scale, scale, scale});
+	setDirty();
 	return *this;
 }
 inline SceneNode& SceneNode::scale(glm::vec3 const& scale) noexcept {
-	m_transform.scale = scale;
-	m_dirty = true;
+	pool().scale(m_slot.index, scale);
+	setDirty();
 	return *this;
 }
 
-inline glm::vec3 const& SceneNode::position() const noexcept { return m_transform.position; }
+inline glm::vec3 SceneNode::position() const noexcept { return pool().position(m_slot.index); }
 
-inline glm::quat const& SceneNode::orientation() const noexcept { return m_transform.orientation; }
+inline glm::quat SceneNode::orientation() const noexcept { return pool().orientation(m_slot.index); }
 
-inline glm::vec3 const& SceneNode::scale() const noexcept { return m_transform.scale; }
+inline glm::vec3 SceneNode::scale() const noexcept { return pool().scale(m_slot.index); }
 
-inline SceneTransform const& SceneNode::transform() const noexcept { return m_transform; }
+inline SceneTransform SceneNode::transform() const noexcept { return pool().get(m_slot.index); }
 
 inline bool SceneNode::isotropic() const noexcept {
-	return m_transform.scale.x == m_transform.scale.y && m_transform.scale.y == m_transform.scale.z &&
-		   (m_parent->isRoot() || static_cast<SceneNode const*>(m_parent.get())->isotropic());
+	refresh();
+	return m_isotropic;
 }
 
 inline glm::vec3 SceneNode::worldPosition() const noexcept { return glm::vec3(model()[3]); }
 
 inline glm::mat4 SceneNode::model() const noexcept {
 	refresh();
-	return m_parent->isRoot() ? m_mat : static_cast<SceneNode const*>(m_parent.get())->model() * m_mat;
+	return m_world;
 }
 
 inline glm::mat4 SceneNode::normalModel() const noexcept {
@@ -181,15 +235,40 @@ inline glm::mat4 SceneNode::normalModel() const noexcept {
 	return m_normalMat;
 }
 
-inline bool SceneNode::stale() const noexcept { return m_dirty || (m_parent->isRoot() ? false : static_cast<SceneNode const*>(m_parent.get())->stale()); }
+inline bool SceneNode::stale() const noexcept { return m_stale; }
 
 inline void SceneNode::refresh() const noexcept {
-	if (m_dirty) {
-		m_mat = m_transform.matrix();
-		m_normalMat = isotropic() ? m_mat : glm::mat4(glm::inverse(glm::transpose(glm::mat3(m_mat))));
-		m_dirty = false;
+	if (m_stale) {
+		SceneNode const* p = parent();
+		if (p) { p->refresh(); }
+		glm::vec3 const scl = scale();
+		bool const bIsotropic = scl.x == scl.y && scl.y == scl.z;
+		// composed by the pool: in batches if TransformPool::update() has run since the last change, else here
+		glm::mat4 const& mat = pool().matrix(m_slot.index);
+		if (m_dirty) {
+			m_normalMat = bIsotropic ? mat : glm::mat4(glm::inverse(glm::transpose(glm::mat3(mat))));
+			m_dirty = false;
+		}
+		m_world = p ? p->m_world * mat : mat;
+		m_isotropic = bIsotropic && (!p || p->m_isotropic);
+		++m_generation;
+		m_stale = false;
+	}
+}
+
+inline u64 SceneNode::generation() const noexcept { return m_generation; }
+
+inline void SceneNode::setDirty() noexcept {
+	m_dirty = true;
+	setStale();
+}
+
+inline void SceneNode::setStale() noexcept {
+	// a stale node's sub-tree is always stale: refreshing any descendant refreshes its ancestors first
+	if (!m_stale) {
+		m_stale = true;
+		for (auto child : children()) { child->setStale(); }
 	}
-	return;
 }
 
 inline decf::entity_t SceneNode::entity() const noexcept { return m_entity; }
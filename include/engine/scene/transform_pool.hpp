@@ -0,0 +1,96 @@
+#pragma once
+#include <vector>
+#include <core/span.hpp>
+#include <core/std_types.hpp>
+#include <glm/gtx/quaternion.hpp>
+#include <glm/mat4x4.hpp>
+#include <glm/vec3.hpp>
+
+namespace le {
+struct SceneTransform {
+	glm::vec3 position = glm::vec3(0.0f);
+	glm::quat orientation = glm::quat(1.0f, 0.0f, 0.0f, 0.0f);
+	glm::vec3 scale = glm::vec3(1.0f);
+
+	static SceneTransform const identity;
+
+	glm::mat4 matrix() const noexcept;
+};
+
+///
+/// \brief Structure-of-arrays storage for SceneTransforms, with batched (SIMD) TRS matrix composition
+///
+/// Each slot caches its composed (local) matrix; setters mark slots dirty, update() recomposes all dirty slots
+/// in batches, matrix() recomposes a single dirty slot on demand. Not thread safe.
+///
+class TransformPool {
+  public:
+	using Index = std::size_t;
+	static constexpr Index null = ~Index(0);
+
+	///
+	/// \brief Add a transform (reuses popped slots)
+	///
+	Index push(SceneTransform const& transform);
+	///
+	/// \brief Release a slot for reuse
+	///
+	void pop(Index index) noexcept;
+	void set(Index index, SceneTransform const& transform) noexcept;
+	SceneTransform get(Index index) const noexcept;
+	void clear() noexcept;
+	void reserve(std::size_t count);
+
+	void position(Index index, glm::vec3 const& position) noexcept;
+	void orient(Index index, glm::quat const& orientation) noexcept;
+	void scale(Index index, glm::vec3 const& scale) noexcept;
+	glm::vec3 position(Index index) const noexcept;
+	glm::quat orientation(Index index) const noexcept;
+	glm::vec3 scale(Index index) const noexcept;
+
+	///
+	/// \brief Obtain composed TRS matrix (recompose if dirty)
+	///
+	glm::mat4 const& matrix(Index index) const noexcept;
+	///
+	/// \brief Check if slot's matrix needs recomposing
+	///
+	bool dirty(Index index) const noexcept;
+	///
+	/// \brief Recompose matrices of all dirty slots (four at a time)
+	///
+	void update() noexcept;
+
+	std::size_t size() const noexcept { return m_soa.px.size(); }
+	bool empty() const noexcept { return m_soa.px.empty(); }
+
+	///
+	/// \brief Compose TRS matrices for all transforms into out (out.size() must be >= size())
+	///
+	void compose(Span<glm::mat4> out) const noexcept;
+
+  private:
+	void composeScalar(Span<glm::mat4> out, std::size_t begin, std::size_t end) const noexcept;
+	void setDirty(Index index) noexcept;
+
+	struct {
+		std::vector<f32> px, py, pz;
+		std::vector<f32> qx, qy, qz, qw;
+		std::vector<f32> sx, sy, sz;
+	} m_soa;
+	mutable std::vector<glm::mat4> m_matrices;
+	mutable std::vector<u8> m_dirty;
+	std::vector<Index> m_stale;
+	std::vector<Index> m_free;
+};
+
+inline SceneTransform const SceneTransform::identity = {};
+
+// impl
+
+inline glm::mat4 SceneTransform::matrix() const noexcept {
+	// T * R * S without intermediate 4x4 products
+	glm::mat3 const r = glm::mat3_cast(orientation);
+	return glm::mat4(glm::vec4(r[0] * scale.x, 0.0f), glm::vec4(r[1] * scale.y, 0.0f), glm::vec4(r[2] * scale.z, 0.0f), glm::vec4(position, 1.0f));
+}
+} // namespace le
@@ -14,6 +14,20 @@ struct EngineStats {
 			u64 buffers;
 			u64 images;
 		} bytes;
+		struct {
+			u64 used;
+			u64 highWater;
+			u64 capacity;
+		} uniforms;
+		struct {
+			u64 peak;
+			u64 capacity;
+			u64 stalls;
+		} staging;
+		struct {
+			u64 recorded;
+			u64 submitted;
+		} transfers;
 		struct {
 			glm::uvec2 swapchain;
 			glm::uvec2 window;
@@ -21,10 +35,20 @@ struct EngineStats {
 		} extents;
 		u32 drawCalls;
 		u32 triCount;
+		u32 descriptorWrites;
+		struct {
+			u32 visible;
+			u32 culled;
+		} items;
+	};
+
+	struct Assets {
+		u64 resourceBytes; // raw file contents held by Resources
 	};
 
 	Frame frame;
 	Gfx gfx;
+	Assets assets;
 	Time_s upTime;
 };
 } // namespace le::utils
@@ -157,6 +157,14 @@ T& RefTreeNode<T, Base>::parent(not_null<Root*> parent) noexcept {
 	return *cast(this);
 }
 template <typename T, typename Base>
+T* RefTreeNode<T, Base>::parent() noexcept {
+	return m_parent->isRoot() ? nullptr : cast(m_parent.get());
+}
+template <typename T, typename Base>
+T const* RefTreeNode<T, Base>::parent() const noexcept {
+	return m_parent->isRoot() ? nullptr : static_cast<T const*>(m_parent.get());
+}
+template <typename T, typename Base>
 RefTreeRoot<T, Base>& RefTreeNode<T, Base>::root() noexcept {
 	not_null<RefTreeRoot<T, Base>*> ret = m_parent;
 	while (!ret->m_root) { ret = cast(ret.get())->m_parent; }
@@ -0,0 +1,112 @@
+#pragma once
+#include <algorithm>
+#include <functional>
+#include <utility>
+#include <vector>
+#include <core/std_types.hpp>
+
+namespace le {
+///
+/// \brief Open-addressing (linear probing) hash map with contiguous storage; insert / find only (no erase)
+///
+/// Keys are compared for equality on every probe, so hash collisions never merge distinct keys.
+///
+template <typename K, typename V, typename H = std::hash<K>>
+class FlatMap {
+  public:
+	using key_type = K;
+	using mapped_type = V;
+
+	FlatMap() = default;
+	explicit FlatMap(std::size_t capacity) { reserve(capacity); }
+
+	///
+	/// \brief Insert value if key is not present
+	/// \returns pointer to mapped value, and whether it was inserted
+	///
+	std::pair<V*, bool> emplace(K const& key, V value);
+	V* find(K const& key) noexcept;
+	V const* find(K const& key) const noexcept;
+	bool contains(K const& key) const noexcept { return find(key) != nullptr; }
+
+	///
+	/// \brief Ensure count elements can be stored without rehashing
+	///
+	void reserve(std::size_t count);
+	void clear() noexcept;
+
+	std::size_t size() const noexcept { return m_size; }
+	bool empty() const noexcept { return m_size == 0; }
+	std::size_t capacity() const noexcept { return m_slots.size(); }
+
+  private:
+	struct Slot {
+		K key{};
+		V value{};
+		bool used = false;
+	};
+
+	static constexpr std::size_t minCapacity = 16;
+	// max load factor = num / den
+	static constexpr std::size_t num = 7, den = 10;
+
+	std::size_t index(K const& key) const noexcept { return H{}(key) & (m_slots.size() - 1); }
+	void rehash(std::size_t capacity);
+
+	std::vector<Slot> m_slots;
+	std::size_t m_size = 0;
+};
+
+// impl
+
+template <typename K, typename V, typename H>
+std::pair<V*, bool> FlatMap<K, V, H>::emplace(K const& key, V value) {
+	if ((m_size + 1) * den > m_slots.size() * num) { rehash(std::max(minCapacity, m_slots.size() * 2)); }
+	for (std::size_t idx = index(key);; idx = (idx + 1) & (m_slots.size() - 1)) {
+		Slot& slot = m_slots[idx];
+		if (!slot.used) {
+			slot = {key, std::move(value), true};
+			++m_size;
+			return {&slot.value, true};
+		}
+		if (slot.key == key) { return {&slot.value, false}; }
+	}
+}
+
+template <typename K, typename V, typename H>
+V* FlatMap<K, V, H>::find(K const& key) noexcept {
+	return const_cast<V*>(std::as_const(*this).find(key));
+}
+
+template <typename K, typename V, typename H>
+V const* FlatMap<K, V, H>::find(K const& key) const noexcept {
+	if (m_slots.empty()) { return nullptr; }
+	for (std::size_t idx = index(key);; idx = (idx + 1) & (m_slots.size() - 1)) {
+		Slot const& slot = m_slots[idx];
+		if (!slot.used) { return nullptr; }
+		if (slot.key == key) { return &slot.value; }
+	}
+}
+
+template <typename K, typename V, typename H>
+void FlatMap<K, V, H>::reserve(std::size_t count) {
+	std::size_t capacity = minCapacity;
+	while (count * den > capacity * num) { capacity <<= 1; }
+	if (capacity > m_slots.size()) { rehash(capacity); }
+}
+
+template <typename K, typename V, typename H>
+void FlatMap<K, V, H>::clear() noexcept {
+	for (Slot& slot : m_slots) { slot.used = false; }
+	m_size = 0;
+}
+
+template <typename K, typename V, typename H>
+void FlatMap<K, V, H>::rehash(std::size_t capacity) {
+	std::vector<Slot> old = std::exchange(m_slots, std::vector<Slot>(capacity));
+	m_size = 0;
+	for (Slot& slot : old) {
+		if (slot.used) { emplace(slot.key, std::move(slot.value)); }
+	}
+}
+} // namespace le
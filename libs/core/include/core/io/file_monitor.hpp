@@ -34,6 +34,7 @@ class FileMonitor {
   public:
 	///
 	/// \brief Obtain current status of file being monitored
+	/// Files are only re-checked when FileWatcher reports an event for them (where supported), else polled
 	///
 	virtual Status update();
 
@@ -74,7 +75,9 @@ class FileMonitor {
 	stdfs::path m_path;
 	std::string m_text;
 	bytearray m_bytes;
+	std::size_t m_hash = 0;
 	Mode m_mode;
 	Status m_status = Status::eNotFound;
+	bool m_watched = false;
 };
 } // namespace le::io
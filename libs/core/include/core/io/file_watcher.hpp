@@ -0,0 +1,49 @@
+#pragma once
+#include <filesystem>
+#include <memory>
+
+namespace le::io {
+///
+/// \brief Event driven file change notifications (inotify on Linux)
+///
+/// Parent directories of watched files are watched (so atomic-rename saves are seen);
+/// events are batched by a background thread and consumed per file via `consume()`.
+///
+class FileWatcher {
+  public:
+	///
+	/// \brief Check whether event driven watching is available on this platform
+	///
+	static bool supported() noexcept;
+	///
+	/// \brief Obtain the shared instance (background thread started lazily, on first watch)
+	///
+	static FileWatcher& inst();
+
+	FileWatcher();
+	FileWatcher(FileWatcher&&) = delete;
+	FileWatcher& operator=(FileWatcher&&) = delete;
+	~FileWatcher();
+
+	///
+	/// \brief Start watching a file (ref-counted)
+	/// \returns false if the file cannot be watched (caller should poll)
+	///
+	bool watch(std::filesystem::path const& file);
+	///
+	/// \brief Stop watching a file (ref-counted)
+	///
+	void unwatch(std::filesystem::path const& file);
+	///
+	/// \brief Check and reset whether any events were received for file since the last call
+	///
+	/// Also true after event queue overflows, and while the file's directory is not watched (deleted / moved: re-watched on
+	/// the next call that succeeds): callers poll the file in those cases.
+	///
+	bool consume(std::filesystem::path const& file);
+
+  private:
+	struct Impl;
+	std::unique_ptr<Impl> m_impl;
+};
+} // namespace le::io
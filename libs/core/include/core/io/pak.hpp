@@ -0,0 +1,58 @@
+#pragma once
+#include <string_view>
+#include <core/io/path.hpp>
+#include <core/std_types.hpp>
+
+namespace le::io::pak {
+///
+/// \brief Pak file layout (little endian):
+///
+/// [Header] [entry data, each aligned to `alignment`] [names] [Entry table, sorted by hash]
+///
+inline constexpr u32 magic = 0x504b564c; // "LVKP"
+inline constexpr u32 version = 1;
+///
+/// \brief Alignment of every entry's data (suitable for direct staging buffer copies)
+///
+inline constexpr u64 alignment = 256;
+
+enum class Compression : u8 { eNone };
+
+struct Header {
+	u32 magic = pak::magic;
+	u32 version = pak::version;
+	u64 count = 0;
+	u64 tableOffset = 0;
+	u64 namesOffset = 0;
+};
+
+struct Entry {
+	u64 hash = 0;
+	u64 offset = 0;
+	u64 size = 0;
+	u64 nameOffset = 0;
+	u32 nameSize = 0;
+	Compression compression = Compression::eNone;
+	u8 padding[3] = {};
+};
+
+static_assert(sizeof(Header) == 32 && sizeof(Entry) == 40, "Unexpected pak struct layout");
+
+///
+/// \brief Stable (toolchain independent) FNV-1a hash of an entry's id (generic path)
+///
+constexpr u64 hash(std::string_view id) noexcept {
+	u64 ret = 0xcbf29ce484222325ULL;
+	for (char const c : id) {
+		ret ^= (u64)(u8)c;
+		ret *= 0x100000001b3ULL;
+	}
+	return ret;
+}
+
+///
+/// \brief Pack all regular files under `root` (ids relative to `root`) into `out`
+/// \returns number of entries packed, or -1 on failure
+///
+s64 pack(io::Path const& root, io::Path const& out);
+} // namespace le::io::pak
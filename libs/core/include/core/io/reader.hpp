@@ -1,13 +1,32 @@
 #pragma once
+#include <atomic>
+#include <memory>
+#include <optional>
 #include <sstream>
 #include <string_view>
+#include <unordered_map>
 #include <core/erased_ptr.hpp>
+#include <core/flat_map.hpp>
+#include <core/hash.hpp>
 #include <core/io/path.hpp>
 #include <core/span.hpp>
 #include <core/std_types.hpp>
 #include <kt/result/result.hpp>
+#include <kt/tmutex/shared_tmutex.hpp>
 
 namespace le::io {
+///
+/// \brief Read-only view of a file's contents
+///
+/// `owner` keeps the backing storage (heap buffer or memory mapping) alive; copies share it
+///
+struct ByteView {
+	Span<std::byte const> bytes;
+	std::shared_ptr<void const> owner;
+
+	bool empty() const noexcept { return bytes.empty(); }
+};
+
 ///
 /// \brief Abstract base class for reading data from various IO
 ///
@@ -60,6 +79,11 @@ class Reader {
 	/// \brief Obtain data as `std::stringstream`
 	///
 	[[nodiscard]] virtual Result<std::stringstream> sstream(io::Path const& id) const = 0;
+	///
+	/// \brief Obtain a shared read-only view of data
+	/// Default implementation wraps `bytes()`; mediums that can avoid the copy override it
+	///
+	[[nodiscard]] virtual Result<ByteView> view(io::Path const& id) const;
 
   protected:
 	std::string m_medium;
@@ -89,6 +113,14 @@ class FileReader final : public Reader {
 	/// \brief Obtain fully qualified path (if `id` is found)
 	///
 	io::Path fullPath(io::Path const& id) const;
+	///
+	/// \brief Drop the cached resolution of `id` (eg after the file was moved / deleted)
+	///
+	void invalidate(io::Path const& id) const;
+	///
+	/// \brief Obtain the number of filesystem stat calls avoided by cached lookups
+	///
+	u64 statsSaved() const noexcept { return m_cache.statsSaved.load(); }
 
   public:
 	///
@@ -99,18 +131,35 @@ class FileReader final : public Reader {
 	Result<std::stringstream> sstream(io::Path const& id) const override;
 
   private:
+	// resolved (mount prefixed) paths of relative ids; only hits are cached, stale entries are evicted on open failure
+	struct Cache {
+		struct Entry {
+			std::string id;
+			io::Path path;
+			u64 stats = 0;
+		};
+
+		kt::shared_strict_tmutex<std::unordered_map<Hash, Entry>> entries;
+		std::atomic<u64> statsSaved;
+
+		Cache() = default;
+		Cache(Cache const&) noexcept {}
+		Cache& operator=(Cache const&) noexcept;
+	};
+
 	std::vector<io::Path> m_dirs;
+	mutable Cache m_cache;
 
   private:
 	Result<io::Path> findPrefixed(io::Path const& id) const override;
-
-  private:
-	std::vector<io::Path> finalPaths(io::Path const& id) const;
 };
 
 ///
 /// \brief Concrete class for `.zip` IO
 ///
+/// Archives are streamed from disk; the directory of each archive is indexed on mount.
+/// `bytes()` / `sstream()` are safe to call concurrently (each read uses its own PhysFS handle).
+///
 class ZIPReader final : public Reader {
   public:
 	ZIPReader();
@@ -124,10 +173,57 @@ class ZIPReader final : public Reader {
 	Result<std::stringstream> sstream(io::Path const& id) const override;
 
   private:
+	struct Entry {
+		std::string id;
+		std::size_t size = 0;
+	};
+	using Index = FlatMap<Hash, Entry>;
+
 	std::vector<io::Path> m_zips;
+	kt::shared_strict_tmutex<Index> m_index;
+
+  private:
+	Result<io::Path> findPrefixed(io::Path const& id) const override;
+
+  private:
+	std::optional<Entry> entry(io::Path const& id) const;
+	std::size_t index(std::string const& archive);
+};
+
+///
+/// \brief Concrete class for `.pak` IO (see `core/io/pak.hpp`)
+///
+/// Paks are memory mapped on mount and their entry tables indexed; lookups are O(1) and
+/// `view()` returns (aligned) spans into the mapping without copying.
+///
+class PakReader final : public Reader {
+  public:
+	PakReader();
+
+  public:
+	///
+	/// \brief Mount `.pak` file
+	///
+	bool mount(io::Path path) override;
+	Result<bytearray> bytes(io::Path const& id) const override;
+	Result<std::stringstream> sstream(io::Path const& id) const override;
+	Result<ByteView> view(io::Path const& id) const override;
+
+  private:
+	struct Ref {
+		ByteView data;
+		std::string_view id;
+	};
+	using Index = FlatMap<u64, Ref>;
+
+	std::vector<io::Path> m_paks;
+	kt::shared_strict_tmutex<Index> m_index;
 
   private:
 	Result<io::Path> findPrefixed(io::Path const& id) const override;
+
+  private:
+	std::optional<Ref> find(io::Path const& id) const;
 };
 
 ///
@@ -1,4 +1,5 @@
 #include <core/io/file_monitor.hpp>
+#include <core/io/file_watcher.hpp>
 #include <core/log.hpp>
 #include <core/utils/string.hpp>
 
@@ -19,15 +20,40 @@ stdfs::file_time_type lwt([[maybe_unused]] stdfs::path const& path, [[maybe_unus
 	return stdfs::last_write_time(path, err_code);
 #endif
 }
+
+std::size_t hash(std::string_view str) noexcept { return std::hash<std::string_view>{}(str); }
+std::size_t hash(bytearray const& bytes) noexcept { return hash(std::string_view(reinterpret_cast<char const*>(bytes.data()), bytes.size())); }
 } // namespace
 
-FileMonitor::FileMonitor(stdfs::path const& path, Mode mode) : m_path(path), m_mode(mode) {}
+FileMonitor::FileMonitor(stdfs::path const& path, Mode mode) : m_path(path), m_mode(mode) { m_watched = FileWatcher::inst().watch(m_path); }
+
+FileMonitor::FileMonitor(FileMonitor&& rhs)
+	: m_lastWriteTime(rhs.m_lastWriteTime), m_lastModifiedTime(rhs.m_lastModifiedTime), m_path(std::move(rhs.m_path)), m_text(std::move(rhs.m_text)),
+	  m_bytes(std::move(rhs.m_bytes)), m_hash(rhs.m_hash), m_mode(rhs.m_mode), m_status(rhs.m_status), m_watched(std::exchange(rhs.m_watched, false)) {}
+
+FileMonitor& FileMonitor::operator=(FileMonitor&& rhs) {
+	if (&rhs != this) {
+		if (m_watched) { FileWatcher::inst().unwatch(m_path); }
+		m_lastWriteTime = rhs.m_lastWriteTime;
+		m_lastModifiedTime = rhs.m_lastModifiedTime;
+		m_path = std::move(rhs.m_path);
+		m_text = std::move(rhs.m_text);
+		m_bytes = std::move(rhs.m_bytes);
+		m_hash = rhs.m_hash;
+		m_mode = rhs.m_mode;
+		m_status = rhs.m_status;
+		m_watched = std::exchange(rhs.m_watched, false);
+	}
+	return *this;
+}
 
-FileMonitor::FileMonitor(FileMonitor&&) = default;
-FileMonitor& FileMonitor::operator=(FileMonitor&&) = default;
-FileMonitor::~FileMonitor() = default;
+FileMonitor::~FileMonitor() {
+	if (m_watched) { FileWatcher::inst().unwatch(m_path); }
+}
 
 FileMonitor::Status FileMonitor::update() {
+	// no events since the last (successful) scan: nothing to stat or read
+	if (m_watched && m_status != Status::eNotFound && !FileWatcher::inst().consume(m_path)) { return m_status = Status::eUpToDate; }
 	std::error_code errCode;
 	if (rf(m_path, errCode)) {
 		auto const lastWriteTime = lwt(m_path, errCode);
@@ -37,19 +63,21 @@ FileMonitor::Status FileMonitor::update() {
 			m_lastWriteTime = lastWriteTime;
 			if (m_mode == Mode::eTextContents) {
 				if (auto text = s_reader.string(m_path.generic_string())) {
-					if (*text == m_text) {
+					if (auto const h = hash(*text); h == m_hash) {
 						bDirty = false;
 					} else {
 						m_text = std::move(text).value();
+						m_hash = h;
 						m_lastModifiedTime = m_lastWriteTime;
 					}
 				}
 			} else if (m_mode == Mode::eBinaryContents) {
 				if (auto bytes = s_reader.bytes(m_path.generic_string())) {
-					if (*bytes == m_bytes) {
+					if (auto const h = hash(*bytes); h == m_hash) {
 						bDirty = false;
 					} else {
 						m_bytes = std::move(bytes).value();
+						m_hash = h;
 						m_lastModifiedTime = m_lastWriteTime;
 					}
 				}
@@ -0,0 +1,208 @@
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <core/io/file_watcher.hpp>
+#include <core/log.hpp>
+#include <core/os.hpp>
+#include <core/utils/string.hpp>
+
+#if defined(LEVK_OS_LINUX)
+#include <cerrno>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+namespace le::io {
+namespace {
+std::string key(std::filesystem::path const& path) { return path.lexically_normal().generic_string(); }
+
+#if defined(LEVK_OS_LINUX)
+constexpr u32 watchMask = IN_CLOSE_WRITE | IN_MOVED_TO | IN_MOVED_FROM | IN_CREATE | IN_DELETE | IN_DELETE_SELF | IN_MOVE_SELF | IN_ONLYDIR;
+#endif
+} // namespace
+
+struct FileWatcher::Impl {
+	struct Dir {
+		int wd = -1; // -1: watch lost (directory deleted / moved), files are polled until re-added
+		u32 count = 0;
+	};
+
+	std::mutex mutex;
+	std::unordered_map<std::string, Dir> dirs;
+	std::unordered_map<int, std::string> wds;
+	std::unordered_map<std::string, u32> files;
+	std::unordered_set<std::string> dirty;
+	std::thread thread;
+	int fd = -1;
+	int wake = -1;
+
+	void start();
+	void stop();
+	void run();
+	bool add(std::string const& path, Dir& out_dir);
+	void lost(int wd);
+	void dirtyAll(std::string_view dir);
+};
+
+bool FileWatcher::supported() noexcept { return levk_OS == os::OS::eLinux; }
+
+FileWatcher& FileWatcher::inst() {
+	static FileWatcher s_inst;
+	return s_inst;
+}
+
+FileWatcher::FileWatcher() : m_impl(std::make_unique<Impl>()) {}
+
+FileWatcher::~FileWatcher() { m_impl->stop(); }
+
+bool FileWatcher::watch([[maybe_unused]] std::filesystem::path const& file) {
+#if defined(LEVK_OS_LINUX)
+	auto const path = key(file);
+	auto const dir = key(file.parent_path());
+	std::scoped_lock lock(m_impl->mutex);
+	if (m_impl->fd < 0) { m_impl->start(); }
+	if (m_impl->fd < 0) { return false; }
+	auto& d = m_impl->dirs[dir];
+	if (d.count == 0 && !m_impl->add(dir, d)) {
+		m_impl->dirs.erase(dir);
+		logW("[{}] Failed to watch [{}], falling back to polling", utils::tName<FileWatcher>(), dir);
+		return false;
+	}
+	++d.count;
+	++m_impl->files[path];
+	return true;
+#else
+	return false;
+#endif
+}
+
+void FileWatcher::unwatch([[maybe_unused]] std::filesystem::path const& file) {
+#if defined(LEVK_OS_LINUX)
+	auto const path = key(file);
+	auto const dir = key(file.parent_path());
+	std::scoped_lock lock(m_impl->mutex);
+	if (auto it = m_impl->files.find(path); it != m_impl->files.end() && --it->second == 0) {
+		m_impl->files.erase(it);
+		m_impl->dirty.erase(path);
+	}
+	if (auto it = m_impl->dirs.find(dir); it != m_impl->dirs.end() && --it->second.count == 0) {
+		if (it->second.wd >= 0) {
+			inotify_rm_watch(m_impl->fd, it->second.wd);
+			m_impl->wds.erase(it->second.wd);
+		}
+		m_impl->dirs.erase(it);
+	}
+#endif
+}
+
+bool FileWatcher::consume(std::filesystem::path const& file) {
+	std::scoped_lock lock(m_impl->mutex);
+	if (m_impl->dirty.erase(key(file)) > 0) { return true; }
+#if defined(LEVK_OS_LINUX)
+	if (auto it = m_impl->dirs.find(key(file.parent_path())); it != m_impl->dirs.end() && it->second.wd < 0) {
+		// poll while the watch is lost (and once more after re-adding it: events in between were missed)
+		if (m_impl->add(it->first, it->second)) { logD("[{}] Re-watching [{}]", utils::tName<FileWatcher>(), it->first); }
+		return true;
+	}
+#endif
+	return false;
+}
+
+bool FileWatcher::Impl::add([[maybe_unused]] std::string const& path, [[maybe_unused]] Dir& out_dir) {
+#if defined(LEVK_OS_LINUX)
+	out_dir.wd = inotify_add_watch(fd, path.data(), watchMask);
+	if (out_dir.wd < 0) { return false; }
+	wds[out_dir.wd] = path;
+	return true;
+#else
+	return false;
+#endif
+}
+
+void FileWatcher::Impl::lost([[maybe_unused]] int wd) {
+#if defined(LEVK_OS_LINUX)
+	if (auto it = wds.find(wd); it != wds.end()) {
+		if (auto dir = dirs.find(it->second); dir != dirs.end()) { dir->second.wd = -1; }
+		dirtyAll(it->second);
+		// a moved directory is still watched (at its new path): drop it
+		inotify_rm_watch(fd, wd);
+		wds.erase(it);
+	}
+#endif
+}
+
+void FileWatcher::Impl::dirtyAll(std::string_view dir) {
+	for (auto const& [path, _] : files) {
+		if (dir.empty() || key(std::filesystem::path(path).parent_path()) == dir) { dirty.insert(path); }
+	}
+}
+
+void FileWatcher::Impl::start() {
+#if defined(LEVK_OS_LINUX)
+	fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+	wake = fd < 0 ? -1 : eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+	if (fd < 0 || wake < 0) {
+		logW("[{}] inotify unavailable, falling back to polling", utils::tName<FileWatcher>());
+		if (fd >= 0) { ::close(fd); }
+		fd = wake = -1;
+		return;
+	}
+	thread = std::thread([this]() { run(); });
+#endif
+}
+
+void FileWatcher::Impl::stop() {
+#if defined(LEVK_OS_LINUX)
+	if (thread.joinable()) {
+		u64 const one = 1;
+		[[maybe_unused]] auto const written = ::write(wake, &one, sizeof(one));
+		thread.join();
+	}
+	if (fd >= 0) { ::close(fd); }
+	if (wake >= 0) { ::close(wake); }
+	fd = wake = -1;
+#endif
+}
+
+void FileWatcher::Impl::run() {
+#if defined(LEVK_OS_LINUX)
+	alignas(inotify_event) char buf[4096];
+	pollfd fds[] = {{fd, POLLIN, 0}, {wake, POLLIN, 0}};
+	for (;;) {
+		if (::poll(fds, 2, -1) < 0) {
+			if (errno == EINTR) { continue; }
+			break;
+		}
+		if (fds[1].revents & POLLIN) { break; }
+		if (!(fds[0].revents & POLLIN)) { continue; }
+		// drain all pending events (a save typically produces several)
+		for (ssize_t len; (len = ::read(fd, buf, sizeof(buf))) > 0;) {
+			std::scoped_lock lock(mutex);
+			for (char const* ptr = buf; ptr < buf + len;) {
+				auto const& event = *reinterpret_cast<inotify_event const*>(ptr);
+				ptr += sizeof(inotify_event) + event.len;
+				if (event.mask & IN_Q_OVERFLOW) {
+					// events were dropped: every watched file may have changed
+					logW("[{}] Event queue overflow, rescanning all files", utils::tName<FileWatcher>());
+					dirtyAll({});
+					continue;
+				}
+				if (event.mask & (IN_IGNORED | IN_DELETE_SELF | IN_MOVE_SELF)) {
+					// watched directory removed / moved / unmounted: the watch is gone
+					lost(event.wd);
+					continue;
+				}
+				if (auto it = wds.find(event.wd); it != wds.end() && event.len > 0) {
+					auto path = it->second + "/" + event.name;
+					if (files.contains(path)) { dirty.insert(std::move(path)); }
+				}
+			}
+		}
+	}
+#endif
+}
+} // namespace le::io
@@ -0,0 +1,191 @@
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <core/io/pak.hpp>
+#include <core/io/reader.hpp>
+#include <core/log.hpp>
+#include <core/utils/string.hpp>
+#include <io_impl.hpp>
+
+namespace le::io {
+namespace {
+constexpr u64 alignUp(u64 value, u64 align) noexcept { return (value + align - 1) & ~(align - 1); }
+
+template <typename T>
+void write(std::ofstream& out, T const& t) {
+	out.write(reinterpret_cast<char const*>(&t), sizeof(T));
+}
+
+void pad(std::ofstream& out, u64 to) {
+	static constexpr char zeroes[pak::alignment] = {};
+	for (u64 pos = (u64)out.tellp(); pos < to;) {
+		u64 const count = std::min(to - pos, pak::alignment);
+		out.write(zeroes, (std::streamsize)count);
+		pos += count;
+	}
+}
+} // namespace
+
+s64 pak::pack(io::Path const& root, io::Path const& out) {
+	namespace stdfs = std::filesystem;
+	stdfs::path const rootPath = root.string();
+	std::error_code err;
+	if (!stdfs::is_directory(rootPath, err)) {
+		logE("[{}] [{}] not a directory!", utils::tName<PakReader>(), root.generic_string());
+		return -1;
+	}
+	struct File {
+		stdfs::path path;
+		std::string id;
+		u64 hash;
+	};
+	std::vector<File> files;
+	for (auto const& it : stdfs::recursive_directory_iterator(rootPath, err)) {
+		if (it.is_regular_file(err)) {
+			auto id = stdfs::relative(it.path(), rootPath, err).generic_string();
+			u64 const hash = pak::hash(id);
+			files.push_back({it.path(), std::move(id), hash});
+		}
+	}
+	// sorted table: deterministic output, and binary searchable without an index
+	std::sort(files.begin(), files.end(), [](File const& lhs, File const& rhs) { return lhs.hash < rhs.hash; });
+	for (std::size_t i = 1; i < files.size(); ++i) {
+		if (files[i].hash == files[i - 1].hash) {
+			logE("[{}] Hash collision: [{}] / [{}]", utils::tName<PakReader>(), files[i - 1].id, files[i].id);
+			return -1;
+		}
+	}
+	std::ofstream file(out.string(), std::ios::binary | std::ios::trunc);
+	if (!file) {
+		logE("[{}] Failed to open [{}] for writing!", utils::tName<PakReader>(), out.generic_string());
+		return -1;
+	}
+	Header header;
+	header.count = files.size();
+	write(file, header);
+	std::vector<Entry> entries;
+	entries.reserve(files.size());
+	std::vector<char> buf;
+	for (File const& f : files) {
+		std::ifstream in(f.path, std::ios::binary | std::ios::ate);
+		if (!in) {
+			logE("[{}] Failed to read [{}]!", utils::tName<PakReader>(), f.path.generic_string());
+			return -1;
+		}
+		buf.resize((std::size_t)in.tellg());
+		in.seekg(0, std::ios::beg);
+		in.read(buf.data(), (std::streamsize)buf.size());
+		Entry entry;
+		entry.hash = f.hash;
+		entry.offset = alignUp((u64)file.tellp(), alignment);
+		entry.size = buf.size();
+		pad(file, entry.offset);
+		file.write(buf.data(), (std::streamsize)buf.size());
+		entries.push_back(entry);
+	}
+	header.namesOffset = (u64)file.tellp();
+	for (std::size_t i = 0; i < files.size(); ++i) {
+		entries[i].nameOffset = (u64)file.tellp() - header.namesOffset;
+		entries[i].nameSize = (u32)files[i].id.size();
+		file.write(files[i].id.data(), (std::streamsize)files[i].id.size());
+	}
+	header.tableOffset = alignUp((u64)file.tellp(), alignof(Entry));
+	pad(file, header.tableOffset);
+	for (Entry const& entry : entries) { write(file, entry); }
+	file.seekp(0, std::ios::beg);
+	write(file, header);
+	if (!file) {
+		logE("[{}] Failed to write [{}]!", utils::tName<PakReader>(), out.generic_string());
+		return -1;
+	}
+	return (s64)entries.size();
+}
+
+PakReader::PakReader() { m_medium = "Pak"; }
+
+bool PakReader::mount(io::Path path) {
+	auto const pathStr = path.generic_string();
+	if (std::find(m_paks.begin(), m_paks.end(), path) != m_paks.end()) {
+		logW("[{}] [{}] pak already mounted", utils::tName<PakReader>(), pathStr);
+		return false;
+	}
+	auto mapped = std::make_shared<impl::MappedFile>();
+	if (!mapped->map(path, false)) {
+		logE("[{}] [{}] not found on Filesystem!", utils::tName<PakReader>(), pathStr);
+		return false;
+	}
+	auto const* pBase = static_cast<std::byte const*>(mapped->pData);
+	pak::Header header;
+	if (mapped->size >= sizeof(header)) { std::memcpy(&header, pBase, sizeof(header)); }
+	// bounds are checked by subtraction: sums of untrusted offsets / sizes may overflow
+	bool const bTable = header.tableOffset <= mapped->size && header.count <= (mapped->size - header.tableOffset) / sizeof(pak::Entry);
+	bool const bValid = mapped->size >= sizeof(header) && header.magic == pak::magic && header.version == pak::version &&
+						header.tableOffset % alignof(pak::Entry) == 0 && bTable && header.namesOffset <= header.tableOffset;
+	if (!bValid) {
+		logE("[{}] [{}] invalid pak!", utils::tName<PakReader>(), pathStr);
+		return false;
+	}
+	auto const* pEntries = reinterpret_cast<pak::Entry const*>(pBase + header.tableOffset);
+	auto const* pNames = reinterpret_cast<char const*>(pBase + header.namesOffset);
+	u64 const namesSize = header.tableOffset - header.namesOffset;
+	std::shared_ptr<void const> owner = std::move(mapped);
+	{
+		kt::unique_tlock<Index> lock(m_index);
+		lock->reserve(lock->size() + header.count);
+		for (u64 i = 0; i < header.count; ++i) {
+			pak::Entry const& entry = pEntries[i];
+			bool const bData = entry.size <= header.namesOffset && entry.offset <= header.namesOffset - entry.size;
+			bool const bName = entry.nameSize <= namesSize && entry.nameOffset <= namesSize - entry.nameSize;
+			if (!bData || !bName) {
+				logE("[{}] [{}] corrupt entry [{}], skipping", utils::tName<PakReader>(), pathStr, i);
+				continue;
+			}
+			Ref ref{{Span<std::byte const>(pBase + entry.offset, entry.size), owner}, std::string_view(pNames + entry.nameOffset, entry.nameSize)};
+			// later mounts take precedence
+			if (auto [pRef, bNew] = lock->emplace(entry.hash, ref); !bNew) { *pRef = std::move(ref); }
+		}
+	}
+	logD("[{}] [{}] pak mounted [{} entries]", utils::tName<PakReader>(), pathStr, header.count);
+	m_paks.push_back(std::move(path));
+	return true;
+}
+
+Reader::Result<bytearray> PakReader::bytes(io::Path const& id) const {
+	if (auto const ref = find(id)) {
+		auto const bytes = ref->data.bytes;
+		bytearray ret(bytes.size());
+		if (!bytes.empty()) { std::memcpy(ret.data(), bytes.data(), bytes.size()); }
+		return ret;
+	}
+	logE("[{}] [{}] not found in {}!", utils::tName(this), id.generic_string(), m_medium);
+	return kt::null_result;
+}
+
+Reader::Result<std::stringstream> PakReader::sstream(io::Path const& id) const {
+	if (auto const ref = find(id)) {
+		auto const bytes = ref->data.bytes;
+		return std::stringstream(std::string(reinterpret_cast<char const*>(bytes.data()), bytes.size()));
+	}
+	logE("[{}] [{}] not found in {}!", utils::tName(this), id.generic_string(), m_medium);
+	return kt::null_result;
+}
+
+Reader::Result<ByteView> PakReader::view(io::Path const& id) const {
+	if (auto ref = find(id)) { return std::move(ref->data); }
+	logE("[{}] [{}] not found in {}!", utils::tName(this), id.generic_string(), m_medium);
+	return kt::null_result;
+}
+
+Reader::Result<io::Path> PakReader::findPrefixed(io::Path const& id) const {
+	if (find(id)) { return io::Path(id); }
+	return kt::null_result;
+}
+
+std::optional<PakReader::Ref> PakReader::find(io::Path const& id) const {
+	auto const str = id.generic_string();
+	kt::tlock lock(m_index);
+	if (auto const pRef = lock.get().find(pak::hash(str)); pRef && pRef->id == str) { return *pRef; }
+	return std::nullopt;
+}
+} // namespace le::io
@@ -10,6 +10,15 @@
 
 #if defined(LEVK_OS_ANDROID)
 #include <android_native_app_glue.h>
+#elif defined(LEVK_OS_WINDOWS)
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <Windows.h>
+#elif defined(LEVK_OS_LINUX)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 #endif
 
 namespace le::io {
@@ -77,6 +86,16 @@ PhysfsHandle::~PhysfsHandle() {
 }
 
 std::optional<PhysfsHandle> g_physfsHandle;
+
+bool readZipped(std::string const& id, void* pOut, std::size_t size) {
+	// one handle per read: PhysFS handles are not safe to share across threads
+	auto pFile = PHYSFS_openRead(id.data());
+	if (!pFile) { return false; }
+	auto const read = PHYSFS_readBytes(pFile, pOut, (PHYSFS_uint64)size);
+	PHYSFS_close(pFile);
+	return read == (PHYSFS_sint64)size;
+}
+
 } // namespace
 
 Reader::Reader() noexcept = default;
@@ -91,6 +110,14 @@ Reader::Result<std::string> Reader::string(io::Path const& id) const {
 	return kt::null_result;
 }
 
+Reader::Result<ByteView> Reader::view(io::Path const& id) const {
+	if (auto buf = bytes(id)) {
+		auto owner = std::make_shared<bytearray>(std::move(buf).value());
+		return ByteView{*owner, std::move(owner)};
+	}
+	return kt::null_result;
+}
+
 bool Reader::present(const io::Path& id) const { return findPrefixed(id).has_value(); }
 
 bool Reader::checkPresence(io::Path const& id) const {
@@ -157,6 +184,9 @@ Reader::Result<bytearray> FileReader::bytes(io::Path const& id) const {
 			file.read((char*)buf.data(), (std::streamsize)pos);
 			return buf;
 		}
+		// stale cache entry: retry if the id now resolves elsewhere
+		invalidate(id);
+		if (auto fresh = findPrefixed(id); fresh && !(*fresh == *path)) { return bytes(id); }
 	}
 	return kt::null_result;
 }
@@ -169,24 +199,49 @@ Reader::Result<std::stringstream> FileReader::sstream(io::Path const& id) const
 			buf << file.rdbuf();
 			return buf;
 		}
+		invalidate(id);
+		if (auto fresh = findPrefixed(id); fresh && !(*fresh == *path)) { return sstream(id); }
 	}
 	return kt::null_result;
 }
 
 Reader::Result<io::Path> FileReader::findPrefixed(io::Path const& id) const {
-	auto const paths = finalPaths(id);
-	for (auto const& path : paths) {
-		if (io::is_regular_file(path)) { return io::Path(path); }
+	if (id.has_root_directory()) {
+		if (io::is_regular_file(id)) { return io::Path(id); }
+		return kt::null_result;
+	}
+	auto const str = id.generic_string();
+	Hash const hash = str;
+	{
+		kt::tlock lock(m_cache.entries);
+		if (auto it = lock.get().find(hash); it != lock.get().end() && it->second.id == str) {
+			m_cache.statsSaved.fetch_add(it->second.stats);
+			return io::Path(it->second.path);
+		}
+	}
+	u64 stats = 0;
+	for (auto const& prefix : m_dirs) {
+		auto path = prefix / id;
+		++stats;
+		if (io::is_regular_file(path)) {
+			kt::unique_tlock<std::unordered_map<Hash, Cache::Entry>> lock(m_cache.entries);
+			lock->insert_or_assign(hash, Cache::Entry{str, path, stats});
+			return path;
+		}
 	}
 	return kt::null_result;
 }
 
-std::vector<io::Path> FileReader::finalPaths(io::Path const& id) const {
-	if (id.has_root_directory()) { return {id}; }
-	std::vector<io::Path> ret;
-	ret.reserve(m_dirs.size());
-	for (auto const& prefix : m_dirs) { ret.push_back(prefix / id); }
-	return ret;
+void FileReader::invalidate(io::Path const& id) const {
+	kt::unique_tlock<std::unordered_map<Hash, Cache::Entry>> lock(m_cache.entries);
+	lock->erase(id.generic_string());
+}
+
+FileReader::Cache& FileReader::Cache::operator=(Cache const&) noexcept {
+	// resolutions depend on the (reassigned) mount points
+	kt::unique_tlock<std::unordered_map<Hash, Entry>> lock(entries);
+	lock->clear();
+	return *this;
 }
 
 io::Path FileReader::fullPath(io::Path const& id) const {
@@ -198,63 +253,97 @@ ZIPReader::ZIPReader() { m_medium = "ZIP"; }
 
 bool ZIPReader::mount(io::Path path) {
 	impl::initPhysfs();
-	auto pathStr = path.generic_string();
-	FileReader file;
-	if (std::find(m_zips.begin(), m_zips.end(), path) == m_zips.end()) {
-		auto const bytes = file.bytes(path);
-		if (!bytes) {
-			logE("[{}] [{}] not found on Filesystem!", utils::tName<ZIPReader>(), pathStr);
-			return false;
-		}
-		int const result = PHYSFS_mountMemory(bytes->data(), bytes->size(), nullptr, path.string().data(), nullptr, 0);
-		if (result == 0) {
-			logE("[{}] [{}] failed to decompress archive!", utils::tName<ZIPReader>(), pathStr);
-			return false;
-		}
-		PHYSFS_mount(path.string().data(), nullptr, 0);
-		logD("[{}] [{}] archive mounted", utils::tName<ZIPReader>(), pathStr);
-		m_zips.push_back(std::move(path));
-		return true;
+	auto const pathStr = path.generic_string();
+	if (std::find(m_zips.begin(), m_zips.end(), path) != m_zips.end()) {
+		logW("[{}] [{}] archive already mounted", utils::tName<ZIPReader>(), pathStr);
+		return false;
 	}
-	logW("[{}] [{}] archive already mounted", utils::tName<FileReader>(), pathStr);
-	return false;
+	if (!io::is_regular_file(path)) {
+		logE("[{}] [{}] not found on Filesystem!", utils::tName<ZIPReader>(), pathStr);
+		return false;
+	}
+	// PhysFS only reads the central directory here; file contents are streamed from disk on demand
+	auto const archive = io::absolute(path).string();
+	if (PHYSFS_mount(archive.data(), nullptr, 0) == 0) {
+		logE("[{}] [{}] failed to mount archive!", utils::tName<ZIPReader>(), pathStr);
+		return false;
+	}
+	std::size_t const count = index(archive);
+	logD("[{}] [{}] archive mounted [{} files]", utils::tName<ZIPReader>(), pathStr, count);
+	m_zips.push_back(std::move(path));
+	return true;
 }
 
 Reader::Result<io::Path> ZIPReader::findPrefixed(io::Path const& id) const {
-	if (PHYSFS_exists(id.generic_string().data()) != 0) { return io::Path(id); }
+	if (entry(id)) { return io::Path(id); }
 	return kt::null_result;
 }
 
 Reader::Result<std::stringstream> ZIPReader::sstream(io::Path const& id) const {
-	if (checkPresence(id)) {
-		auto pFile = PHYSFS_openRead(id.generic_string().data());
-		if (pFile) {
-			std::stringstream buf;
-			auto length = PHYSFS_fileLength(pFile);
-			std::string charBuf((std::size_t)length, 0);
-			PHYSFS_readBytes(pFile, charBuf.data(), (PHYSFS_uint64)length);
-			buf << charBuf;
-			return buf;
-		}
-		PHYSFS_close(pFile);
+	if (auto const e = entry(id)) {
+		std::string charBuf(e->size, 0);
+		if (readZipped(e->id, charBuf.data(), charBuf.size())) { return std::stringstream(std::move(charBuf)); }
+	} else {
+		logE("[{}] [{}] not found in {}!", utils::tName(this), id.generic_string(), m_medium);
 	}
 	return kt::null_result;
 }
 
 Reader::Result<bytearray> ZIPReader::bytes(io::Path const& id) const {
-	if (checkPresence(id)) {
-		auto pFile = PHYSFS_openRead(id.generic_string().data());
-		if (pFile) {
-			auto length = PHYSFS_fileLength(pFile);
-			auto buf = bytearray((std::size_t)length);
-			PHYSFS_readBytes(pFile, buf.data(), (PHYSFS_uint64)length);
-			return buf;
-		}
-		PHYSFS_close(pFile);
+	if (auto const e = entry(id)) {
+		auto buf = bytearray(e->size);
+		if (readZipped(e->id, buf.data(), buf.size())) { return buf; }
+	} else {
+		logE("[{}] [{}] not found in {}!", utils::tName(this), id.generic_string(), m_medium);
 	}
 	return kt::null_result;
 }
 
+std::optional<ZIPReader::Entry> ZIPReader::entry(io::Path const& id) const {
+	auto const str = id.generic_string();
+	kt::tlock lock(m_index);
+	// Hash collisions are resolved by comparing the stored id
+	if (auto const pEntry = lock.get().find(Hash(str)); pEntry && pEntry->id == str) { return *pEntry; }
+	return std::nullopt;
+}
+
+std::size_t ZIPReader::index(std::string const& archive) {
+	struct Walk {
+		std::string const& archive;
+		std::vector<std::string> dirs;
+		std::vector<Entry> files;
+	};
+	static constexpr auto onEntry = [](void* pData, char const* dir, char const* name) -> PHYSFS_EnumerateCallbackResult {
+		auto& walk = *static_cast<Walk*>(pData);
+		std::string path = *dir ? std::string(dir) + "/" + name : std::string(name);
+		// skip entries shadowed by / belonging to other mounted archives
+		if (auto const real = PHYSFS_getRealDir(path.data()); !real || walk.archive != real) { return PHYSFS_ENUM_OK; }
+		PHYSFS_Stat stat;
+		if (PHYSFS_stat(path.data(), &stat) != 0) {
+			if (stat.filetype == PHYSFS_FILETYPE_DIRECTORY) {
+				walk.dirs.push_back(std::move(path));
+			} else if (stat.filetype == PHYSFS_FILETYPE_REGULAR) {
+				walk.files.push_back({std::move(path), (std::size_t)stat.filesize});
+			}
+		}
+		return PHYSFS_ENUM_OK;
+	};
+	Walk walk{archive, {""}, {}};
+	while (!walk.dirs.empty()) {
+		auto const dir = std::move(walk.dirs.back());
+		walk.dirs.pop_back();
+		PHYSFS_enumerate(dir.data(), onEntry, &walk);
+	}
+	kt::unique_tlock<Index> lock(m_index);
+	lock->reserve(lock->size() + walk.files.size());
+	for (auto& file : walk.files) {
+		Hash const hash = file.id;
+		// later mounts take precedence (archives are prepended to the PhysFS search path)
+		if (auto [pEntry, bNew] = lock->emplace(hash, file); !bNew) { *pEntry = std::move(file); }
+	}
+	return walk.files.size();
+}
+
 AAssetReader::AAssetReader(ErasedPtr androidApp) : m_androidApp(androidApp) {
 #if defined(LEVK_OS_ANDROID)
 	ensure(unpack(m_androidApp), "Invalid android_app pointer");
@@ -291,8 +380,52 @@ Reader::Result<io::Path> AAssetReader::findPrefixed([[maybe_unused]] io::Path co
 #endif
 }
 
+impl::MappedFile::~MappedFile() {
+#if defined(LEVK_OS_WINDOWS)
+	if (pData) { UnmapViewOfFile(pData); }
+	if (mapping) { CloseHandle(mapping); }
+	if (file) { CloseHandle(file); }
+#elif defined(LEVK_OS_LINUX)
+	if (pData) { munmap(const_cast<void*>(pData), size); }
+#endif
+}
+
+bool impl::MappedFile::map([[maybe_unused]] io::Path const& path, [[maybe_unused]] bool bSequential) {
+#if defined(LEVK_OS_WINDOWS)
+	DWORD const flags = bSequential ? FILE_FLAG_SEQUENTIAL_SCAN : FILE_FLAG_RANDOM_ACCESS;
+	HANDLE const handle = CreateFileA(path.string().data(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, flags, nullptr);
+	if (handle == INVALID_HANDLE_VALUE) { return false; }
+	file = handle;
+	LARGE_INTEGER length;
+	if (!GetFileSizeEx(handle, &length) || length.QuadPart <= 0) { return false; }
+	size = (std::size_t)length.QuadPart;
+	if (!(mapping = CreateFileMappingA(handle, nullptr, PAGE_READONLY, 0, 0, nullptr))) { return false; }
+	pData = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+	return pData != nullptr;
+#elif defined(LEVK_OS_LINUX)
+	int const fd = ::open(path.string().data(), O_RDONLY | O_CLOEXEC);
+	if (fd < 0) { return false; }
+	struct stat st;
+	if (::fstat(fd, &st) != 0 || st.st_size <= 0) {
+		::close(fd);
+		return false;
+	}
+	void* const pMap = ::mmap(nullptr, (std::size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+	// the mapping holds its own reference to the file
+	::close(fd);
+	if (pMap == MAP_FAILED) { return false; }
+	::madvise(pMap, (std::size_t)st.st_size, bSequential ? MADV_SEQUENTIAL : MADV_RANDOM);
+	pData = pMap;
+	size = (std::size_t)st.st_size;
+	return true;
+#else
+	return false;
+#endif
+}
+
 void impl::initPhysfs() {
-	if (!g_physfsHandle) { g_physfsHandle = PhysfsHandle(); }
+	// emplace: a moved-from temporary would deinitialise PhysFS on destruction
+	if (!g_physfsHandle) { g_physfsHandle.emplace(); }
 }
 
 void impl::deinitPhysfs() { g_physfsHandle.reset(); }
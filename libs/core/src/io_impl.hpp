@@ -1,7 +1,29 @@
 #pragma once
 #include <memory>
+#include <core/io/path.hpp>
 
 namespace le::io::impl {
 void initPhysfs();
 void deinitPhysfs();
+
+///
+/// \brief Read-only mapping of an entire file; unmapped on destruction
+///
+/// Only for immutable archives (PakReader): a loose file could be truncated while mapped (SIGBUS on access),
+/// and would be share-locked against writers (editors) on Windows.
+///
+struct MappedFile {
+	void const* pData = nullptr;
+	std::size_t size = 0;
+	// Windows file / mapping HANDLEs
+	void* file = nullptr;
+	void* mapping = nullptr;
+
+	MappedFile() = default;
+	MappedFile(MappedFile&&) = delete;
+	MappedFile& operator=(MappedFile&&) = delete;
+	~MappedFile();
+
+	bool map(io::Path const& path, bool bSequential = true);
+};
 } // namespace le::io::impl
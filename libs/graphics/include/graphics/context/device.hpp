@@ -113,7 +113,8 @@ struct Device::Deleter {
 
 constexpr vk::BufferUsageFlagBits Device::bufferUsage(vk::DescriptorType type) noexcept {
 	switch (type) {
-	case vk::DescriptorType::eStorageBuffer: return vk::BufferUsageFlagBits::eStorageBuffer;
+	case vk::DescriptorType::eStorageBuffer:
+	case vk::DescriptorType::eStorageBufferDynamic: return vk::BufferUsageFlagBits::eStorageBuffer;
 	default: return vk::BufferUsageFlagBits::eUniformBuffer;
 	}
 }
@@ -0,0 +1,82 @@
+#pragma once
+#include <deque>
+#include <memory>
+#include <optional>
+#include <vector>
+#include <core/not_null.hpp>
+#include <core/time.hpp>
+#include <graphics/resources.hpp>
+
+namespace le::graphics {
+constexpr vk::DeviceSize operator""_MB(unsigned long long size) { return size << 20; }
+
+///
+/// \brief Persistently mapped, host visible staging memory: large blocks sub-allocated as rings
+///
+/// Allocations are released individually (when their transfer batch completes, in any order); a block's free space
+/// advances past its oldest allocation once released. Requests larger than a block get a dedicated buffer (freed on release).
+/// Total capacity is capped: allocate() fails when full, callers should wait for releases (back-pressure).
+/// Not thread safe: externally synchronised (by Transfer).
+///
+class StagingRing {
+  public:
+	static constexpr vk::DeviceSize alignment = 256;
+
+	struct CreateInfo {
+		vk::DeviceSize blockSize = 16_MB;
+		vk::DeviceSize cap = 64_MB;
+		// empty blocks (other than the first) are freed after being idle this long
+		Time_ms trimAfter = 2s;
+	};
+
+	struct Stats {
+		u64 used = 0;
+		u64 peak = 0;
+		u64 capacity = 0;
+		u64 stalls = 0;
+		Time_us stalled = {};
+	};
+
+	struct Block;
+	struct Alloc {
+		Block* block = {};
+		vk::Buffer buffer;
+		void* mapped = {};
+		vk::DeviceSize offset = 0;
+		vk::DeviceSize size = 0;
+
+		bool write(void const* pData, vk::DeviceSize size, vk::DeviceSize offset = 0) const;
+		explicit operator bool() const noexcept { return block != nullptr; }
+	};
+
+	StagingRing(not_null<Memory*> memory, CreateInfo const& info);
+	StagingRing(StagingRing&&) noexcept;
+	StagingRing& operator=(StagingRing&&) noexcept;
+	~StagingRing();
+
+	///
+	/// \brief Reserve size bytes; returns nullopt if there isn't enough free capacity (wait for releases and retry)
+	///
+	/// Over capacity requests are served (dedicated) if nothing is in flight, to guarantee progress.
+	///
+	std::optional<Alloc> allocate(vk::DeviceSize size);
+	void release(Alloc const& alloc);
+	///
+	/// \brief Free idle blocks (beyond the first)
+	///
+	void trim();
+	void stall(Time_us duration) noexcept;
+
+	bool busy() const noexcept { return m_stats.used > 0; }
+	Stats const& stats() const noexcept { return m_stats; }
+
+  private:
+	Block& makeBlock(vk::DeviceSize size, bool bDedicated);
+	std::optional<Alloc> allocate(Block& out_block, vk::DeviceSize size);
+
+	std::vector<std::unique_ptr<Block>> m_blocks;
+	CreateInfo m_info;
+	Stats m_stats;
+	not_null<Memory*> m_memory;
+};
+} // namespace le::graphics
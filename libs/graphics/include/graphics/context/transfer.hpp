@@ -1,41 +1,80 @@
 #pragma once
+#include <condition_variable>
 #include <future>
-#include <list>
 #include <memory>
 #include <vector>
 #include <core/not_null.hpp>
 #include <core/span.hpp>
 #include <core/time.hpp>
-#include <graphics/resources.hpp>
+#include <graphics/context/staging_ring.hpp>
 #include <kt/async_queue/async_queue.hpp>
 #include <kt/kthread/kthread.hpp>
 
 namespace le::graphics {
-constexpr vk::DeviceSize operator""_MB(unsigned long long size) { return size << 20; }
-
 class Transfer final {
   public:
 	using notify_t = void;
 	using Promise = std::shared_ptr<std::promise<notify_t>>;
 	using Future = std::future<notify_t>;
 
-	struct MemRange final {
-		vk::DeviceSize size = 2;
-		std::size_t count = 1;
+	struct CreateInfo;
+
+	///
+	/// \brief How submitted batches are completed (and pending copies submitted)
+	///
+	/// ePoll: a thread calls update() every autoPollRate (if set)
+	/// eWait: copies are submitted by addStage() / record() as they're added; a thread blocks on the oldest batch's fence to retire it,
+	/// sleeping while nothing is in flight
+	///
+	enum class Completion { ePoll, eWait };
+
+	struct Stats {
+		StagingRing::Stats staging;
+		u64 recorded = 0;  // copies recorded
+		u64 submitted = 0; // command buffers submitted
+		u64 batches = 0;   // queue submits
 	};
-	static constexpr std::array<MemRange, 1> defaultReserve = {{{8_MB, 4}}};
 
-	struct CreateInfo;
+	struct BufferCopy {
+		vk::Buffer src;
+		vk::Buffer dst;
+		vk::BufferCopy region;
+	};
+
+	struct ImageCopy {
+		vk::Buffer src;
+		vk::Image dst;
+		std::vector<vk::BufferImageCopy> regions;
+		Memory::ImgMeta meta;
+	};
+
+	///
+	/// \brief Copies recorded together into one command buffer
+	///
+	/// Image layout transitions are merged into one pipeline barrier before all the copies and one after them.
+	///
+	struct Recorder {
+		std::vector<BufferCopy> buffers;
+		std::vector<ImageCopy> images;
+
+		void record(vk::CommandBuffer cb) const;
+		std::size_t size() const noexcept { return buffers.size() + images.size(); }
+		bool empty() const noexcept { return size() == 0; }
+	};
 
 	struct Stage final {
-		std::optional<Buffer> buffer;
+		StagingRing::Alloc staging;
 		vk::CommandBuffer command;
+		std::size_t worker = 0;
 	};
 
+	struct Worker;
+
 	struct Batch final {
 		using Entry = std::pair<Stage, Promise>;
 
 		std::vector<Entry> entries;
+		vk::CommandBuffer coalesced;
 		vk::Fence done;
 		u8 framePad = 1;
 	};
@@ -45,45 +84,90 @@ class Transfer final {
 
 	static Promise makePromise() noexcept;
 
+	///
+	/// \brief Submit pending stages and retire completed batches (Completion::eWait: only reports, copies are submitted when added and
+	/// retired by the completion thread)
+	///
 	std::size_t update();
-
-	Stage newStage(vk::DeviceSize bufferSize);
+	///
+	/// \brief Block until all stages have completed
+	///
+	void waitIdle();
+
+	///
+	/// \brief Reserve (mapped) staging memory, to be written to directly; blocks while the staging ring is full (until batches complete)
+	///
+	StagingRing::Alloc reserve(vk::DeviceSize size);
+	///
+	/// \brief Obtain a command buffer (from the calling worker's pool) for (optional) reserved staging memory
+	///
+	Stage newStage(StagingRing::Alloc staging = {});
 	void addStage(Stage&& stage, Promise&& promise);
+	///
+	/// \brief Record copies (from reserved staging memory); promise is fulfilled when they complete
+	///
+	/// Coalescing: copies are collected until the next update() and recorded into one command buffer (Completion::eWait: each call's
+	/// copies are recorded into one command buffer and submitted immediately).
+	/// Otherwise: copies are recorded by a worker into their own command buffer.
+	///
+	void record(Recorder&& copies, StagingRing::Alloc staging, Promise&& promise);
 
 	bool polling() const noexcept { return m_sync.poll.active(); }
+	bool coalescing() const noexcept { return m_coalesce; }
+	Stats stats() const;
 
   private:
+	std::size_t updateImpl();
+	void retire();
+	void submit();
+	void complete(kt::kthread::stop_t const& stop);
+	bool idle() const noexcept { return m_batches.submitted.empty() && m_batches.active.entries.empty(); }
+	bool completing() const noexcept { return m_completion == Completion::eWait && polling(); }
 	void scavenge(Stage&& stage, vk::Fence fence);
 	vk::Fence nextFence();
-	std::optional<Buffer> nextBuffer(vk::DeviceSize size);
-	vk::CommandBuffer nextCommand();
+	StagingRing::Alloc nextStaging(std::unique_lock<std::mutex>& lock, vk::DeviceSize size);
+	vk::CommandBuffer nextCommand(Worker& out_worker);
+	vk::CommandBuffer nextCoalesced();
+	Worker& worker() const;
 	void stopPolling();
 	void stopTransfer();
 
 	struct {
-		vk::CommandPool pool;
+		vk::CommandPool pool; // coalesced commands: guarded by m_sync.mutex
 		std::vector<vk::CommandBuffer> commands;
 		std::vector<vk::Fence> fences;
-		std::list<Buffer> buffers;
 	} m_data;
 	struct {
-		kt::kthread staging;
 		kt::kthread poll;
-		std::mutex mutex;
+		mutable std::mutex mutex;
+		std::condition_variable retired;
+		std::condition_variable added;
 	} m_sync;
 	struct {
+		Recorder pending;
 		Batch active;
 		std::vector<Batch> submitted;
 	} m_batches;
+	Stats m_stats;
+	StagingRing m_ring;
+	std::vector<std::unique_ptr<Worker>> m_workers;
 	kt::async_queue<std::function<void()>> m_queue;
 	not_null<Memory*> m_memory;
+	Completion m_completion;
+	bool m_coalesce;
 
 	friend class VRAM;
 };
 
 struct Transfer::CreateInfo {
-	Span<MemRange const> reserve = defaultReserve;
+	StagingRing::CreateInfo staging;
+	Completion completion = Completion::eWait;
+	// Completion::ePoll only
 	std::optional<Time_ms> autoPollRate = 3ms;
+	// threads draining the queue (uncoalesced copies), each recording into its own command pool; all their stages are submitted in one batch
+	u8 workers = 1;
+	// record copies added between submits into one command buffer (with merged barriers)
+	bool coalesce = true;
 };
 
 // impl
@@ -21,7 +21,17 @@ class VRAM final : public Memory {
 	Buffer makeBO(T const& t, vk::BufferUsageFlags usage);
 
 	[[nodiscard]] Future copy(Buffer const& src, Buffer& out_dst, vk::DeviceSize size = 0);
+	///
+	/// \brief Copy pData into staging memory (on the calling thread; no intermediate copies) and upload it to out_deviceBuffer
+	///
+	/// pData need not outlive the call; blocks while the staging ring is full
+	///
 	[[nodiscard]] Future stage(Buffer& out_deviceBuffer, void const* pData, vk::DeviceSize size = 0);
+	///
+	/// \brief Copy bitmaps into staging memory (on the calling thread; no intermediate copies) and upload them to out_dst's layers
+	///
+	/// bitmaps need not outlive the call; blocks while the staging ring is full
+	///
 	[[nodiscard]] Future copy(Span<BMPview const> bitmaps, Image& out_dst, LayoutPair layouts);
 	[[nodiscard]] Future blit(Image const& src, Image& out_dst, LayoutPair layouts, TPair<vk::ImageAspectFlags> aspects,
 							  vk::Filter filter = vk::Filter::eLinear);
@@ -31,6 +41,7 @@ class VRAM final : public Memory {
 	void waitIdle();
 
 	bool update(bool force = false);
+	Transfer::Stats transferStats() const { return m_transfer.stats(); }
 
 	not_null<Device*> m_device;
 
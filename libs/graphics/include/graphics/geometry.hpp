@@ -1,8 +1,11 @@
 #pragma once
+#include <algorithm>
 #include <vector>
 #include <core/colour.hpp>
 #include <core/span.hpp>
 #include <core/std_types.hpp>
+#include <glm/common.hpp>
+#include <glm/geometric.hpp>
 #include <graphics/basis.hpp>
 
 namespace le::graphics {
@@ -35,6 +38,30 @@ struct Vert<VertType::ePosColNormUV> {
 	glm::vec2 texCoord = {};
 };
 
+///
+/// \brief Axis aligned bounding box and bounding sphere of a set of (local space) points
+///
+struct Bounds {
+	struct AABB {
+		glm::vec3 min = glm::vec3(0.0f);
+		glm::vec3 max = glm::vec3(0.0f);
+	};
+	struct Sphere {
+		glm::vec3 centre = glm::vec3(0.0f);
+		f32 radius = 0.0f;
+	};
+
+	AABB aabb;
+	Sphere sphere;
+	bool valid = false;
+
+	///
+	/// \brief Compute bounds over ts, using position(t) to obtain each point
+	///
+	template <typename T, typename F>
+	static Bounds make(Span<T const> ts, F position) noexcept;
+};
+
 template <VertType V>
 struct Geom {
 	std::vector<Vert<V>> vertices;
@@ -45,6 +72,7 @@ struct Geom {
 	void addIndices(Span<u32 const> newIndices);
 
 	std::vector<glm::vec3> positions() const;
+	Bounds bounds() const noexcept;
 };
 
 struct Albedo final {
@@ -59,8 +87,41 @@ Geometry makeCircle(f32 diameter = 1.0f, u16 points = 16);
 Geometry makeCone(f32 diam = 1.0f, f32 height = 1.0f, u16 points = 16);
 Geometry makeCubedSphere(f32 diameter, u8 quadsPerSide);
 
+///
+/// \brief Reorder triangles in-place for post-transform vertex cache locality (Forsyth)
+/// \param indices triangle list indices
+/// \param vertexCount number of vertices referenced by indices
+///
+void optimiseVertexCache(Span<u32> indices, u32 vertexCount);
+///
+/// \brief Average cache miss ratio (misses per triangle) of indices for a FIFO cache of cacheSize vertices
+///
+f32 vertexCacheACMR(Span<u32 const> indices, u32 vertexCount, u32 cacheSize = 32);
+
 // impl
 
+template <typename T, typename F>
+Bounds Bounds::make(Span<T const> ts, F position) noexcept {
+	Bounds ret;
+	if (ts.empty()) { return ret; }
+	ret.aabb.min = ret.aabb.max = position(ts.front());
+	for (T const& t : ts) {
+		glm::vec3 const p = position(t);
+		ret.aabb.min = glm::min(ret.aabb.min, p);
+		ret.aabb.max = glm::max(ret.aabb.max, p);
+	}
+	// sphere centred on the AABB: tighter than its half diagonal
+	ret.sphere.centre = 0.5f * (ret.aabb.min + ret.aabb.max);
+	f32 r2 = 0.0f;
+	for (T const& t : ts) {
+		glm::vec3 const d = position(t) - ret.sphere.centre;
+		r2 = std::max(r2, glm::dot(d, d));
+	}
+	ret.sphere.radius = std::sqrt(r2);
+	ret.valid = true;
+	return ret;
+}
+
 template <VertType V>
 void Geom<V>::reserve(u32 vertCount, u32 indexCount) {
 	vertices.reserve(vertCount);
@@ -85,4 +146,9 @@ std::vector<glm::vec3> Geom<V>::positions() const {
 	for (auto const& v : vertices) { ret.push_back(v.position); }
 	return ret;
 }
+
+template <VertType V>
+Bounds Geom<V>::bounds() const noexcept {
+	return Bounds::make(Span<Vert<V> const>(vertices), [](Vert<V> const& v) { return v.position; });
+}
 } // namespace le::graphics
@@ -29,6 +29,7 @@ class Mesh {
 	bool draw(CommandBuffer cb, u32 instances = 1, u32 first = 0) const;
 
 	bool valid() const noexcept;
+	u64 bytes() const noexcept;
 	bool busy() const;
 	bool ready() const;
 	void wait() const;
@@ -38,6 +39,7 @@ class Mesh {
 	Type type() const noexcept;
 
 	bool hasIndices() const noexcept;
+	Bounds const& bounds() const noexcept;
 
 	not_null<VRAM*> m_vram;
 
@@ -53,6 +55,7 @@ class Mesh {
 
 	Storage m_vbo;
 	Storage m_ibo;
+	Bounds m_bounds;
 	u32 m_triCount = 0;
 
 	Type m_type;
@@ -69,6 +72,13 @@ bool Mesh::construct(Span<T const> vertices, Span<u32 const> indices) {
 		m_vbo.count = (u32)vertices.size();
 		m_ibo.count = (u32)indices.size();
 		m_triCount = indices.empty() ? u32(vertices.size() / 3) : u32(indices.size() / 3);
+		if constexpr (std::is_same_v<T, glm::vec3>) {
+			m_bounds = Bounds::make(vertices, [](glm::vec3 const& v) { return v; });
+		} else if constexpr (requires(T const& t) { glm::vec3(t.position); }) {
+			m_bounds = Bounds::make(vertices, [](T const& t) { return glm::vec3(t.position); });
+		} else {
+			m_bounds = {};
+		}
 		return true;
 	}
 	return false;
@@ -82,5 +92,6 @@ bool Mesh::construct(Geom<V> const& geom) {
 inline Mesh::Data Mesh::vbo() const noexcept { return {*m_vbo.buffer, m_vbo.count}; }
 inline Mesh::Data Mesh::ibo() const noexcept { return {*m_ibo.buffer, m_ibo.count}; }
 inline Mesh::Type Mesh::type() const noexcept { return m_type; }
+inline Bounds const& Mesh::bounds() const noexcept { return m_bounds; }
 inline bool Mesh::hasIndices() const noexcept { return m_ibo.count > 0 && m_ibo.buffer && m_ibo.buffer->buffer() != vk::Buffer(); }
 } // namespace le::graphics
@@ -12,6 +12,7 @@
 #include <graphics/render/pipeline.hpp>
 #include <graphics/render/renderer.hpp>
 #include <graphics/render/rgba.hpp>
+#include <graphics/render/uniform_arena.hpp>
 #include <graphics/screen_rect.hpp>
 
 namespace le::graphics {
@@ -58,6 +59,8 @@ class RenderContext : NoCopy {
 
 	ARenderer& renderer() const noexcept { return *m_storage.renderer; }
 	CommandPool const& commandPool() const noexcept { return m_pool; }
+	UniformArena& uniformArena() noexcept { return m_arena; }
+	UniformArena const& uniformArena() const noexcept { return m_arena; }
 
   private:
 	template <typename... T>
@@ -75,6 +78,7 @@ class RenderContext : NoCopy {
 
 	Storage m_storage;
 	CommandPool m_pool;
+	UniformArena m_arena;
 	not_null<Swapchain*> m_swapchain;
 	not_null<Device*> m_device;
 };
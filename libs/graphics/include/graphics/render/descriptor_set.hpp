@@ -1,9 +1,12 @@
 #pragma once
+#include <atomic>
+#include <optional>
 #include <unordered_map>
 #include <core/not_null.hpp>
 #include <core/ref.hpp>
 #include <core/span.hpp>
 #include <graphics/render/buffering.hpp>
+#include <graphics/render/uniform_arena.hpp>
 #include <graphics/resources.hpp>
 #include <graphics/texture.hpp>
 #include <graphics/utils/deferred.hpp>
@@ -31,6 +34,7 @@ class DescriptorSet {
 	};
 	struct BO {
 		vk::Buffer buffer;
+		std::size_t offset = 0;
 		std::size_t size = 0;
 		std::size_t writes = 0;
 	};
@@ -43,6 +47,10 @@ class DescriptorSet {
 	};
 	struct CreateInfo;
 
+	inline static auto s_writes = std::atomic<u32>(0);
+
+	static constexpr bool dynamic(vk::DescriptorType type) noexcept;
+
 	DescriptorSet(not_null<Device*> device, CreateInfo const& info);
 	DescriptorSet(DescriptorSet&&) = default;
 	DescriptorSet& operator=(DescriptorSet&&) = default;
@@ -58,6 +66,7 @@ class DescriptorSet {
 	template <typename C>
 	bool update(u32 binding, C const& textures);
 	void update(u32 binding, Buffer const& buffer, vk::DescriptorType type);
+	void update(u32 binding, UniformArena::Slice const& slice, vk::DescriptorType type);
 	bool update(u32 binding, Texture const& texture);
 
 	u32 setNumber() const noexcept;
@@ -119,7 +128,34 @@ class DescriptorPool {
 	bool unassigned() const noexcept;
 	void clear() noexcept;
 
+	///
+	/// \brief Check whether all active bindings are dynamic buffers (one set serves many draws via offsets)
+	///
+	bool dynamic() const noexcept { return !m_dynamic.binds.empty(); }
+	bool updateDynamic(u32 bind, UniformArena::Slice const& slice, std::size_t slot);
+	///
+	/// \brief Obtain the set and offsets for slot; nullopt if any of its bindings was not written this frame
+	///
+	std::optional<std::pair<DescriptorSet const&, Span<u32 const>>> dynamicSet(std::size_t slot) const;
+
   private:
+	struct Slot {
+		std::vector<UniformArena::Slice> slices;
+		std::vector<u32> offsets;
+		std::size_t set = 0;
+	};
+	struct Dynamic {
+		std::vector<u32> binds;
+		std::vector<Slot> slots;
+		std::vector<std::vector<UniformArena::Slice>> claimed;
+		std::size_t head = 0;
+	};
+
+	Slot& slot(std::size_t idx);
+	bool claim(std::size_t set, std::size_t bindIdx, UniformArena::Slice const& slice);
+	void write(Slot const& slot, std::size_t bindIdx);
+	void resetDynamic() noexcept;
+
 	struct Storage {
 		std::string_view name;
 		vk::DescriptorSetLayout layout;
@@ -128,6 +164,7 @@ class DescriptorPool {
 		Buffering buffering;
 		u32 setNumber = 0;
 	} m_storage;
+	Dynamic m_dynamic;
 	not_null<Device*> m_device;
 };
 
@@ -147,6 +184,7 @@ class ShaderInput {
 	bool update(Span<Texture const> textures, u32 set, u32 bind, std::size_t idx = 0);
 	bool update(Span<Buffer const> buffers, u32 set, u32 bind, std::size_t idx = 0, vk::DescriptorType type = vk::DescriptorType::eUniformBuffer);
 	bool update(ShaderBuffer const& buffer, u32 set, u32 bind, std::size_t idx = 0);
+	bool update(UniformArena::Slice const& slice, u32 set, u32 bind, std::size_t idx = 0, vk::DescriptorType type = vk::DescriptorType::eUniformBuffer);
 
 	DescriptorPool& operator[](u32 set);
 	DescriptorPool const& operator[](u32 set) const;
@@ -161,6 +199,10 @@ class ShaderInput {
 
 // impl
 
+constexpr bool DescriptorSet::dynamic(vk::DescriptorType type) noexcept {
+	return type == vk::DescriptorType::eUniformBufferDynamic || type == vk::DescriptorType::eStorageBufferDynamic;
+}
+
 inline u32 DescriptorSet::setNumber() const noexcept { return m_storage.setNumber; }
 
 template <typename T>
@@ -183,7 +225,7 @@ void DescriptorSet::update(u32 binding, vk::DescriptorType type, Span<T const> w
 template <typename C>
 void DescriptorSet::update(u32 binding, C const& buffers, vk::DescriptorType type) {
 	Bufs bufs;
-	for (Buffer const& buf : buffers) { bufs.buffers.push_back({buf.buffer(), (std::size_t)buf.writeSize(), buf.writeCount()}); }
+	for (Buffer const& buf : buffers) { bufs.buffers.push_back({buf.buffer(), 0, (std::size_t)buf.writeSize(), buf.writeCount()}); }
 	bufs.type = type;
 	updateBufs(binding, std::move(bufs));
 }
@@ -195,5 +237,8 @@ bool DescriptorSet::update(u32 binding, C const& textures) {
 	return updateImgs(binding, std::move(imgs));
 }
 inline void DescriptorSet::update(u32 binding, Buffer const& buffer, vk::DescriptorType type) { update(binding, Span<Ref<Buffer const> const>(buffer), type); }
+inline void DescriptorSet::update(u32 binding, UniformArena::Slice const& slice, vk::DescriptorType type) {
+	updateBufs(binding, Bufs{{{slice.buffer, (std::size_t)slice.offset, (std::size_t)slice.size}}, type});
+}
 inline bool DescriptorSet::update(u32 binding, Texture const& texture) { return update(binding, Span<Ref<Texture const> const>(texture)); }
 } // namespace le::graphics
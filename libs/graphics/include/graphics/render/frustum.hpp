@@ -0,0 +1,61 @@
+#pragma once
+#include <array>
+#include <cmath>
+#include <core/std_types.hpp>
+#include <glm/mat4x4.hpp>
+#include <glm/vec3.hpp>
+
+namespace le::graphics {
+///
+/// \brief View frustum as six inward-facing planes (dot(n, p) + d >= 0 inside)
+///
+/// Planes are stored as structure-of-arrays so that tests vectorise across planes.
+///
+struct Frustum {
+	static constexpr std::size_t count = 6;
+
+	std::array<f32, count> nx{};
+	std::array<f32, count> ny{};
+	std::array<f32, count> nz{};
+	std::array<f32, count> d{};
+
+	///
+	/// \brief Extract planes from a (zero-to-one depth) view-projection matrix
+	///
+	static Frustum make(glm::mat4 const& viewProj) noexcept;
+
+	///
+	/// \brief Check whether a sphere intersects / is contained in the frustum
+	///
+	bool test(glm::vec3 const& centre, f32 radius) const noexcept;
+};
+
+// impl
+
+inline Frustum Frustum::make(glm::mat4 const& m) noexcept {
+	auto const row = [&m](int r) { return glm::vec4(m[0][r], m[1][r], m[2][r], m[3][r]); };
+	glm::vec4 const r0 = row(0), r1 = row(1), r2 = row(2), r3 = row(3);
+	std::array<glm::vec4, count> const planes = {r3 + r0, r3 - r0, r3 + r1, r3 - r1, r2, r3 - r2};
+	Frustum ret;
+	for (std::size_t idx = 0; idx < count; ++idx) {
+		glm::vec4 const& p = planes[idx];
+		f32 const len = std::sqrt(p.x * p.x + p.y * p.y + p.z * p.z);
+		f32 const inv = len > 0.0f ? 1.0f / len : 0.0f;
+		ret.nx[idx] = p.x * inv;
+		ret.ny[idx] = p.y * inv;
+		ret.nz[idx] = p.z * inv;
+		ret.d[idx] = p.w * inv;
+	}
+	return ret;
+}
+
+inline bool Frustum::test(glm::vec3 const& centre, f32 radius) const noexcept {
+	// branchless over planes
+	f32 dist = radius;
+	for (std::size_t idx = 0; idx < count; ++idx) {
+		f32 const sd = nx[idx] * centre.x + ny[idx] * centre.y + nz[idx] * centre.z + d[idx] + radius;
+		dist = sd < dist ? sd : dist;
+	}
+	return dist >= 0.0f;
+}
+} // namespace le::graphics
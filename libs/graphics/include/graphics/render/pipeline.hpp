@@ -35,6 +35,8 @@ class Pipeline final {
 		};
 
 		Fixed fixedState;
+		// Sets whose buffer bindings use dynamic offsets (one descriptor set per frame serves all draws)
+		std::unordered_set<u32> dynamicSets;
 		vk::RenderPass renderPass;
 		vk::PipelineCache cache;
 		vk::PipelineBindPoint bindPoint = vk::PipelineBindPoint::eGraphics;
@@ -61,11 +63,20 @@ class Pipeline final {
 	DescriptorPool makeSetPool(u32 set, Buffering buffering) const;
 	std::unordered_map<u32, DescriptorPool> makeSetPools(Buffering buffering) const;
 
-	void bindSet(CommandBuffer cb, u32 set, std::size_t idx) const;
-	void bindSet(CommandBuffer cb, std::initializer_list<u32> sets, std::size_t idx) const;
+	///
+	/// \brief Bind set / sets at index idx; false if a dynamic set's slot was not written (the draw must be skipped)
+	///
+	/// Unwritten slots are logged (as errors) once per set.
+	///
+	bool bindSet(CommandBuffer cb, u32 set, std::size_t idx) const;
+	bool bindSet(CommandBuffer cb, std::initializer_list<u32> sets, std::size_t idx) const;
 	void swap() { m_storage.input.swap(); }
 
 	Hash id() const noexcept;
+	///
+	/// \brief Check if the (main) colour attachment blends: draw order matters
+	///
+	bool blended() const noexcept;
 
 	not_null<VRAM*> m_vram;
 	not_null<Device*> m_device;
@@ -95,6 +106,7 @@ class Pipeline final {
 
 	Storage m_storage;
 	Metadata m_metadata;
+	mutable u64 m_unwritten = 0; // bit per set: unwritten dynamic slot already logged
 
 	friend struct Hasher;
 };
@@ -102,6 +114,7 @@ class Pipeline final {
 // impl
 
 inline Hash Pipeline::id() const noexcept { return m_storage.id; }
+inline bool Pipeline::blended() const noexcept { return m_metadata.main.fixedState.colorBlendAttachment.blendEnable; }
 } // namespace le::graphics
 
 namespace std {
@@ -10,6 +10,8 @@ struct RGBA {
 
 	constexpr RGBA(Colour colour = {}, Type type = Type::eIntensity) noexcept : colour(colour), type(type) {}
 
+	constexpr bool operator==(RGBA const& rhs) const noexcept { return type == rhs.type && colour.toU32() == rhs.colour.toU32(); }
+
 	glm::vec4 toVec4() const noexcept { return type == Type::eAbsolute ? colour.toRGB() : colour.toVec4(); }
 };
 } // namespace le::graphics
@@ -0,0 +1,83 @@
+#pragma once
+#include <vector>
+#include <core/not_null.hpp>
+#include <graphics/render/buffering.hpp>
+#include <graphics/resources.hpp>
+#include <graphics/utils/ring_buffer.hpp>
+
+namespace le::graphics {
+class VRAM;
+
+///
+/// \brief Frame-scoped linear allocator over persistently mapped, host-visible buffers
+///
+/// One ring entry per buffered frame; each frame bump-allocates aligned slices out of its blocks,
+/// and all slices of a frame are recycled at once via next() (after that frame's fence has been waited on).
+///
+class UniformArena {
+  public:
+	struct CreateInfo;
+	struct Slice {
+		vk::Buffer buffer;
+		vk::DeviceSize offset = 0;
+		vk::DeviceSize size = 0;
+		void* pData = nullptr;
+
+		bool valid() const noexcept { return buffer != vk::Buffer(); }
+	};
+	struct Stats {
+		vk::DeviceSize used = 0;
+		vk::DeviceSize highWater = 0;
+		vk::DeviceSize capacity = 0;
+		u32 blocks = 0;
+	};
+
+	UniformArena(not_null<VRAM*> vram, CreateInfo const& info);
+
+	Slice allocate(vk::DeviceSize size);
+	Slice write(void const* pData, vk::DeviceSize size);
+	template <typename T>
+	Slice write(T const& t);
+	void next();
+
+	vk::DeviceSize alignment() const noexcept { return m_storage.alignment; }
+	vk::BufferUsageFlags usage() const noexcept { return m_storage.usage; }
+	Stats const& stats() const noexcept { return m_stats; }
+
+	not_null<VRAM*> m_vram;
+
+  private:
+	struct Block {
+		Buffer buffer;
+		vk::DeviceSize head = 0;
+	};
+	struct Frame {
+		std::vector<Block> blocks;
+		std::size_t active = 0;
+		vk::DeviceSize used = 0;
+	};
+
+	Block makeBlock(vk::DeviceSize size);
+
+	struct Storage {
+		RingBuffer<Frame> frames;
+		vk::BufferUsageFlags usage;
+		vk::DeviceSize blockSize = 0;
+		vk::DeviceSize alignment = 1;
+	} m_storage;
+	Stats m_stats;
+};
+
+struct UniformArena::CreateInfo {
+	vk::DeviceSize blockSize = vk::DeviceSize(1) << 20;
+	vk::BufferUsageFlags usage = vk::BufferUsageFlags(vk::BufferUsageFlagBits::eUniformBuffer) | vk::BufferUsageFlagBits::eStorageBuffer;
+	Buffering buffering = 2_B;
+};
+
+// impl
+
+template <typename T>
+UniformArena::Slice UniformArena::write(T const& t) {
+	return write(&t, sizeof(T));
+}
+} // namespace le::graphics
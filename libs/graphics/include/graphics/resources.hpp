@@ -75,12 +75,17 @@ class Memory {
 
 	u64 bytes(Resource::Type type) const noexcept;
 
-	static void copy(vk::CommandBuffer cb, vk::Buffer src, vk::Buffer dst, vk::DeviceSize size);
+	static void copy(vk::CommandBuffer cb, vk::Buffer src, vk::Buffer dst, vk::DeviceSize size, vk::DeviceSize srcOffset = 0);
 	static void copy(vk::CommandBuffer cb, vk::Buffer src, vk::Image dst, vAP<vk::BufferImageCopy> regions, ImgMeta const& meta);
 	static void blit(vk::CommandBuffer cb, vk::Image src, vk::Image dst, TPair<vk::Extent3D> extents,
 					 LayoutPair layouts = {vIL::eTransferSrcOptimal, vIL::eTransferDstOptimal}, vk::Filter filter = vk::Filter::eLinear,
 					 TPair<vk::ImageAspectFlags> aspects = {vk::ImageAspectFlagBits::eColor, vk::ImageAspectFlagBits::eColor});
 	static void imageBarrier(vk::CommandBuffer cb, vk::Image image, ImgMeta const& meta);
+	static vk::ImageMemoryBarrier imageMemoryBarrier(vk::Image image, ImgMeta const& meta);
+	///
+	/// \brief Barriers into (first) and out of (second) eTransferDstOptimal, for a copy to an image
+	///
+	static TPair<ImgMeta> copyBarriers(ImgMeta const& meta);
 	static vk::BufferImageCopy bufferImageCopy(vk::Extent3D extent, vk::ImageAspectFlags aspects = vk::ImageAspectFlagBits::eColor, vk::DeviceSize offset = 0,
 											   u32 layerIdx = 0, u32 layerCount = 1);
 
@@ -158,6 +163,7 @@ class Image : public Resource {
 	vk::ImageView view() const noexcept { return m_storage.view; }
 	u32 layerCount() const noexcept { return m_storage.layerCount; }
 	vk::Extent3D extent() const noexcept { return m_storage.extent; }
+	vk::DeviceSize allocatedSize() const noexcept { return m_storage.allocatedSize; }
 	vk::ImageLayout layout() const noexcept { return m_storage.layout; }
 	void layout(vk::ImageLayout layout) noexcept { m_storage.layout = layout; }
 	vk::ImageUsageFlags usage() const noexcept { return m_storage.usage; }
@@ -1,5 +1,6 @@
 #pragma once
 #include <core/not_null.hpp>
+#include <core/span.hpp>
 #include <core/std_types.hpp>
 #include <vulkan/vulkan.hpp>
 
@@ -15,7 +16,7 @@ class Shader {
 
 	template <typename T>
 	using ArrayMap = EnumArray<Type, T>;
-	using SpirVMap = ArrayMap<bytearray>;
+	using SpirVMap = ArrayMap<Span<std::byte const>>;
 	using CodeMap = ArrayMap<std::vector<u32>>;
 	using ModuleMap = ArrayMap<vk::ShaderModule>;
 	using ResourcesMap = ArrayMap<Resources>;
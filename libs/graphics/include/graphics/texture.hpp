@@ -39,6 +39,9 @@ class Texture {
 
 	using Img = Bitmap::type;
 	using Cubemap = std::array<Bitmap::type, 6>;
+	// non-owning compressed data: must outlive construct()
+	using ImgView = BMPview;
+	using CubemapView = std::array<BMPview, 6>;
 	struct CreateInfo;
 
 	inline static constexpr auto srgb = vk::Format::eR8G8B8A8Srgb;
@@ -49,6 +52,7 @@ class Texture {
 	bool construct(CreateInfo const& info);
 
 	bool valid() const noexcept;
+	u64 bytes() const noexcept;
 	bool busy() const;
 	bool ready() const;
 	void wait() const;
@@ -72,7 +76,7 @@ class Texture {
 };
 
 struct Texture::CreateInfo {
-	using Data = std::variant<Img, Cubemap, Bitmap>;
+	using Data = std::variant<Img, Cubemap, Bitmap, ImgView, CubemapView>;
 
 	Data data;
 	vk::Sampler sampler;
@@ -31,7 +31,7 @@ struct VertexInfoFactory<Vertex> {
 namespace utils {
 class STBImg : public TBitmap<BMPview> {
   public:
-	explicit STBImg(Bitmap::type const& compressed, u8 channels = 4);
+	explicit STBImg(BMPview compressed, u8 channels = 4);
 	STBImg(STBImg&&) noexcept;
 	STBImg& operator=(STBImg&&) noexcept;
 	~STBImg();
@@ -0,0 +1,134 @@
+#include <cstring>
+#include <graphics/common.hpp>
+#include <graphics/context/staging_ring.hpp>
+
+namespace le::graphics {
+namespace {
+constexpr vk::DeviceSize align(vk::DeviceSize offset) noexcept { return (offset + StagingRing::alignment - 1) & ~(StagingRing::alignment - 1); }
+
+Buffer makeStagingBuffer(Memory& memory, vk::DeviceSize size) {
+	Buffer::CreateInfo info;
+	info.size = size;
+	info.properties = vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent;
+	info.usage = vk::BufferUsageFlagBits::eTransferSrc;
+	info.queueFlags = QFlags(QType::eGraphics) | QType::eTransfer;
+	info.vmaUsage = VMA_MEMORY_USAGE_CPU_ONLY;
+	return Buffer(&memory, info);
+}
+} // namespace
+
+struct StagingRing::Block {
+	struct Live {
+		vk::DeviceSize offset;
+		vk::DeviceSize size;
+		bool released;
+	};
+
+	Buffer buffer;
+	std::deque<Live> live; // allocation order: front is the ring's tail
+	vk::DeviceSize head = 0;
+	time::Point idle = time::now();
+	bool dedicated = false;
+
+	vk::DeviceSize capacity() const noexcept { return buffer.writeSize(); }
+};
+
+bool StagingRing::Alloc::write(void const* pData, vk::DeviceSize size, vk::DeviceSize offset) const {
+	if (!mapped || offset + size > this->size) { return false; }
+	std::memcpy((u8*)mapped + offset, pData, (std::size_t)size);
+	return true;
+}
+
+StagingRing::StagingRing(not_null<Memory*> memory, CreateInfo const& info) : m_info(info), m_memory(memory) {}
+StagingRing::StagingRing(StagingRing&&) noexcept = default;
+StagingRing& StagingRing::operator=(StagingRing&&) noexcept = default;
+StagingRing::~StagingRing() = default;
+
+std::optional<StagingRing::Alloc> StagingRing::allocate(vk::DeviceSize size) {
+	if (size == 0) { return std::nullopt; }
+	if (size > m_info.blockSize) {
+		if (m_stats.capacity + size > m_info.cap && busy()) { return std::nullopt; }
+		if (size > m_info.cap) { g_log.log(lvl::warning, 1, "[{}] Staging [{}] bytes exceeds cap [{}]", g_name, size, m_info.cap); }
+		return allocate(makeBlock(size, true), size);
+	}
+	for (auto& block : m_blocks) {
+		if (!block->dedicated) {
+			if (auto ret = allocate(*block, size)) { return ret; }
+		}
+	}
+	if (m_stats.capacity + m_info.blockSize > m_info.cap && busy()) { return std::nullopt; }
+	return allocate(makeBlock(m_info.blockSize, false), size);
+}
+
+void StagingRing::release(Alloc const& alloc) {
+	if (!alloc) { return; }
+	auto& block = *alloc.block;
+	for (auto& live : block.live) {
+		if (live.offset == alloc.offset && !live.released) {
+			live.released = true;
+			m_stats.used -= live.size;
+			break;
+		}
+	}
+	while (!block.live.empty() && block.live.front().released) { block.live.pop_front(); }
+	if (block.live.empty()) {
+		block.head = 0;
+		block.idle = time::now();
+		if (block.dedicated) {
+			std::erase_if(m_blocks, [&block](auto const& b) { return b.get() == &block; });
+			m_stats.capacity -= alloc.size;
+		}
+	}
+}
+
+void StagingRing::trim() {
+	auto const now = time::now();
+	for (auto it = m_blocks.begin(); it != m_blocks.end();) {
+		auto& block = **it;
+		if (it != m_blocks.begin() && block.live.empty() && now - block.idle >= m_info.trimAfter) {
+			m_stats.capacity -= block.capacity();
+			it = m_blocks.erase(it);
+		} else {
+			++it;
+		}
+	}
+}
+
+void StagingRing::stall(Time_us duration) noexcept {
+	++m_stats.stalls;
+	m_stats.stalled += duration;
+}
+
+StagingRing::Block& StagingRing::makeBlock(vk::DeviceSize size, bool bDedicated) {
+	auto block = std::make_unique<Block>(Block{makeStagingBuffer(*m_memory, size), {}, 0, time::now(), bDedicated});
+	[[maybe_unused]] bool const bMapped = block->buffer.map();
+	ensure(bMapped, "Memory map failed");
+	m_stats.capacity += size;
+	g_log.log(lvl::debug, 2, "[{}] Staging block [{}] bytes allocated (total: [{}])", g_name, size, m_stats.capacity);
+	m_blocks.push_back(std::move(block));
+	return *m_blocks.back();
+}
+
+std::optional<StagingRing::Alloc> StagingRing::allocate(Block& out_block, vk::DeviceSize size) {
+	// free space: [head, capacity) + [0, tail) if not wrapped, else [head, tail)
+	auto const capacity = out_block.capacity();
+	std::optional<vk::DeviceSize> offset;
+	if (out_block.live.empty()) {
+		if (size <= capacity) { offset = 0; }
+	} else if (auto const tail = out_block.live.front().offset; out_block.head > tail) {
+		if (align(out_block.head) + size <= capacity) {
+			offset = align(out_block.head);
+		} else if (size <= tail) {
+			offset = 0;
+		}
+	} else if (align(out_block.head) + size <= tail) {
+		offset = align(out_block.head);
+	}
+	if (!offset) { return std::nullopt; }
+	out_block.head = *offset + size;
+	out_block.live.push_back({*offset, size, false});
+	m_stats.used += size;
+	m_stats.peak = std::max(m_stats.peak, m_stats.used);
+	return Alloc{&out_block, out_block.buffer.buffer(), (u8*)out_block.buffer.mapped() + *offset, *offset, size};
+}
+} // namespace le::graphics
@@ -1,44 +1,73 @@
+#include <algorithm>
+#include <iterator>
 #include <core/utils/algo.hpp>
 #include <graphics/common.hpp>
 #include <graphics/context/device.hpp>
 #include <graphics/context/transfer.hpp>
 
 namespace le::graphics {
+struct Transfer::Worker {
+	vk::CommandPool pool; // allocated from / recorded into by this worker's thread only
+	std::vector<vk::CommandBuffer> commands; // recycled: guarded by mutex
+	std::mutex mutex;
+	kt::kthread thread;
+	Transfer const* owner = {};
+	std::size_t index = 0;
+};
+
 namespace {
-constexpr vk::DeviceSize ceilPOT(vk::DeviceSize size) noexcept {
-	vk::DeviceSize ret = 2;
-	while (ret < size) { ret <<= 1; }
-	return ret;
+thread_local Transfer::Worker* t_worker = {};
 }
 
-Buffer makeStagingBuffer(Memory& memory, vk::DeviceSize size) {
-	Buffer::CreateInfo info;
-	info.size = ceilPOT(size);
-	info.properties = vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent;
-	info.usage = vk::BufferUsageFlagBits::eTransferSrc;
-	info.queueFlags = QFlags(QType::eGraphics) | QType::eTransfer;
-	info.vmaUsage = VMA_MEMORY_USAGE_CPU_ONLY;
-	return Buffer(&memory, info);
+void Transfer::Recorder::record(vk::CommandBuffer cb) const {
+	vk::CommandBufferBeginInfo beginInfo;
+	beginInfo.flags = vk::CommandBufferUsageFlagBits::eOneTimeSubmit;
+	cb.begin(beginInfo);
+	std::vector<vk::ImageMemoryBarrier> pre, post;
+	pre.reserve(images.size());
+	post.reserve(images.size());
+	TPair<vk::PipelineStageFlags> stages;
+	for (auto const& image : images) {
+		auto const [first, second] = Memory::copyBarriers(image.meta);
+		pre.push_back(Memory::imageMemoryBarrier(image.dst, first));
+		post.push_back(Memory::imageMemoryBarrier(image.dst, second));
+		stages.first |= first.stages.first;
+		stages.second |= second.stages.second;
+	}
+	if (!pre.empty()) { cb.pipelineBarrier(stages.first, vk::PipelineStageFlagBits::eTransfer, {}, {}, {}, pre); }
+	for (auto const& buffer : buffers) { cb.copyBuffer(buffer.src, buffer.dst, buffer.region); }
+	for (auto const& image : images) { cb.copyBufferToImage(image.src, image.dst, vk::ImageLayout::eTransferDstOptimal, image.regions); }
+	if (!post.empty()) { cb.pipelineBarrier(vk::PipelineStageFlagBits::eTransfer, stages.second, {}, {}, {}, post); }
+	cb.end();
 }
-} // namespace
 
-Transfer::Transfer(not_null<Memory*> memory, CreateInfo const& info) : m_memory(memory) {
+Transfer::Transfer(not_null<Memory*> memory, CreateInfo const& info) : m_ring(memory, info.staging), m_memory(memory), m_completion(info.completion), m_coalesce(info.coalesce) {
 	vk::CommandPoolCreateInfo poolInfo;
 	poolInfo.flags = vk::CommandPoolCreateFlagBits::eResetCommandBuffer;
 	poolInfo.queueFamilyIndex = memory->m_device->queues().familyIndex(QType::eTransfer);
 	m_data.pool = memory->m_device->device().createCommandPool(poolInfo);
-	m_sync.staging = kt::kthread([this, r = info.reserve]() {
-		{
-			std::scoped_lock lock(m_sync.mutex);
-			for (auto const& range : r) {
-				for (auto i = range.count; i > 0; --i) { m_data.buffers.push_back(makeStagingBuffer(*m_memory, range.size)); }
-			}
-		}
-		g_log.log(lvl::info, 1, "[{}] Transfer thread started", g_name);
-		while (auto f = m_queue.pop()) { (*f)(); }
-		g_log.log(lvl::info, 1, "[{}] Transfer thread completed", g_name);
-	});
-	if (info.autoPollRate && *info.autoPollRate > 0ms) {
+	for (std::size_t idx = 0; idx < std::max(info.workers, u8(1)); ++idx) {
+		auto worker = std::make_unique<Worker>();
+		worker->pool = memory->m_device->device().createCommandPool(poolInfo);
+		worker->owner = this;
+		worker->index = idx;
+		m_workers.push_back(std::move(worker));
+	}
+	for (auto& worker : m_workers) {
+		worker->thread = kt::kthread([this, w = worker.get()]() {
+			t_worker = w;
+			g_log.log(lvl::info, 1, "[{}] Transfer thread [{}] started", g_name, w->index);
+			while (auto f = m_queue.pop()) { (*f)(); }
+			g_log.log(lvl::info, 1, "[{}] Transfer thread [{}] completed", g_name, w->index);
+		});
+	}
+	if (m_completion == Completion::eWait) {
+		m_sync.poll = kt::kthread([this](kt::kthread::stop_t stop) {
+			g_log.log(lvl::info, 1, "[{}] Transfer completion thread started", g_name);
+			complete(stop);
+			g_log.log(lvl::info, 1, "[{}] Transfer completion thread completed", g_name);
+		});
+	} else if (info.autoPollRate && *info.autoPollRate > 0ms) {
 		m_sync.poll = kt::kthread([this, rate = *info.autoPollRate](kt::kthread::stop_t stop) {
 			g_log.log(lvl::info, 1, "[{}] Transfer poll thread started", g_name);
 			while (!stop.stop_requested()) {
@@ -54,20 +83,55 @@ Transfer::Transfer(not_null<Memory*> memory, CreateInfo const& info) : m_memory(
 Transfer::~Transfer() {
 	stopPolling();
 	stopTransfer();
-	m_sync.staging = {};
 	Memory& m = *m_memory;
 	Device& d = *m.m_device;
 	d.waitIdle();
+	for (auto& worker : m_workers) { d.destroy(worker->pool); }
+	m_workers.clear();
 	d.destroy(m_data.pool);
 	for (auto& fence : m_data.fences) { d.destroy(fence); }
 	for (auto& batch : m_batches.submitted) { d.destroy(batch.done); }
 	m_data = {};
 	m_batches = {};
+	m_ring = StagingRing(m_memory, {});
 	d.waitIdle(); // force flush deferred
 	g_log.log(lvl::info, 1, "[{}] Transfer destroyed", g_name);
 }
 
 std::size_t Transfer::update() {
+	std::scoped_lock lock(m_sync.mutex);
+	// the completion thread is the only one retiring batches (it waits on their fences outside the lock)
+	if (completing()) { return m_batches.submitted.size() + (m_batches.active.entries.empty() ? 0 : 1); }
+	return updateImpl();
+}
+
+void Transfer::waitIdle() {
+	std::unique_lock lock(m_sync.mutex);
+	if (completing()) {
+		m_sync.retired.wait(lock, [this]() { return idle(); });
+		return;
+	}
+	while (updateImpl() > 0) {
+		lock.unlock();
+		kt::kthread::yield();
+		lock.lock();
+	}
+}
+
+Transfer::Stats Transfer::stats() const {
+	std::scoped_lock lock(m_sync.mutex);
+	auto ret = m_stats;
+	ret.staging = m_ring.stats();
+	return ret;
+}
+
+std::size_t Transfer::updateImpl() {
+	retire();
+	submit();
+	return m_batches.submitted.size();
+}
+
+void Transfer::retire() {
 	auto removeDone = [this](Batch& batch) -> bool {
 		if (m_memory->m_device->signalled(batch.done)) {
 			if (batch.framePad == 0) {
@@ -75,51 +139,144 @@ std::size_t Transfer::update() {
 					promise->set_value();
 					scavenge(std::move(stage), batch.done);
 				}
+				if (batch.coalesced) { m_data.commands.push_back(batch.coalesced); }
 				return true;
 			}
 			--batch.framePad;
 		}
 		return false;
 	};
-	std::scoped_lock lock(m_sync.mutex);
+	auto const submitted = m_batches.submitted.size();
 	utils::erase_if(m_batches.submitted, removeDone);
+	if (m_batches.submitted.size() < submitted) {
+		m_ring.trim();
+		m_sync.retired.notify_all();
+	}
+}
+
+void Transfer::submit() {
+	if (!m_batches.pending.empty()) {
+		m_batches.active.coalesced = nextCoalesced();
+		m_batches.pending.record(m_batches.active.coalesced);
+		m_batches.pending = {};
+	}
 	if (!m_batches.active.entries.empty()) {
 		std::vector<vk::CommandBuffer> commands;
-		commands.reserve(m_batches.active.entries.size());
+		commands.reserve(m_batches.active.entries.size() + 1);
 		m_batches.active.done = nextFence();
-		for (auto& [stage, _] : m_batches.active.entries) { commands.push_back(stage.command); }
+		for (auto& [stage, _] : m_batches.active.entries) {
+			if (stage.command) { commands.push_back(stage.command); }
+		}
+		if (m_batches.active.coalesced) { commands.push_back(m_batches.active.coalesced); }
 		vk::SubmitInfo submitInfo;
 		submitInfo.commandBufferCount = (u32)commands.size();
 		submitInfo.pCommandBuffers = commands.data();
 		m_memory->m_device->queues().submit(QType::eTransfer, submitInfo, m_batches.active.done, true);
+		m_stats.submitted += commands.size();
+		++m_stats.batches;
+		// fence waits complete batches as soon as they're signalled
+		if (m_completion == Completion::eWait) { m_batches.active.framePad = 0; }
 		m_batches.submitted.push_back(std::move(m_batches.active));
 	}
 	m_batches.active = {};
-	return m_batches.submitted.size();
 }
 
-Transfer::Stage Transfer::newStage(vk::DeviceSize bufferSize) { return Stage{nextBuffer(bufferSize), nextCommand()}; }
+StagingRing::Alloc Transfer::reserve(vk::DeviceSize size) {
+	std::unique_lock lock(m_sync.mutex);
+	return nextStaging(lock, size);
+}
+
+Transfer::Stage Transfer::newStage(StagingRing::Alloc staging) {
+	auto& w = worker();
+	return Stage{staging, nextCommand(w), w.index};
+}
+
+void Transfer::complete(kt::kthread::stop_t const& stop) {
+	Device const& device = *m_memory->m_device;
+	while (!stop.stop_requested()) {
+		vk::Fence fence;
+		{
+			std::unique_lock lock(m_sync.mutex);
+			// copies are submitted by addStage() / record() (even while this thread is blocked on a fence): only retire here
+			m_sync.added.wait(lock, [this, &stop]() { return stop.stop_requested() || !m_batches.submitted.empty(); });
+			retire();
+			if (!m_batches.submitted.empty()) { fence = m_batches.submitted.front().done; }
+		}
+		// not reset / recycled until this thread retires its batch
+		if (fence) { device.waitFor(fence); }
+	}
+}
 
 void Transfer::addStage(Stage&& stage, Promise&& promise) {
-	std::scoped_lock lock(m_sync.mutex);
-	m_batches.active.entries.emplace_back(std::move(stage), std::move(promise));
+	{
+		std::scoped_lock lock(m_sync.mutex);
+		m_batches.active.entries.emplace_back(std::move(stage), std::move(promise));
+		if (completing()) { submit(); }
+	}
+	m_sync.added.notify_one();
 }
 
-std::optional<Buffer> Transfer::nextBuffer(vk::DeviceSize size) {
-	if (size == 0) { return std::nullopt; }
-	std::scoped_lock lock(m_sync.mutex);
-	for (auto iter = m_data.buffers.begin(); iter != m_data.buffers.end(); ++iter) {
-		if (iter->writeSize() >= size) {
-			Buffer ret = std::move(*iter);
-			m_data.buffers.erase(iter);
+void Transfer::record(Recorder&& copies, StagingRing::Alloc staging, Promise&& promise) {
+	if (m_coalesce) {
+		std::scoped_lock lock(m_sync.mutex);
+		auto const pending = [this](vk::Image image) {
+			return std::any_of(m_batches.pending.images.begin(), m_batches.pending.images.end(), [image](ImageCopy const& ic) { return ic.dst == image; });
+		};
+		// layout transitions of the same image cannot be merged: submit what's pending first
+		if (std::any_of(copies.images.begin(), copies.images.end(), [&pending](ImageCopy const& ic) { return pending(ic.dst); })) { submit(); }
+		m_stats.recorded += copies.size();
+		std::move(copies.buffers.begin(), copies.buffers.end(), std::back_inserter(m_batches.pending.buffers));
+		std::move(copies.images.begin(), copies.images.end(), std::back_inserter(m_batches.pending.images));
+		m_batches.active.entries.emplace_back(Stage{staging, {}, 0}, std::move(promise));
+		if (completing()) { submit(); }
+		m_sync.added.notify_one();
+		return;
+	}
+	{
+		std::scoped_lock lock(m_sync.mutex);
+		m_stats.recorded += copies.size();
+	}
+	auto f = [c = std::move(copies), staging, p = std::move(promise), this]() mutable {
+		auto stage = newStage(staging);
+		c.record(stage.command);
+		addStage(std::move(stage), std::move(p));
+	};
+	m_queue.push(std::move(f));
+}
+
+StagingRing::Alloc Transfer::nextStaging(std::unique_lock<std::mutex>& lock, vk::DeviceSize size) {
+	if (size == 0) { return {}; }
+	if (auto ret = m_ring.allocate(size)) { return *ret; }
+	// back-pressure: wait for in flight batches to complete and release their staging memory
+	auto const start = time::now();
+	std::optional<StagingRing::Alloc> ret;
+	while (!(ret = m_ring.allocate(size))) {
+		m_sync.retired.wait_for(lock, 1ms);
+		// drive submission / completion if nothing else is polling (staged allocations may be in the active batch)
+		if (!polling()) { updateImpl(); }
+	}
+	auto const stalled = time::diff<Time_us>(start);
+	m_ring.stall(stalled);
+	g_log.log(lvl::debug, 2, "[{}] Staging ring full: stalled for [{}us]", g_name, stalled.count());
+	return *ret;
+}
+
+vk::CommandBuffer Transfer::nextCommand(Worker& out_worker) {
+	{
+		std::scoped_lock lock(out_worker.mutex);
+		if (!out_worker.commands.empty()) {
+			auto ret = out_worker.commands.back();
+			out_worker.commands.pop_back();
 			return ret;
 		}
 	}
-	return makeStagingBuffer(*m_memory, size);
+	vk::CommandBufferAllocateInfo commandBufferInfo;
+	commandBufferInfo.commandBufferCount = 1;
+	commandBufferInfo.commandPool = out_worker.pool;
+	return m_memory->m_device->device().allocateCommandBuffers(commandBufferInfo).front();
 }
 
-vk::CommandBuffer Transfer::nextCommand() {
-	std::scoped_lock lock(m_sync.mutex);
+vk::CommandBuffer Transfer::nextCoalesced() {
 	if (!m_data.commands.empty()) {
 		auto ret = m_data.commands.back();
 		m_data.commands.pop_back();
@@ -131,9 +288,19 @@ vk::CommandBuffer Transfer::nextCommand() {
 	return m_memory->m_device->device().allocateCommandBuffers(commandBufferInfo).front();
 }
 
+Transfer::Worker& Transfer::worker() const {
+	// queued tasks run on workers; residue (after workers have stopped) runs on the first worker's pool
+	if (t_worker && t_worker->owner == this) { return *t_worker; }
+	return *m_workers.front();
+}
+
 void Transfer::scavenge(Stage&& stage, vk::Fence fence) {
-	m_data.commands.push_back(std::move(stage.command));
-	if (stage.buffer) { m_data.buffers.push_back(std::move(*stage.buffer)); }
+	if (stage.command) {
+		auto& worker = *m_workers[stage.worker];
+		std::scoped_lock lock(worker.mutex);
+		worker.commands.push_back(std::move(stage.command));
+	}
+	m_ring.release(stage.staging);
 	if (std::find(m_data.fences.begin(), m_data.fences.end(), fence) == m_data.fences.end()) {
 		m_memory->m_device->resetFence(fence);
 		m_data.fences.push_back(fence);
@@ -151,11 +318,17 @@ vk::Fence Transfer::nextFence() {
 
 void Transfer::stopPolling() {
 	m_sync.poll.request_stop();
+	{
+		// completion thread may be waiting for work
+		std::scoped_lock lock(m_sync.mutex);
+		m_sync.added.notify_all();
+	}
 	m_sync.poll.join();
 }
 
 void Transfer::stopTransfer() {
 	auto residue = m_queue.clear();
+	for (auto& worker : m_workers) { worker->thread = {}; }
 	for (auto& f : residue) { f(); }
 }
 } // namespace le::graphics
@@ -53,12 +53,9 @@ VRAM::Future VRAM::copy(Buffer const& src, Buffer& out_dst, vk::DeviceSize size)
 	}
 	auto promise = Transfer::makePromise();
 	auto ret = promise->get_future();
-	auto f = [p = std::move(promise), s = src.buffer(), d = out_dst.buffer(), size, this]() mutable {
-		auto stage = m_transfer.newStage(size);
-		copy(stage.command, s, d, size);
-		m_transfer.addStage(std::move(stage), std::move(p));
-	};
-	m_transfer.m_queue.push(std::move(f));
+	Transfer::Recorder copies;
+	copies.buffers.push_back({src.buffer(), out_dst.buffer(), vk::BufferCopy(0, 0, size)});
+	m_transfer.record(std::move(copies), {}, std::move(promise));
 	return {std::move(ret)};
 }
 
@@ -72,21 +69,17 @@ VRAM::Future VRAM::stage(Buffer& out_deviceBuffer, void const* pData, vk::Device
 		g_log.log(lvl::error, 1, "[{}] Invalid queue flags on source buffer!", g_name);
 		return {};
 	}
-	bytearray data((std::size_t)size, {});
-	std::memcpy(data.data(), pData, data.size());
+	// written straight into mapped staging memory (on this thread): only the copy is recorded by Transfer
+	auto staging = m_transfer.reserve(size);
+	if (!staging.write(pData, size)) {
+		g_log.log(lvl::error, 1, "[{}] Error staging data!", g_name);
+		return {};
+	}
 	auto promise = Transfer::makePromise();
 	auto ret = promise->get_future();
-	auto f = [p = std::move(promise), dst = out_deviceBuffer.buffer(), d = std::move(data), this]() mutable {
-		auto stage = m_transfer.newStage(vk::DeviceSize(d.size()));
-		if (stage.buffer->write(d.data(), d.size())) {
-			copy(stage.command, stage.buffer->buffer(), dst, d.size());
-			m_transfer.addStage(std::move(stage), std::move(p));
-		} else {
-			g_log.log(lvl::error, 1, "[{}] Error staging data!", g_name);
-			p->set_value();
-		}
-	};
-	m_transfer.m_queue.push(std::move(f));
+	Transfer::Recorder copies;
+	copies.buffers.push_back({staging.buffer, out_deviceBuffer.buffer(), vk::BufferCopy(staging.offset, 0, size)});
+	m_transfer.record(std::move(copies), staging, std::move(promise));
 	return {std::move(ret)};
 }
 
@@ -103,37 +96,31 @@ VRAM::Future VRAM::copy(Span<BMPview const> bitmaps, Image& out_dst, LayoutPair
 	ensure(indices.size() == 1 || out_dst.data().mode == vk::SharingMode::eConcurrent, "Exclusive queues!");
 	ensure((out_dst.usage() & vk::ImageUsageFlagBits::eTransferDst) == vk::ImageUsageFlagBits::eTransferDst, "Transfer bit not set");
 	ensure(out_dst.layout() == layouts.first, "Mismatched image layouts");
+	// each layer is written straight into mapped staging memory (on this thread): only the copy is recorded by Transfer
+	auto staging = m_transfer.reserve(imgSize);
+	if (!staging) {
+		g_log.log(lvl::error, 1, "[{}] Error staging image data!", g_name);
+		return {};
+	}
+	std::vector<vk::BufferImageCopy> copyRegions;
+	copyRegions.reserve(bitmaps.size());
+	u32 layerIdx = 0;
+	for (auto const& pixels : bitmaps) {
+		auto const offset = layerIdx * layerSize;
+		staging.write(pixels.data(), pixels.size(), offset);
+		copyRegions.push_back(bufferImageCopy(out_dst.m_storage.extent, vk::ImageAspectFlagBits::eColor, staging.offset + offset, layerIdx++));
+	}
 	auto promise = Transfer::makePromise();
 	auto ret = promise->get_future();
-	std::vector<bytearray> data;
-	data.reserve(bitmaps.size());
-	for (auto layer : bitmaps) {
-		bytearray bytes(layer.size(), {});
-		std::memcpy(bytes.data(), layer.data(), bytes.size());
-		data.push_back(std::move(bytes));
-	}
-	out_dst.m_storage.layerCount = (u32)data.size();
-	auto f = [p = std::move(promise), d = std::move(data), i = out_dst.image(), l = out_dst.m_storage.layerCount, e = out_dst.m_storage.extent, layouts,
-			  imgSize, layerSize, this]() mutable {
-		auto stage = m_transfer.newStage(imgSize);
-		[[maybe_unused]] bool const bResult = stage.buffer->map();
-		ensure(bResult, "Memory map failed");
-		u32 layerIdx = 0;
-		std::vector<vk::BufferImageCopy> copyRegions;
-		for (auto const& pixels : d) {
-			auto const offset = layerIdx * layerSize;
-			std::memcpy((u8*)stage.buffer->mapped() + offset, pixels.data(), pixels.size());
-			copyRegions.push_back(bufferImageCopy(e, vk::ImageAspectFlagBits::eColor, offset, (u32)layerIdx++));
-		}
-		ImgMeta meta;
-		meta.layouts = layouts;
-		meta.stages.second = m_post.stages;
-		meta.access.second = m_post.access;
-		meta.layerCount = l;
-		copy(stage.command, stage.buffer->buffer(), i, copyRegions, meta);
-		m_transfer.addStage(std::move(stage), std::move(p));
-	};
-	m_transfer.m_queue.push(std::move(f));
+	out_dst.m_storage.layerCount = layerIdx;
+	ImgMeta meta;
+	meta.layouts = layouts;
+	meta.stages.second = m_post.stages;
+	meta.access.second = m_post.access;
+	meta.layerCount = layerIdx;
+	Transfer::Recorder copies;
+	copies.images.push_back({staging.buffer, out_dst.image(), std::move(copyRegions), meta});
+	m_transfer.record(std::move(copies), staging, std::move(promise));
 	out_dst.layout(layouts.second);
 	return {std::move(ret)};
 }
@@ -145,16 +132,14 @@ VRAM::Future VRAM::blit(Image const& src, Image& out_dst, LayoutPair layouts, TP
 	auto ret = promise->get_future();
 	TPair<vk::Extent3D> const extents = {src.extent(), out_dst.extent()};
 	auto f = [this, p = std::move(promise), s = src.image(), d = out_dst.image(), extents, layouts, aspects, filter]() mutable {
-		auto stage = m_transfer.newStage(0);
+		auto stage = m_transfer.newStage();
 		blit(stage.command, s, d, extents, layouts, filter, aspects);
 		m_transfer.addStage(std::move(stage), std::move(p));
 	};
 	return {std::move(ret)};
 }
 
-void VRAM::waitIdle() {
-	while (m_transfer.update() > 0) { kt::kthread::yield(); }
-}
+void VRAM::waitIdle() { m_transfer.waitIdle(); }
 
 bool VRAM::update(bool force) {
 	if (!m_transfer.polling() || force) {
@@ -180,4 +180,138 @@ graphics::Geometry graphics::makeCubedSphere(f32 diam, u8 quadsPerSide) {
 	addSide(points, ret, diam, [](v3 const& p) -> v3 { return glm::normalize(glm::rotate(p, glm::radians(-90.0f), right)); });
 	return ret;
 }
+
+namespace {
+namespace forsyth {
+constexpr std::size_t cacheSize = 32;
+constexpr f32 decayPower = 1.5f;
+constexpr f32 lastTriScore = 0.75f;
+constexpr f32 valenceScale = 2.0f;
+constexpr f32 valencePower = 0.5f;
+
+f32 score(s32 cachePos, u32 remaining) noexcept {
+	if (remaining == 0) { return -1.0f; }
+	f32 ret = 0.0f;
+	if (cachePos >= 0) {
+		if (cachePos < 3) {
+			ret = lastTriScore;
+		} else {
+			f32 const scaler = 1.0f / (cacheSize - 3);
+			ret = std::pow(1.0f - f32(cachePos - 3) * scaler, decayPower);
+		}
+	}
+	return ret + valenceScale * std::pow(f32(remaining), -valencePower);
+}
+} // namespace forsyth
+} // namespace
+
+void graphics::optimiseVertexCache(Span<u32> indices, u32 vertexCount) {
+	std::size_t const triCount = indices.size() / 3;
+	if (triCount < 2 || vertexCount == 0) { return; }
+	struct Vert {
+		std::size_t offset = 0;
+		u32 remaining = 0;
+		s32 cachePos = -1;
+		f32 score = 0.0f;
+	};
+	std::vector<Vert> verts(vertexCount);
+	for (std::size_t idx = 0; idx < triCount * 3; ++idx) {
+		ensure(indices[idx] < vertexCount, "Invalid index");
+		++verts[indices[idx]].remaining;
+	}
+	// vertex -> triangle adjacency (CSR)
+	std::vector<u32> adjacency(triCount * 3);
+	{
+		std::size_t offset = 0;
+		for (Vert& v : verts) {
+			v.offset = offset;
+			offset += v.remaining;
+			v.remaining = 0;
+		}
+		for (std::size_t tri = 0; tri < triCount; ++tri) {
+			for (std::size_t k = 0; k < 3; ++k) {
+				Vert& v = verts[indices[tri * 3 + k]];
+				adjacency[v.offset + v.remaining++] = (u32)tri;
+			}
+		}
+	}
+	for (Vert& v : verts) { v.score = forsyth::score(-1, v.remaining); }
+	std::vector<f32> triScores(triCount);
+	std::vector<u8> emitted(triCount, 0);
+	for (std::size_t tri = 0; tri < triCount; ++tri) {
+		triScores[tri] = verts[indices[tri * 3]].score + verts[indices[tri * 3 + 1]].score + verts[indices[tri * 3 + 2]].score;
+	}
+	std::vector<u32> out;
+	out.reserve(triCount * 3);
+	std::vector<u32> cache, next;
+	cache.reserve(forsyth::cacheSize + 3);
+	next.reserve(forsyth::cacheSize + 3);
+	std::size_t cursor = 0;
+	s64 best = 0;
+	for (std::size_t tri = 1; tri < triCount; ++tri) {
+		if (triScores[tri] > triScores[(std::size_t)best]) { best = (s64)tri; }
+	}
+	while (best >= 0) {
+		std::size_t const tri = (std::size_t)best;
+		emitted[tri] = 1;
+		u32 const* const triVerts = &indices[tri * 3];
+		// emit, remove tri from its vertices' adjacency
+		next.clear();
+		for (std::size_t k = 0; k < 3; ++k) {
+			u32 const vi = triVerts[k];
+			out.push_back(vi);
+			next.push_back(vi);
+			Vert& v = verts[vi];
+			auto const begin = adjacency.begin() + (std::ptrdiff_t)v.offset;
+			auto const it = std::find(begin, begin + v.remaining, (u32)tri);
+			std::iter_swap(it, begin + (v.remaining - 1));
+			--v.remaining;
+		}
+		// LRU: emitted vertices to the front
+		for (u32 const vi : cache) {
+			if (vi != triVerts[0] && vi != triVerts[1] && vi != triVerts[2]) { next.push_back(vi); }
+		}
+		for (std::size_t pos = 0; pos < next.size(); ++pos) {
+			Vert& v = verts[next[pos]];
+			v.cachePos = pos < forsyth::cacheSize ? (s32)pos : -1;
+			v.score = forsyth::score(v.cachePos, v.remaining);
+		}
+		// rescore triangles of all touched vertices, pick best among them
+		best = -1;
+		f32 bestScore = -1.0f;
+		for (u32 const vi : next) {
+			Vert const& v = verts[vi];
+			for (std::size_t a = 0; a < v.remaining; ++a) {
+				u32 const t = adjacency[v.offset + a];
+				f32 const sc = verts[indices[t * 3]].score + verts[indices[t * 3 + 1]].score + verts[indices[t * 3 + 2]].score;
+				triScores[t] = sc;
+				if (sc > bestScore) {
+					bestScore = sc;
+					best = (s64)t;
+				}
+			}
+		}
+		if (next.size() > forsyth::cacheSize) { next.resize(forsyth::cacheSize); }
+		std::swap(cache, next);
+		if (best < 0) {
+			// cache exhausted: continue from the next unemitted triangle
+			while (cursor < triCount && emitted[cursor]) { ++cursor; }
+			if (cursor < triCount) { best = (s64)cursor; }
+		}
+	}
+	std::copy(out.begin(), out.end(), indices.begin());
+}
+
+f32 graphics::vertexCacheACMR(Span<u32 const> indices, u32 vertexCount, u32 cacheSize) {
+	std::size_t const triCount = indices.size() / 3;
+	if (triCount == 0) { return 0.0f; }
+	// FIFO cache: vertex is cached if it entered within the last cacheSize misses
+	std::vector<std::size_t> stamps(vertexCount, 0);
+	std::size_t misses = 0;
+	for (std::size_t idx = 0; idx < triCount * 3; ++idx) {
+		std::size_t& stamp = stamps[indices[idx]];
+		if (stamp == 0 || misses - stamp >= cacheSize) { stamp = ++misses; }
+	}
+	return f32(misses) / f32(triCount);
+}
 } // namespace le
@@ -5,13 +5,14 @@
 namespace le::graphics {
 Mesh::Mesh(not_null<VRAM*> vram, Type type) : m_vram(vram), m_type(type) {}
 Mesh::Mesh(Mesh&& rhs)
-	: m_vram(rhs.m_vram), m_vbo(std::exchange(rhs.m_vbo, Storage())), m_ibo(std::exchange(rhs.m_ibo, Storage())), m_triCount(rhs.m_triCount),
-	  m_type(rhs.m_type) {}
+	: m_vram(rhs.m_vram), m_vbo(std::exchange(rhs.m_vbo, Storage())), m_ibo(std::exchange(rhs.m_ibo, Storage())), m_bounds(rhs.m_bounds),
+	  m_triCount(rhs.m_triCount), m_type(rhs.m_type) {}
 Mesh& Mesh::operator=(Mesh&& rhs) {
 	if (&rhs != this) {
 		destroy();
 		m_vbo = std::exchange(rhs.m_vbo, Storage());
 		m_ibo = std::exchange(rhs.m_ibo, Storage());
+		m_bounds = std::exchange(rhs.m_bounds, Bounds());
 		m_triCount = std::exchange(rhs.m_triCount, 0);
 		m_type = rhs.m_type;
 	}
@@ -49,6 +50,14 @@ bool Mesh::draw(CommandBuffer cb, u32 instances, u32 first) const {
 
 bool Mesh::valid() const noexcept { return m_vbo.buffer.has_value(); }
 
+u64 Mesh::bytes() const noexcept {
+	u64 ret = 0;
+	for (auto const* storage : {&m_vbo, &m_ibo}) {
+		if (storage->buffer) { ret += storage->buffer->writeSize(); }
+	}
+	return ret;
+}
+
 bool Mesh::busy() const {
 	if (!valid() || m_type == Type::eDynamic) { return false; }
 	return m_vbo.transfer.busy() || m_ibo.transfer.busy();
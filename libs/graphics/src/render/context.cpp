@@ -61,7 +61,8 @@ VertexInputInfo RenderContext::vertexInput(QuickVertexInput const& info) {
 }
 
 RenderContext::RenderContext(not_null<Swapchain*> swapchain, std::unique_ptr<ARenderer>&& renderer)
-	: m_pool(swapchain->m_device, vk::CommandPoolCreateFlagBits::eTransient), m_swapchain(swapchain), m_device(swapchain->m_device) {
+	: m_pool(swapchain->m_device, vk::CommandPoolCreateFlagBits::eTransient), m_arena(swapchain->m_vram, {.buffering = renderer->buffering()}),
+	  m_swapchain(swapchain), m_device(swapchain->m_device) {
 	m_storage.renderer = std::move(renderer);
 	m_storage.status = Status::eWaiting;
 	validateBuffering(m_swapchain->buffering(), m_storage.renderer->buffering());
@@ -95,6 +96,7 @@ bool RenderContext::waitForFrame() {
 		}
 		m_storage.renderer->waitForFrame();
 		m_pool.update();
+		m_arena.next();
 		set(Status::eReady);
 	}
 	return true;
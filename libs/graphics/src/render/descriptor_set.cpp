@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <core/utils/algo.hpp>
 #include <graphics/common.hpp>
 #include <graphics/context/device.hpp>
@@ -24,7 +25,7 @@ bool stale(DescriptorSet::Bufs const& lhs, DescriptorSet::Bufs const& rhs) noexc
 	for (std::size_t idx = 0; idx < lhs.buffers.size(); ++idx) {
 		auto const& l = lhs.buffers[idx];
 		auto const& r = rhs.buffers[idx];
-		if (l.size != r.size || l.writes != r.writes || l.buffer != r.buffer) { return true; }
+		if (l.offset != r.offset || l.size != r.size || l.writes != r.writes || l.buffer != r.buffer) { return true; }
 	}
 	return false;
 }
@@ -75,7 +76,7 @@ void DescriptorSet::updateBufs(u32 binding, Bufs bufs) {
 		for (auto const& buf : bufs.buffers) {
 			vk::DescriptorBufferInfo bufferInfo;
 			bufferInfo.buffer = buf.buffer;
-			bufferInfo.offset = 0;
+			bufferInfo.offset = buf.offset;
 			bufferInfo.range = buf.size;
 			bufferInfos.push_back(bufferInfo);
 		}
@@ -117,7 +118,10 @@ bool DescriptorSet::unassigned() const noexcept {
 	return bi.empty() || std::all_of(bi.begin(), bi.end(), [](auto const& kvp) { return kvp.second.bUnassigned; });
 }
 
-void DescriptorSet::update(vk::WriteDescriptorSet write) { m_device->device().updateDescriptorSets(write, {}); }
+void DescriptorSet::update(vk::WriteDescriptorSet write) {
+	m_device->device().updateDescriptorSets(write, {});
+	s_writes.fetch_add(1);
+}
 
 std::pair<DescriptorSet::Set&, DescriptorSet::Binding&> DescriptorSet::setBind(u32 bind, vk::DescriptorType type, u32 count) {
 	auto& set = m_storage.setBuffer.get();
@@ -133,14 +137,22 @@ DescriptorPool::DescriptorPool(not_null<Device*> device, DescriptorSet::CreateIn
 	m_storage.buffering = info.buffering;
 	m_storage.setNumber = info.setNumber;
 	bool bActive = false;
+	bool bDynamic = true;
 	for (auto const& bi : info.bindingInfos) {
 		m_storage.bindInfos.push_back(bi);
 		bActive |= !bi.bUnassigned;
 		if (!bi.bUnassigned) {
 			u32 const b = bi.binding.binding;
+			bDynamic &= DescriptorSet::dynamic(bi.binding.descriptorType) && bi.binding.descriptorCount == 1;
+			m_dynamic.binds.push_back(b);
 			g_log.log(lvl::debug, 2, "[{}] Binding [{}/{}] [{}] for [{}] registered", g_name, info.setNumber, b, bi.name, info.name);
 		}
 	}
+	if (bActive && bDynamic) {
+		std::sort(m_dynamic.binds.begin(), m_dynamic.binds.end());
+	} else {
+		m_dynamic.binds.clear();
+	}
 	populate(1);
 	std::string_view const suffix = bActive ? "constructed" : "inactive";
 	g_log.log(lvl::debug, 2, "[{}] SetPool [{}/{}] {}", g_name, info.name, info.setNumber, suffix);
@@ -177,6 +189,7 @@ Span<DescriptorSet> DescriptorPool::populate(std::size_t count) {
 
 void DescriptorPool::swap() {
 	for (auto& descriptorSet : m_storage.descriptorSets) { descriptorSet.swap(); }
+	resetDynamic();
 }
 
 bool DescriptorPool::contains(u32 bind) const noexcept {
@@ -194,7 +207,76 @@ bool DescriptorPool::unassigned() const noexcept {
 	return bi.empty() || std::all_of(bi.begin(), bi.end(), [](BindingInfo const& b) { return b.bUnassigned; });
 }
 
-void DescriptorPool::clear() noexcept { m_storage.descriptorSets.clear(); }
+void DescriptorPool::clear() noexcept {
+	m_storage.descriptorSets.clear();
+	resetDynamic();
+}
+
+bool DescriptorPool::updateDynamic(u32 bind, UniformArena::Slice const& slice, std::size_t idx) {
+	auto const it = std::find(m_dynamic.binds.begin(), m_dynamic.binds.end(), bind);
+	if (it == m_dynamic.binds.end() || !slice.valid()) { return false; }
+	auto const bindIdx = std::size_t(it - m_dynamic.binds.begin());
+	Slot& s = slot(idx);
+	s.slices[bindIdx] = slice;
+	s.offsets[bindIdx] = (u32)slice.offset;
+	if (claim(s.set, bindIdx, slice)) {
+		write(s, bindIdx);
+	} else {
+		// binding already references another buffer this frame: move this slot to a fresh set
+		s.set = ++m_dynamic.head;
+		for (std::size_t i = 0; i < s.slices.size(); ++i) {
+			if (s.slices[i].valid()) {
+				claim(s.set, i, s.slices[i]);
+				write(s, i);
+			}
+		}
+	}
+	return true;
+}
+
+std::optional<std::pair<DescriptorSet const&, Span<u32 const>>> DescriptorPool::dynamicSet(std::size_t idx) const {
+	if (idx >= m_dynamic.slots.size()) { return std::nullopt; }
+	Slot const& s = m_dynamic.slots[idx];
+	// an unwritten binding would read another slot's buffer (or nothing) at offset 0
+	if (s.slices.empty() || std::any_of(s.slices.begin(), s.slices.end(), [](UniformArena::Slice const& slice) { return !slice.valid(); })) {
+		return std::nullopt;
+	}
+	return std::pair<DescriptorSet const&, Span<u32 const>>(index(s.set), s.offsets);
+}
+
+DescriptorPool::Slot& DescriptorPool::slot(std::size_t idx) {
+	if (m_dynamic.slots.size() <= idx) { m_dynamic.slots.resize(idx + 1); }
+	Slot& ret = m_dynamic.slots[idx];
+	if (ret.slices.empty()) {
+		ret.slices.resize(m_dynamic.binds.size());
+		ret.offsets.resize(m_dynamic.binds.size(), 0U);
+		ret.set = m_dynamic.head;
+	}
+	return ret;
+}
+
+bool DescriptorPool::claim(std::size_t set, std::size_t bindIdx, UniformArena::Slice const& slice) {
+	while (m_dynamic.claimed.size() <= set) { m_dynamic.claimed.emplace_back(m_dynamic.binds.size()); }
+	auto& claimed = m_dynamic.claimed[set][bindIdx];
+	if (!claimed.valid()) {
+		claimed = slice;
+		return true;
+	}
+	return claimed.buffer == slice.buffer && claimed.size == slice.size;
+}
+
+void DescriptorPool::write(Slot const& slot, std::size_t bindIdx) {
+	auto const& slice = slot.slices[bindIdx];
+	u32 const bind = m_dynamic.binds[bindIdx];
+	DescriptorSet& ds = index(slot.set);
+	if (auto pInfo = ds.binding(bind)) { ds.updateBufs(bind, {{{slice.buffer, 0, (std::size_t)slice.size}}, pInfo->binding.descriptorType}); }
+}
+
+void DescriptorPool::resetDynamic() noexcept {
+	m_dynamic.slots.clear();
+	m_dynamic.claimed.clear();
+	m_dynamic.head = 0;
+}
 
 ShaderInput::ShaderInput(Pipeline const& pipe, Buffering buffering) : m_vram(pipe.m_vram) { m_setPools = pipe.makeSetPools(buffering); }
 
@@ -251,6 +333,10 @@ bool ShaderInput::update(Span<Buffer const> buffers, u32 set, u32 bind, std::siz
 		}
 	}
 	if (buffers.empty()) { return false; }
+	if (auto& pool = this->pool(set); pool.dynamic()) {
+		Buffer const& buffer = buffers.front();
+		return pool.updateDynamic(bind, {buffer.buffer(), 0, buffer.writeSize()}, idx);
+	}
 	this->pool(set).index(idx).update(bind, buffers, type);
 	return true;
 }
@@ -272,6 +358,19 @@ bool ShaderInput::update(ShaderBuffer const& buffer, u32 set, u32 bind, std::siz
 	}
 }
 
+bool ShaderInput::update(UniformArena::Slice const& slice, u32 set, u32 bind, std::size_t idx, vk::DescriptorType type) {
+	if constexpr (levk_debug) {
+		if (!contains(set)) {
+			ensure(false, "DescriptorSet update failure");
+			return false;
+		}
+	}
+	if (!slice.valid()) { return false; }
+	if (auto& pool = this->pool(set); pool.dynamic()) { return pool.updateDynamic(bind, slice, idx); }
+	this->pool(set).index(idx).update(bind, slice, type);
+	return true;
+}
+
 DescriptorPool& ShaderInput::operator[](u32 set) { return this->pool(set); }
 
 DescriptorPool const& ShaderInput::operator[](u32 set) const { return pool(set); }
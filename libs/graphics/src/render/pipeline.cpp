@@ -1,5 +1,7 @@
 #include <algorithm>
 #include <core/maths.hpp>
+#include <core/utils/algo.hpp>
+#include <graphics/common.hpp>
 #include <graphics/context/device.hpp>
 #include <graphics/context/vram.hpp>
 #include <graphics/render/command_buffer.hpp>
@@ -20,6 +22,20 @@ void setIfSet(T& out_dst, U&& u) {
 	if (!Device::default_v(u)) { out_dst = u; }
 }
 
+template <typename C>
+bool makeDynamic(C& out_bindings) {
+	using DT = vk::DescriptorType;
+	for (auto const& b : out_bindings) {
+		auto const type = b.binding.descriptorType;
+		if (!b.bUnassigned && ((type != DT::eUniformBuffer && type != DT::eStorageBuffer) || b.binding.descriptorCount != 1)) { return false; }
+	}
+	for (auto& b : out_bindings) {
+		auto& type = b.binding.descriptorType;
+		if (!b.bUnassigned) { type = type == DT::eStorageBuffer ? DT::eStorageBufferDynamic : DT::eUniformBufferDynamic; }
+	}
+	return true;
+}
+
 bool valid(Shader::ModuleMap const& shaders) noexcept {
 	return std::any_of(std::begin(shaders.arr), std::end(shaders.arr), [](vk::ShaderModule const& m) -> bool { return !Device::default_v(m); });
 }
@@ -98,12 +114,31 @@ std::unordered_map<u32, DescriptorPool> Pipeline::makeSetPools(Buffering bufferi
 	return ret;
 }
 
-void Pipeline::bindSet(CommandBuffer cb, u32 set, std::size_t idx) const {
-	if (m_storage.input.contains(set)) { cb.bindSet(*m_storage.fixed.layout, m_storage.input.pool(set).index(idx)); }
+bool Pipeline::bindSet(CommandBuffer cb, u32 set, std::size_t idx) const {
+	if (m_storage.input.contains(set)) {
+		if (auto const& pool = m_storage.input.pool(set); pool.dynamic()) {
+			auto const dynamic = pool.dynamicSet(idx);
+			if (!dynamic) {
+				// skipped every draw until written: don't flood the log
+				if (u64 const bit = 1ULL << (set % 64); (m_unwritten & bit) == 0) {
+					g_log.log(lvl::error, 1, "[{}] Dynamic set [{}] slot [{}] of [{}] not written; skipping draws", g_name, set, idx, m_metadata.name);
+					m_unwritten |= bit;
+				}
+				return false;
+			}
+			auto const& [ds, offsets] = *dynamic;
+			cb.bindSets(*m_storage.fixed.layout, ds.get(), set, vk::ArrayProxy<u32 const>((u32)offsets.size(), offsets.data()));
+		} else {
+			cb.bindSet(*m_storage.fixed.layout, pool.index(idx));
+		}
+	}
+	return true;
 }
 
-void Pipeline::bindSet(CommandBuffer cb, std::initializer_list<u32> sets, std::size_t idx) const {
-	for (u32 const set : sets) { bindSet(cb, set, idx); }
+bool Pipeline::bindSet(CommandBuffer cb, std::initializer_list<u32> sets, std::size_t idx) const {
+	bool ret = true;
+	for (u32 const set : sets) { ret &= bindSet(cb, set, idx); }
+	return ret;
 }
 
 bool Pipeline::construct(Shader const& shader, CreateInfo& out_info, vk::Pipeline& out_pipe, bool bFixed) {
@@ -119,6 +154,9 @@ bool Pipeline::construct(Shader const& shader, CreateInfo& out_info, vk::Pipelin
 		auto setBindings = utils::extractBindings(shader);
 		std::vector<vk::DescriptorSetLayout> layouts;
 		for (auto& [set, binds] : setBindings.sets) {
+			if (le::utils::contains(c.dynamicSets, set) && !makeDynamic(binds)) {
+				g_log.log(lvl::warning, 1, "[{}] Set [{}] of [{}] has non-buffer bindings; cannot use dynamic offsets", g_name, set, shader.m_name);
+			}
 			std::vector<vk::DescriptorSetLayoutBinding> bindings;
 			for (auto& setBinding : binds) {
 				if (!setBinding.bUnassigned) { bindings.push_back(setBinding.binding); }
@@ -0,0 +1,73 @@
+#include <algorithm>
+#include <cstring>
+#include <graphics/common.hpp>
+#include <graphics/context/device.hpp>
+#include <graphics/context/vram.hpp>
+#include <graphics/render/uniform_arena.hpp>
+
+namespace le::graphics {
+namespace {
+constexpr vk::DeviceSize alignUp(vk::DeviceSize size, vk::DeviceSize align) noexcept { return (size + align - 1) & ~(align - 1); }
+} // namespace
+
+UniformArena::UniformArena(not_null<VRAM*> vram, CreateInfo const& info) : m_vram(vram) {
+	auto const& limits = vram->m_device->physicalDevice().properties.limits;
+	m_storage.alignment = std::max({vk::DeviceSize(16), limits.minUniformBufferOffsetAlignment, limits.minStorageBufferOffsetAlignment});
+	m_storage.blockSize = alignUp(std::max(info.blockSize, m_storage.alignment), m_storage.alignment);
+	m_storage.usage = info.usage;
+	for (Buffering buf{}; buf < info.buffering; ++buf.value) {
+		Frame frame;
+		frame.blocks.push_back(makeBlock(m_storage.blockSize));
+		m_storage.frames.push(std::move(frame));
+	}
+	g_log.log(lvl::info, 1, "[{}] UniformArena constructed [{} x {} bytes]", g_name, info.buffering.value, m_storage.blockSize);
+}
+
+UniformArena::Slice UniformArena::allocate(vk::DeviceSize size) {
+	if (size == 0) { return {}; }
+	Frame& frame = m_storage.frames.get();
+	vk::DeviceSize const aligned = alignUp(size, m_storage.alignment);
+	while (frame.active < frame.blocks.size() && frame.blocks[frame.active].head + aligned > frame.blocks[frame.active].buffer.writeSize()) {
+		++frame.active;
+	}
+	if (frame.active == frame.blocks.size()) {
+		frame.blocks.push_back(makeBlock(std::max(m_storage.blockSize, aligned)));
+		g_log.log(lvl::debug, 1, "[{}] UniformArena grown to [{}] blocks", g_name, frame.blocks.size());
+	}
+	Block& block = frame.blocks[frame.active];
+	Slice ret;
+	ret.buffer = block.buffer.buffer();
+	ret.offset = block.head;
+	ret.size = size;
+	ret.pData = (u8*)block.buffer.mapped() + block.head;
+	block.head += aligned;
+	frame.used += aligned;
+	m_stats.used = frame.used;
+	m_stats.highWater = std::max(m_stats.highWater, frame.used);
+	return ret;
+}
+
+UniformArena::Slice UniformArena::write(void const* pData, vk::DeviceSize size) {
+	auto ret = allocate(size);
+	if (ret.valid()) { std::memcpy(ret.pData, pData, (std::size_t)size); }
+	return ret;
+}
+
+void UniformArena::next() {
+	m_storage.frames.next();
+	Frame& frame = m_storage.frames.get();
+	for (Block& block : frame.blocks) { block.head = 0; }
+	frame.active = 0;
+	frame.used = 0;
+	m_stats.used = 0;
+}
+
+UniformArena::Block UniformArena::makeBlock(vk::DeviceSize size) {
+	Block ret{m_vram->makeBuffer(size, m_storage.usage, true)};
+	[[maybe_unused]] bool const bMapped = ret.buffer.map() != nullptr;
+	ensure(bMapped, "Memory map failed");
+	m_stats.capacity += size;
+	++m_stats.blocks;
+	return ret;
+}
+} // namespace le::graphics
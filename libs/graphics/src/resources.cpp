@@ -49,11 +49,12 @@ Memory::~Memory() {
 	g_log.log(lvl::info, 1, "[{}] Memory destroyed", g_name);
 }
 
-void Memory::copy(vk::CommandBuffer cb, vk::Buffer src, vk::Buffer dst, vk::DeviceSize size) {
+void Memory::copy(vk::CommandBuffer cb, vk::Buffer src, vk::Buffer dst, vk::DeviceSize size, vk::DeviceSize srcOffset) {
 	vk::CommandBufferBeginInfo beginInfo;
 	beginInfo.flags = vk::CommandBufferUsageFlagBits::eOneTimeSubmit;
 	cb.begin(beginInfo);
 	vk::BufferCopy copyRegion;
+	copyRegion.srcOffset = srcOffset;
 	copyRegion.size = size;
 	cb.copyBuffer(src, dst, copyRegion);
 	cb.end();
@@ -84,6 +85,10 @@ void Memory::blit(vk::CommandBuffer cb, vk::Image src, vk::Image dst, TPair<vk::
 }
 
 void Memory::imageBarrier(vk::CommandBuffer cb, vk::Image image, ImgMeta const& meta) {
+	cb.pipelineBarrier(meta.stages.first, meta.stages.second, {}, {}, {}, imageMemoryBarrier(image, meta));
+}
+
+vk::ImageMemoryBarrier Memory::imageMemoryBarrier(vk::Image image, ImgMeta const& meta) {
 	vk::ImageMemoryBarrier barrier;
 	barrier.oldLayout = meta.layouts.first;
 	barrier.newLayout = meta.layouts.second;
@@ -97,7 +102,19 @@ void Memory::imageBarrier(vk::CommandBuffer cb, vk::Image image, ImgMeta const&
 	barrier.subresourceRange.layerCount = meta.layerCount;
 	barrier.srcAccessMask = meta.access.first;
 	barrier.dstAccessMask = meta.access.second;
-	cb.pipelineBarrier(meta.stages.first, meta.stages.second, {}, {}, {}, barrier);
+	return barrier;
+}
+
+TPair<Memory::ImgMeta> Memory::copyBarriers(ImgMeta const& meta) {
+	using vkstg = vk::PipelineStageFlagBits;
+	ImgMeta first = meta, second = meta;
+	first.layouts.second = vk::ImageLayout::eTransferDstOptimal;
+	first.access.second = vk::AccessFlagBits::eTransferWrite;
+	first.stages = {vkstg::eTopOfPipe | meta.stages.first, vkstg::eTransfer};
+	second.layouts.first = vk::ImageLayout::eTransferDstOptimal;
+	second.access.first = vk::AccessFlagBits::eTransferRead;
+	second.stages = {vkstg::eTransfer, vkstg::eBottomOfPipe | meta.stages.second};
+	return {first, second};
 }
 
 vk::BufferImageCopy Memory::bufferImageCopy(vk::Extent3D extent, vk::ImageAspectFlags aspects, vk::DeviceSize offset, u32 layerIdx, u32 layerCount) {
@@ -115,17 +132,10 @@ vk::BufferImageCopy Memory::bufferImageCopy(vk::Extent3D extent, vk::ImageAspect
 }
 
 void Memory::copy(vk::CommandBuffer cb, vk::Buffer src, vk::Image dst, vAP<vk::BufferImageCopy> regions, ImgMeta const& meta) {
-	using vkstg = vk::PipelineStageFlagBits;
 	vk::CommandBufferBeginInfo beginInfo;
 	beginInfo.flags = vk::CommandBufferUsageFlagBits::eOneTimeSubmit;
 	cb.begin(beginInfo);
-	ImgMeta first = meta, second = meta;
-	first.layouts.second = vk::ImageLayout::eTransferDstOptimal;
-	first.access.second = vk::AccessFlagBits::eTransferWrite;
-	first.stages = {vkstg::eTopOfPipe | meta.stages.first, vkstg::eTransfer};
-	second.layouts.first = vk::ImageLayout::eTransferDstOptimal;
-	second.access.first = vk::AccessFlagBits::eTransferRead;
-	second.stages = {vkstg::eTransfer, vkstg::eBottomOfPipe | meta.stages.second};
+	auto const [first, second] = copyBarriers(meta);
 	imageBarrier(cb, dst, first);
 	cb.copyBufferToImage(src, dst, vk::ImageLayout::eTransferDstOptimal, regions);
 	imageBarrier(cb, dst, second);
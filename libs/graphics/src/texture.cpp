@@ -57,6 +57,8 @@ bool Texture::construct(CreateInfo const& info) {
 
 bool Texture::valid() const noexcept { return m_storage.image.has_value(); }
 
+u64 Texture::bytes() const noexcept { return valid() ? u64(m_storage.image->allocatedSize()) : 0; }
+
 bool Texture::busy() const { return valid() && m_storage.transfer.busy(); }
 
 bool Texture::ready() const { return valid() && m_storage.transfer.ready(true); }
@@ -72,29 +74,29 @@ Image const& Texture::image() const {
 
 bool Texture::construct(CreateInfo const& info, Storage& out_storage) {
 	if (Device::default_v(info.sampler)) { return false; }
-	auto const* pImg = std::get_if<Img>(&info.data);
-	auto const* pCube = std::get_if<Cubemap>(&info.data);
 	auto const* pRaw = std::get_if<Bitmap>(&info.data);
-	if ((!pRaw || pRaw->bytes.empty()) && (!pImg || pImg->empty()) && !pCube) { return false; }
-	if (pCube) {
-		if (std::any_of(pCube->begin(), pCube->end(), [](Bitmap::type const& b) { return b.empty(); })) { return false; }
+	kt::fixed_vector<BMPview, 6> compressed;
+	if (auto const* pImg = std::get_if<Img>(&info.data)) {
+		compressed.push_back(*pImg);
+	} else if (auto const* pImgView = std::get_if<ImgView>(&info.data)) {
+		compressed.push_back(*pImgView);
+	} else if (auto const* pCube = std::get_if<Cubemap>(&info.data)) {
+		for (auto const& bytes : *pCube) { compressed.push_back(bytes); }
+	} else if (auto const* pCubeView = std::get_if<CubemapView>(&info.data)) {
+		for (auto const bytes : *pCubeView) { compressed.push_back(bytes); }
 	}
+	if ((!pRaw || pRaw->bytes.empty()) && compressed.empty()) { return false; }
+	if (std::any_of(compressed.begin(), compressed.end(), [](BMPview b) { return b.empty(); })) { return false; }
 	out_storage.data.sampler = info.sampler;
 	vk::Format fallback;
 	kt::fixed_vector<BMPview, 6> bmps;
 	kt::fixed_vector<utils::STBImg, 6> stbimgs;
-	if (pCube || pImg) {
-		if (pCube) {
-			for (auto const& bytes : *pCube) {
-				stbimgs.push_back(utils::STBImg(bytes));
-				bmps.push_back(stbimgs.back().bytes);
-				out_storage.data.type = Type::eCube;
-			}
-		} else {
-			stbimgs.push_back(utils::STBImg(*pImg));
+	if (!compressed.empty()) {
+		for (BMPview const bytes : compressed) {
+			stbimgs.push_back(utils::STBImg(bytes));
 			bmps.push_back(stbimgs.back().bytes);
-			out_storage.data.type = Type::e2D;
 		}
+		out_storage.data.type = compressed.size() > 1 ? Type::eCube : Type::e2D;
 		out_storage.data.size = {stbimgs.back().size.x, stbimgs.back().size.y};
 		fallback = info.payload == Payload::eColour ? srgb : linear;
 	} else {
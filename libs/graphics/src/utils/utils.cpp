@@ -215,7 +215,7 @@ Bitmap::type utils::convert(Span<u8 const> bytes) {
 	return ret;
 }
 
-utils::STBImg::STBImg(Bitmap::type const& compressed, u8 channels) {
+utils::STBImg::STBImg(BMPview compressed, u8 channels) {
 	ensure(compressed.size() <= (std::size_t)maths::max<int>(), "size too large!");
 	auto pIn = reinterpret_cast<stbi_uc const*>(compressed.data());
 	int w, h, ch;
@@ -0,0 +1,238 @@
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <limits>
+#include <unordered_map>
+#include <dumb_json/json.hpp>
+#include <engine/assets/asset_graph.hpp>
+#include <engine/utils/logger.hpp>
+
+namespace le {
+namespace {
+// last whitespace separated token (texture options precede the filename)
+std::string_view lastToken(std::string_view line) {
+	while (!line.empty() && std::isspace((unsigned char)line.back())) { line.remove_suffix(1); }
+	auto const space = line.find_last_of(" \t");
+	return space == std::string_view::npos ? line : line.substr(space + 1);
+}
+} // namespace
+
+std::vector<AssetDepends::Res> detail::modelSources(io::Path const& jsonID, AssetDepends::Res const& res, std::string_view text) {
+	std::vector<AssetDepends::Res> ret;
+	auto const dir = jsonID.parent_path();
+	if (res.path == jsonID) {
+		dj::json_t json;
+		if (auto result = json.read(text); result.failure || !result.errors.empty()) { return ret; }
+		if (auto pObj = json.find("obj")) { ret.push_back({dir / pObj->as<std::string>(), Resource::Type::eText}); }
+		if (auto pMtl = json.find("mtl")) { ret.push_back({dir / pMtl->as<std::string>(), Resource::Type::eText}); }
+		if (auto pBaked = json.find("baked")) { ret.push_back({dir / pBaked->as<std::string>(), Resource::Type::eBinary}); }
+	} else if (res.path.extension() == ".mtl") {
+		static constexpr std::array maps = {"map_Kd", "map_Ks", "map_d", "map_Bump", "map_bump", "bump"};
+		for (std::size_t begin = 0; begin < text.size();) {
+			auto const end = std::min(text.find('\n', begin), text.size());
+			std::string_view line = text.substr(begin, end - begin);
+			begin = end + 1;
+			while (!line.empty() && std::isspace((unsigned char)line.front())) { line.remove_prefix(1); }
+			auto const key = line.substr(0, line.find_first_of(" \t"));
+			if (key.size() < line.size() && std::find(maps.begin(), maps.end(), key) != maps.end()) {
+				// textures are relative to the json (see OBJReader)
+				ret.push_back({dir / std::string(lastToken(line.substr(key.size()))), Resource::Type::eBinary});
+			}
+		}
+	}
+	return ret;
+}
+
+std::vector<AssetDepends::Res> detail::fontAtlas(io::Path const& jsonID, AssetDepends::Res const& res, std::string_view text) {
+	std::vector<AssetDepends::Res> ret;
+	if (res.path == jsonID) {
+		dj::json_t json;
+		if (auto result = json.read(text); result.failure || !result.errors.empty()) { return ret; }
+		if (auto pAtlas = json.find("sheetID")) { ret.push_back({jsonID.parent_path() / pAtlas->as<std::string>(), Resource::Type::eBinary}); }
+	}
+	return ret;
+}
+
+struct AssetGraphLoader::State {
+	// wall-clock span of a phase, in us since start
+	struct Phase {
+		std::atomic<s64> begin = std::numeric_limits<s64>::max();
+		std::atomic<s64> end = 0;
+
+		void record(s64 from, s64 to) noexcept {
+			for (s64 b = begin.load(); from < b && !begin.compare_exchange_weak(b, from);) {}
+			for (s64 e = end.load(); to > e && !end.compare_exchange_weak(e, to);) {}
+		}
+
+		Time_ms span() const noexcept {
+			s64 const b = begin.load(), e = end.load();
+			return e > b ? time::cast<Time_ms>(Time_us(e - b)) : Time_ms();
+		}
+	};
+
+	Phase io;
+	Phase decode;
+	Phase upload;
+	std::atomic<s64> totalUs = 0;
+	std::atomic<std::size_t> remaining = 0;
+	std::atomic<std::size_t> failed = 0;
+	std::size_t count = 0;
+	time::Point start = time::now();
+
+	s64 elapsed() const noexcept { return time::diff<Time_us>(start).count(); }
+
+	void prefetch(Node& out_node) {
+		s64 const from = elapsed();
+		auto& resources = out_node.store->resources();
+		auto const& named = out_node.depends.named;
+		std::vector<AssetDepends::Res> queue = out_node.depends.resources;
+		for (std::size_t idx = 0; idx < queue.size(); ++idx) {
+			auto const res = queue[idx];
+			// named resources may legitimately be absent (eg a baked blob before the first bake)
+			if (idx >= out_node.depends.resources.size() && !resources.reader().present(res.path)) { continue; }
+			// monitored as the asset loaders request them; cached Resources are returned by subsequent loads
+			auto const policy = Resource::Policy::eMonitored;
+			if (auto pRes = resources.load(res.path, res.type, policy)) {
+				if (pRes->transient(policy)) {
+					out_node.transient.push_back(res.path);
+				} else if (pRes->watched(policy)) {
+					out_node.watched.push_back(res.path);
+				}
+				if (named.infer && res.type == Resource::Type::eText) {
+					for (auto& next : named.infer(named.jsonID, res, pRes->string())) {
+						auto const same = [&next](AssetDepends::Res const& r) { return r.path == next.path; };
+						if (std::none_of(queue.begin(), queue.end(), same)) { queue.push_back(std::move(next)); }
+					}
+				}
+			}
+		}
+		io.record(from, elapsed());
+	}
+
+	void load(Node& out_node) {
+		s64 const from = elapsed();
+		if (!out_node.decode()) { ++failed; }
+		// the loader holds its own references: prefetched resources are freed here (unless shared with other loads / assets)
+		for (Hash const id : out_node.transient) { out_node.store->resources().release(id); }
+		for (Hash const id : out_node.watched) { out_node.store->resources().unwatch(id); }
+		out_node.transient.clear();
+		out_node.watched.clear();
+		decode.record(from, elapsed());
+	}
+
+	void wait(Node& out_node) {
+		s64 const from = elapsed();
+		out_node.upload();
+		upload.record(from, elapsed());
+		if (--remaining == 0) {
+			totalUs = elapsed();
+			utils::g_log.log(dl::level::info, 1, "[Assets] [{}] loaded in [{}ms] (spans: I/O [{}ms], decode [{}ms], upload [{}ms]; failed: [{}])", count,
+							 totalUs / 1000, io.span().count(), decode.span().count(), upload.span().count(), failed.load());
+		}
+	}
+};
+
+std::size_t AssetGraphLoader::stage(Scheduler& scheduler) {
+	auto const order = sorted();
+	auto state = begin();
+	std::unordered_map<Hash, StageID> decodes;
+	for (std::size_t const idx : order) {
+		auto node = std::make_shared<Node>(std::move(m_nodes[idx]));
+		Scheduler::stage_t decode;
+		if (!node->depends.resources.empty()) {
+			Scheduler::stage_t io;
+			io.tasks.push_back([state, node]() { state->prefetch(*node); });
+			decode.deps.push_back(scheduler.stage(std::move(io)));
+		}
+		for (Hash const dep : node->depends.assets) {
+			if (auto it = decodes.find(dep); it != decodes.end()) { decode.deps.push_back(it->second); }
+		}
+		Hash const id = node->id;
+		decode.tasks.push_back([state, node]() { state->load(*node); });
+		auto const decoded = scheduler.stage(std::move(decode));
+		decodes.emplace(id, decoded);
+		Scheduler::stage_t upload;
+		upload.deps.push_back(decoded);
+		upload.tasks.push_back([state, node]() { state->wait(*node); });
+		m_staged.push_back(decoded);
+		m_staged.push_back(scheduler.stage(std::move(upload)));
+	}
+	m_nodes.clear();
+	return order.size();
+}
+
+std::size_t AssetGraphLoader::load() {
+	auto const order = sorted();
+	auto state = begin();
+	for (std::size_t const idx : order) {
+		state->prefetch(m_nodes[idx]);
+		state->load(m_nodes[idx]);
+		state->wait(m_nodes[idx]);
+	}
+	m_nodes.clear();
+	return order.size();
+}
+
+bool AssetGraphLoader::ready(Scheduler const* scheduler) const noexcept {
+	if (!m_staged.empty()) {
+		ensure(scheduler, "Scheduler required to check staged tasks");
+		return scheduler->stages_done(m_staged);
+	}
+	return true;
+}
+
+AssetGraphLoader::Timings AssetGraphLoader::timings() const noexcept {
+	Timings ret;
+	if (m_state) {
+		ret.io = m_state->io.span();
+		ret.decode = m_state->decode.span();
+		ret.upload = m_state->upload.span();
+		ret.total = time::cast<Time_ms>(Time_us(m_state->totalUs.load()));
+		ret.count = m_state->count;
+		ret.failed = m_state->failed.load();
+	}
+	return ret;
+}
+
+std::vector<std::size_t> AssetGraphLoader::sorted() const {
+	// Kahn's algorithm over dependencies present in the graph (stable: insertion order among ready nodes)
+	std::unordered_map<Hash, std::size_t> indices;
+	for (std::size_t idx = 0; idx < m_nodes.size(); ++idx) { indices.emplace(m_nodes[idx].id, idx); }
+	std::vector<std::vector<std::size_t>> dependents(m_nodes.size());
+	std::vector<std::size_t> pending(m_nodes.size(), 0);
+	for (std::size_t idx = 0; idx < m_nodes.size(); ++idx) {
+		for (Hash const dep : m_nodes[idx].depends.assets) {
+			if (auto it = indices.find(dep); it != indices.end() && it->second != idx) {
+				dependents[it->second].push_back(idx);
+				++pending[idx];
+			}
+		}
+	}
+	std::vector<std::size_t> ret;
+	ret.reserve(m_nodes.size());
+	for (std::size_t idx = 0; idx < m_nodes.size(); ++idx) {
+		if (pending[idx] == 0) { ret.push_back(idx); }
+	}
+	for (std::size_t head = 0; head < ret.size(); ++head) {
+		for (std::size_t const dependent : dependents[ret[head]]) {
+			if (--pending[dependent] == 0) { ret.push_back(dependent); }
+		}
+	}
+	if (ret.size() < m_nodes.size()) {
+		for (std::size_t idx = 0; idx < m_nodes.size(); ++idx) {
+			if (pending[idx] > 0) {
+				utils::g_log.log(dl::level::warning, 0, "[Assets] Dependency cycle involving [{}]; loading unordered", m_nodes[idx].id);
+				ret.push_back(idx);
+			}
+		}
+	}
+	return ret;
+}
+
+std::shared_ptr<AssetGraphLoader::State> AssetGraphLoader::begin() {
+	m_state = std::make_shared<State>();
+	m_state->count = m_nodes.size();
+	m_state->remaining = m_nodes.size();
+	return m_state;
+}
+} // namespace le
@@ -60,7 +60,7 @@ std::optional<AssetLoader<graphics::Shader>::Data> AssetLoader<graphics::Shader>
 					path = graphics::utils::spirVpath(id);
 				} else {
 					// ensure resource presence (and add monitor if supported)
-					if (!info.resource(id, Resource::Type::eText, true)) { return std::nullopt; }
+					if (!info.resource(id, Resource::Type::eText, Resource::Policy::eMonitored)) { return std::nullopt; }
 					path = spirvPath(id, *fr);
 				}
 			} else {
@@ -68,9 +68,10 @@ std::optional<AssetLoader<graphics::Shader>::Data> AssetLoader<graphics::Shader>
 				path = graphics::utils::spirVpath(id);
 			}
 		}
-		auto pRes = info.resource(path, Resource::Type::eBinary, false, true);
+		auto pRes = info.resource(path, Resource::Type::eBinary, Resource::Policy::eTransient, true);
 		if (!pRes) { return std::nullopt; }
-		spirV[type] = {pRes->bytes().begin(), pRes->bytes().end()};
+		// view into the Resource: Shader copies it once into aligned SPIR-V code
+		spirV[type] = pRes->bytes();
 	}
 	return spirV;
 }
@@ -80,6 +81,7 @@ std::optional<graphics::Pipeline> AssetLoader<graphics::Pipeline>::load(AssetLoa
 		info.reloadDepend(*shader);
 		auto pipeInfo = info.m_data.info ? *info.m_data.info : info.m_data.context->pipeInfo(info.m_data.flags);
 		pipeInfo.renderPass = info.m_data.gui ? info.m_data.context->renderer().renderPassUI() : info.m_data.context->renderer().renderPass3D();
+		if (!info.m_data.dynamicSets.empty()) { pipeInfo.dynamicSets = info.m_data.dynamicSets; }
 		return info.m_data.context->makePipeline(info.m_data.name, shader->get(), pipeInfo);
 	}
 	return std::nullopt;
@@ -129,16 +131,16 @@ std::optional<AssetLoader<graphics::Texture>::Data> AssetLoader<graphics::Textur
 	} else if (info.m_data.imageIDs.size() == 1) {
 		auto path = info.m_data.prefix / info.m_data.imageIDs[0];
 		path += info.m_data.ext;
-		if (auto pRes = info.resource(path, Resource::Type::eBinary, true)) { return graphics::Texture::Img{pRes->bytes().begin(), pRes->bytes().end()}; }
+		if (auto pRes = info.resource(path, Resource::Type::eBinary, Resource::Policy::eMonitored)) { return graphics::Texture::ImgView(pRes->bytes()); }
 	} else if (info.m_data.imageIDs.size() == 6) {
-		graphics::Texture::Cubemap cubemap;
+		graphics::Texture::CubemapView cubemap;
 		std::size_t idx = 0;
 		for (auto const& p : info.m_data.imageIDs) {
 			auto path = info.m_data.prefix / p;
 			path += info.m_data.ext;
-			auto pRes = info.resource(path, Resource::Type::eBinary, true);
+			auto pRes = info.resource(path, Resource::Type::eBinary, Resource::Policy::eMonitored);
 			if (!pRes) { return std::nullopt; }
-			cubemap[idx++] = {pRes->bytes().begin(), pRes->bytes().end()};
+			cubemap[idx++] = pRes->bytes();
 		}
 		return cubemap;
 	}
@@ -196,12 +198,12 @@ bool AssetLoader<BitmapFont>::reload(BitmapFont& out_font, AssetLoadInfo<BitmapF
 bool AssetLoader<BitmapFont>::load(BitmapFont& out_font, AssetLoadInfo<BitmapFont> const& info) const {
 	auto const sampler = info.m_store->find<graphics::Sampler>(info.m_data.samplerID);
 	if (!sampler) { return false; }
-	if (auto text = info.resource(info.m_data.jsonID, Resource::Type::eText, true)) {
+	if (auto text = info.resource(info.m_data.jsonID, Resource::Type::eText, Resource::Policy::eMonitored)) {
 		dj::json_t json;
 		auto result = json.read(text->string());
 		if (result && result.errors.empty()) {
 			FontInfo const fi = deserialise(json);
-			auto const atlas = info.resource(info.m_data.jsonID.parent_path() / fi.atlasID, Resource::Type::eBinary, true);
+			auto const atlas = info.resource(info.m_data.jsonID.parent_path() / fi.atlasID, Resource::Type::eBinary, Resource::Policy::eMonitored);
 			if (!atlas) { return false; }
 			BitmapFont::CreateInfo bci;
 			bci.forceFormat = info.m_data.forceFormat;
@@ -213,12 +215,49 @@ bool AssetLoader<BitmapFont>::load(BitmapFont& out_font, AssetLoadInfo<BitmapFon
 	return false;
 }
 
+namespace {
+///
+/// \brief Reads via the load's Resources: cached (eg prefetched) resources are reused, and released with the load
+///
+template <typename T>
+class ResourceReader final : public io::Reader {
+  public:
+	ResourceReader(AssetLoadInfo<T> const& info) : m_info(info) { m_medium = info.reader().medium(); }
+
+	Result<bytearray> bytes(io::Path const& id) const override {
+		if (auto res = m_info.resource(id, Resource::Type::eBinary, Resource::Policy::eTransient)) {
+			auto const bytes = res->bytes();
+			return bytearray(bytes.begin(), bytes.end());
+		}
+		return kt::null_result;
+	}
+	Result<std::stringstream> sstream(io::Path const& id) const override {
+		if (auto res = m_info.resource(id, Resource::Type::eText, Resource::Policy::eMonitored)) { return std::stringstream(std::string(res->string())); }
+		return kt::null_result;
+	}
+	// transient references are held until the load completes (textures are constructed before then)
+	Result<io::ByteView> view(io::Path const& id) const override {
+		if (auto res = m_info.resource(id, Resource::Type::eBinary, Resource::Policy::eTransient)) { return io::ByteView{res->bytes(), {}}; }
+		return kt::null_result;
+	}
+
+  private:
+	Result<io::Path> findPrefixed(io::Path const& id) const override {
+		if (m_info.reader().present(id)) { return id; }
+		return kt::null_result;
+	}
+
+	AssetLoadInfo<T> const& m_info;
+};
+} // namespace
+
 std::optional<Model> AssetLoader<Model>::load(AssetLoadInfo<Model> const& info) const {
 	auto const sampler = info.m_store->find<graphics::Sampler>(info.m_data.samplerID);
 	if (!sampler) { return std::nullopt; }
-	if (auto mci = Model::load(info.m_data.modelID, info.m_data.jsonID, info.reader())) {
+	ResourceReader<Model> const reader(info);
+	if (auto mci = Model::load(info.m_data.modelID, info.m_data.jsonID, reader, &info.reader())) {
 		Model model;
-		if (model.construct(info.m_data.vram, *mci, sampler->get(), info.m_data.forceFormat)) { return model; }
+		if (model.construct(info.m_data.vram, std::move(mci).value(), sampler->get(), info.m_data.forceFormat)) { return model; }
 	}
 	return std::nullopt;
 }
@@ -226,7 +265,8 @@ std::optional<Model> AssetLoader<Model>::load(AssetLoadInfo<Model> const& info)
 bool AssetLoader<Model>::reload(Model& out_model, AssetLoadInfo<Model> const& info) const {
 	auto const sampler = info.m_store->find<graphics::Sampler>(info.m_data.samplerID);
 	if (!sampler) { return false; }
-	if (auto mci = Model::load(info.m_data.modelID, info.m_data.jsonID, info.reader())) {
+	ResourceReader<Model> const reader(info);
+	if (auto mci = Model::load(info.m_data.modelID, info.m_data.jsonID, reader, &info.reader())) {
 		return out_model.construct(info.m_data.vram, std::move(mci).value(), sampler->get(), info.m_data.forceFormat).has_value();
 	}
 	return false;
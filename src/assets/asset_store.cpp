@@ -3,30 +3,219 @@
 namespace le {
 AssetStore::~AssetStore() { clear(); }
 
-void AssetStore::update() {
+namespace detail {
+namespace {
+thread_local u32 t_resourceLocks = 0;
+}
+
+ResourceLock::ResourceLock(std::shared_mutex& mutex, Mode mode) : m_mutex(&mutex), m_mode(mode) {
+	if (t_resourceLocks == 0) {
+		if (mode == Mode::eTryUnique) {
+			m_locked = mutex.try_lock();
+			if (!m_locked) { return; }
+		} else {
+			mutex.lock_shared();
+			m_locked = true;
+		}
+	}
+	++t_resourceLocks;
+	m_held = true;
+}
+
+ResourceLock::~ResourceLock() {
+	if (!m_held) { return; }
+	--t_resourceLocks;
+	if (m_locked) {
+		if (m_mode == Mode::eTryUnique) {
+			m_mutex->unlock();
+		} else {
+			m_mutex->unlock_shared();
+		}
+	}
+}
+
+std::size_t nextTypeIndex() noexcept {
+	static std::atomic<std::size_t> s_next = 0;
+	return s_next++;
+}
+
+void ReloadGraph::build() {
+	// Tarjan's algorithm (iterative): components with more than one asset are cycles
+	struct Link {
+		std::size_t index = 0;
+		std::size_t low = 0;
+		bool bStacked = false;
+	};
+	struct Visit {
+		Hash id;
+		std::size_t next = 0;
+	};
+	std::unordered_map<Hash, Link> links;
+	std::vector<Hash> stack;
+	std::vector<Visit> visits;
+	auto visit = [&links, &stack, &visits](Hash id) {
+		auto const index = links.size();
+		links[id] = {index, index, true};
+		stack.push_back(id);
+		visits.push_back({id});
+	};
+	cycles.clear();
+	std::size_t cycle = 0;
+	for (auto const& [root, _] : depends) {
+		if (links.contains(root)) { continue; }
+		visit(root);
+		while (!visits.empty()) {
+			Hash const id = visits.back().id;
+			auto const it = depends.find(id);
+			if (it != depends.end() && visits.back().next < it->second.size()) {
+				Hash const dep = it->second[visits.back().next++];
+				if (auto l = links.find(dep); l == links.end()) {
+					visit(dep);
+				} else if (l->second.bStacked) {
+					links[id].low = std::min(links[id].low, l->second.index);
+				}
+				continue;
+			}
+			visits.pop_back();
+			Link const link = links[id];
+			if (!visits.empty()) {
+				auto& parent = links[visits.back().id];
+				parent.low = std::min(parent.low, link.low);
+			}
+			if (link.low == link.index) {
+				// root of a component: pop its members
+				auto const first = std::find(stack.begin(), stack.end(), id);
+				bool const bCycle = stack.end() - first > 1;
+				if (bCycle) { ++cycle; }
+				for (auto member = first; member != stack.end(); ++member) {
+					links[*member].bStacked = false;
+					if (bCycle) { cycles[*member] = cycle; }
+				}
+				stack.erase(first, stack.end());
+			}
+		}
+	}
+	std::unordered_set<std::size_t> dirtyCycles;
+	for (auto const& [id, index] : cycles) {
+		if (dirty.contains(id)) { dirtyCycles.insert(index); }
+	}
+	for (auto const& [id, index] : cycles) {
+		if (dirtyCycles.contains(index)) { dirty.insert(id); }
+	}
+}
+
+std::size_t ReloadGraph::cycle(Hash id) const noexcept {
+	if (auto it = cycles.find(id); it != cycles.end()) { return it->second; }
+	return 0;
+}
+
+bool ReloadGraph::blocked(Hash id) const {
+	std::size_t const own = cycle(id);
+	std::unordered_set<Hash> visited;
+	std::vector<Hash> stack;
+	auto push = [this, &visited, &stack](Hash id) {
+		if (auto it = depends.find(id); it != depends.end()) {
+			for (Hash const dep : it->second) {
+				if (visited.insert(dep).second) { stack.push_back(dep); }
+			}
+		}
+	};
+	push(id);
+	while (!stack.empty()) {
+		Hash const dep = stack.back();
+		stack.pop_back();
+		// members of the same cycle are reloaded together
+		if (dep != id && dirty.contains(dep) && (own == 0 || cycle(dep) != own)) { return true; }
+		push(dep);
+	}
+	return false;
+}
+} // namespace detail
+
+ResidencyStats& ResidencyStats::operator+=(ResidencyStats const& rhs) noexcept {
+	resident += rhs.resident;
+	evicted += rhs.evicted;
+	vram += rhs.vram;
+	cpu += rhs.cpu;
+	evictions += rhs.evictions;
+	restores += rhs.restores;
+	return *this;
+}
+
+ResidencyStats AssetStore::residency() const {
+	ResidencyStats ret;
+	for (auto const* map : m_assets.maps()) { ret += map->residency(); }
+	return ret;
+}
+
+void AssetStore::update(Scheduler* scheduler) {
 	static constexpr u32 maxPasses = 10;
-	bool bIdle = false;
-	u64 total = 0;
-	u32 pass = 0;
-	kt::tlock lock(m_assets);
-	for (; pass < maxPasses && (pass == 0 || !bIdle); ++pass) {
-		m_resources.update();
-		u64 reloaded = 0;
-		for (auto& [_, store] : lock->storeMap) { reloaded += store->update(*this); }
-		bIdle = reloaded == 0;
-		total += reloaded;
-		if (!bIdle) { utils::g_log.log(dl::level::debug, 2, "[Assets] [{}] Update pass: reloaded [{}]", pass, reloaded); }
+	auto const maps = m_assets.maps();
+	// frame boundary: swap in completed reloads, then notify dependents
+	std::vector<Hash> swapped;
+	std::size_t inFlight = 0;
+	{
+		auto reload = reloadLock();
+		for (auto* map : maps) { inFlight += map->commit(swapped); }
+	}
+	if (!swapped.empty()) {
+		auto onModified = kt::tlock(m_onModified);
+		for (Hash const id : swapped) { onModified.get()[id](); }
+		utils::g_log.log(dl::level::info, 1, "[Assets] [{}] Reloads swapped in", swapped.size());
 	}
-	if (!bIdle && pass == maxPasses) {
-		utils::g_log.log(dl::level::warning, 0, "[Assets] Exceeded max update passes [{}], bailing out... Asset(s) stuck in reload loops?", maxPasses);
-	} else if (total > 0) {
-		utils::g_log.log(dl::level::info, 1, "[Assets] [{}] Reloads completed in [{}] passes", total, pass);
+	// workers read monitored Resources: only poll / dispatch when no reloads / restores are in flight
+	detail::ResourceLock const resources(m_resourceMutex, detail::ResourceLock::Mode::eTryUnique);
+	if (!resources) { utils::g_log.log(dl::level::debug, 2, "[Assets] Restores in flight, skipping reloads"); }
+	if (inFlight == 0 && resources) {
+		bool bIdle = false;
+		u64 total = 0;
+		u32 pass = 0;
+		Scheduler::stage_t stage;
+		for (; pass < maxPasses && (pass == 0 || !bIdle); ++pass) {
+			m_resources.update();
+			detail::ReloadGraph graph;
+			for (auto const* map : maps) { map->collect(graph); }
+			if (graph.dirty.empty()) { break; }
+			graph.build();
+			u64 reloaded = 0;
+			std::vector<Hash> cyclic;
+			for (auto* map : maps) {
+				auto const dispatched = map->dispatch(*this, graph, scheduler ? &stage : nullptr);
+				inFlight += dispatched.staged;
+				reloaded += dispatched.reloaded;
+				cyclic.insert(cyclic.end(), dispatched.cyclic.begin(), dispatched.cyclic.end());
+			}
+			// cycles were reloaded as units: drop the dirty flags their members set on each other
+			if (!cyclic.empty()) {
+				for (auto* map : maps) { map->settle(cyclic); }
+			}
+			// synchronous reloads may have dirtied dependents: run another pass unless some are in flight
+			bIdle = reloaded == 0 || inFlight > 0;
+			total += reloaded;
+			if (reloaded > 0) { utils::g_log.log(dl::level::debug, 2, "[Assets] [{}] Update pass: reloaded [{}]", pass, reloaded); }
+		}
+		if (!bIdle && pass == maxPasses) {
+			utils::g_log.log(dl::level::warning, 0, "[Assets] Exceeded max update passes [{}], bailing out... Asset(s) stuck in reload loops?", maxPasses);
+		} else if (total > 0) {
+			utils::g_log.log(dl::level::info, 1, "[Assets] [{}] Reloads completed in [{}] passes", total, pass);
+		}
+		if (!stage.tasks.empty()) {
+			utils::g_log.log(dl::level::info, 1, "[Assets] [{}] Reloads staged", stage.tasks.size());
+			scheduler->stage(std::move(stage));
+		}
 	}
+	m_inFlight.store(inFlight);
+	// residency: evict least recently used (not used since the previous update) over budget
+	auto const epoch = m_epoch.load();
+	u64 evicted = 0;
+	for (auto* map : maps) { evicted += map->evict(epoch); }
+	if (evicted > 0) { utils::g_log.log(dl::level::info, 1, "[Assets] [{}] Evicted", evicted); }
+	m_epoch.store(epoch + 1);
 }
 
 void AssetStore::clear() {
 	// Reset infos and assets before delegates (may contain OnModified tokens)
-	kt::unique_tlock<detail::TAssets>(m_assets)->storeMap.clear();
+	for (auto* map : m_assets.maps()) { map->clear(); }
 	// Clear delegates
 	kt::tlock(m_onModified)->clear();
 	m_resources.clear();
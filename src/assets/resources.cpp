@@ -15,8 +15,8 @@ std::string_view Resource::string() const noexcept {
 Span<std::byte const> Resource::bytes() const noexcept {
 	if (m_monitor) {
 		return m_monitor->bytes();
-	} else if (auto pBytes = std::get_if<bytearray>(&m_data)) {
-		return *pBytes;
+	} else if (auto pView = std::get_if<io::ByteView>(&m_data)) {
+		return pView->bytes;
 	} else {
 		return {};
 	}
@@ -24,6 +24,14 @@ Span<std::byte const> Resource::bytes() const noexcept {
 
 Resource::Type Resource::type() const noexcept { return m_type; }
 
+Resource::Policy Resource::policy() const noexcept { return m_policy; }
+
+std::size_t Resource::size() const noexcept { return m_type == Type::eText ? string().size() : bytes().size(); }
+
+bool Resource::transient(Policy policy) const noexcept { return policy == Policy::eTransient || (policy == Policy::eMonitored && !monitoring()); }
+
+bool Resource::watched(Policy policy) const noexcept { return policy == Policy::eMonitored && monitoring(); }
+
 bool Resource::monitoring() const noexcept { return m_monitor.has_value(); }
 
 std::optional<io::FileMonitor::Status> Resource::status() const {
@@ -38,12 +46,13 @@ bool Resource::load(io::Reader const& reader, io::Path path, Type type, bool bMo
 			using FMode = io::FileMonitor::Mode;
 			m_monitor = io::FileMonitor(pFR->fullPath(path).generic_string(), type == Type::eText ? FMode::eTextContents : FMode::eBinaryContents);
 			m_monitor->update();
-			m_data = bytearray();
+			m_data = io::ByteView();
 		} else {
 			if (type == Type::eText) {
 				m_data = *reader.string(path);
 			} else {
-				m_data = *reader.bytes(path);
+				// mapped for paks: no heap copy of the archived contents
+				m_data = *reader.view(path);
 			}
 			m_monitor.reset();
 		}
@@ -54,6 +63,12 @@ bool Resource::load(io::Reader const& reader, io::Path path, Type type, bool bMo
 	return false;
 }
 
+bool Resource::unreferenced() const noexcept {
+	return m_users == 0 && (m_policy == Policy::eTransient || (m_policy == Policy::eMonitored && m_watchers == 0));
+}
+
+Resources::~Resources() { clear(); }
+
 void Resources::reader(not_null<io::Reader const*> reader) { m_reader = reader; }
 
 io::Reader const& Resources::reader() const {
@@ -69,19 +84,78 @@ Resource const* Resources::find(Hash id) const noexcept {
 	return nullptr;
 }
 
-Resource const* Resources::load(io::Path path, Resource::Type type, bool bMonitor, bool bForceReload) {
+Resource const* Resources::load(io::Path path, Resource::Type type, Policy policy, bool bForceReload) {
 	if (!bForceReload) {
-		if (auto pRes = find(path)) { return pRes; }
+		if (policy == Policy::eRetained) {
+			// fast path: no references to acquire
+			kt::tlock lock(m_loaded);
+			if (auto it = lock.get().find(path); it != lock.get().end() && it->second.m_policy == Policy::eRetained) { return &it->second; }
+		}
+		kt::unique_tlock<ResourceMap> lock(m_loaded);
+		if (auto it = lock->find(path); it != lock->end()) { return acquire(it->second, policy); }
 	}
-	kt::unique_tlock<ResourceMap> lock(m_loaded);
-	lock->erase(path);
+	// read outside the lock: (parallel) loads of different resources don't serialise on I/O
 	Resource resource;
-	if (resource.load(reader(), path, type, bMonitor && levk_resourceMonitor)) {
-		auto [it, bRes] = lock.get().emplace(std::move(path), std::move(resource));
-		ensure(bRes, "Duplicate Resource");
-		return &it->second;
+	bool const bLoaded = resource.load(reader(), path, type, policy == Policy::eMonitored && levk_resourceMonitor);
+	kt::unique_tlock<ResourceMap> lock(m_loaded);
+	if (!bLoaded) {
+		if (bForceReload) {
+			if (auto it = lock->find(path); it != lock->end()) {
+				s_bytes -= it->second.m_size;
+				lock->erase(it);
+			}
+		}
+		return nullptr;
+	}
+	auto [it, bNew] = lock->try_emplace(std::move(path));
+	// loaded concurrently by another thread: keep the first
+	if (bNew || bForceReload) {
+		auto& res = it->second;
+		resource.m_size = resource.size();
+		s_bytes += resource.m_size;
+		s_bytes -= res.m_size;
+		// keep references and (stronger) policy of a replaced resource
+		resource.m_users = res.m_users;
+		resource.m_watchers = res.m_watchers;
+		if (!bNew) { resource.m_policy = res.m_policy; }
+		res = std::move(resource);
+	}
+	return acquire(it->second, policy);
+}
+
+void Resources::release(Hash id) {
+	kt::unique_tlock<ResourceMap> lock(m_loaded);
+	if (auto it = lock->find(id); it != lock->end()) {
+		auto& res = it->second;
+		if (res.m_users > 0) { --res.m_users; }
+		if (res.unreferenced()) {
+			s_bytes -= res.m_size;
+			lock->erase(it);
+		}
 	}
-	return nullptr;
+}
+
+void Resources::unwatch(Hash id) {
+	kt::unique_tlock<ResourceMap> lock(m_loaded);
+	if (auto it = lock->find(id); it != lock->end()) {
+		auto& res = it->second;
+		if (res.m_watchers > 0) { --res.m_watchers; }
+		if (res.unreferenced()) {
+			s_bytes -= res.m_size;
+			lock->erase(it);
+		}
+	}
+}
+
+Resource const* Resources::acquire(Resource& out_resource, Policy policy) noexcept {
+	if (out_resource.transient(policy)) {
+		++out_resource.m_users;
+	} else {
+		if (out_resource.watched(policy)) { ++out_resource.m_watchers; }
+		// retained loads pin monitored resources
+		if (out_resource.m_policy == Policy::eTransient || policy == Policy::eRetained) { out_resource.m_policy = policy; }
+	}
+	return &out_resource;
 }
 
 bool Resources::loaded(Hash id) const noexcept {
@@ -90,14 +164,25 @@ bool Resources::loaded(Hash id) const noexcept {
 }
 
 void Resources::update() {
+	auto const* pFR = dynamic_cast<io::FileReader const*>(&reader());
 	kt::tlock lock(m_loaded);
 	for (auto& [_, resource] : lock.get()) {
-		if (resource.m_monitor) { resource.m_monitor->update(); }
+		if (resource.m_monitor) {
+			if (resource.m_monitor->update() == io::FileMonitor::Status::eNotFound && pFR) {
+				// drop cached path resolution: the file may reappear under a different mount
+				pFR->invalidate(resource.m_path);
+			}
+			// contents reloaded: re-account
+			auto const size = resource.size();
+			s_bytes += size;
+			s_bytes -= std::exchange(resource.m_size, size);
+		}
 	}
 }
 
 void Resources::clear() {
 	kt::unique_tlock<ResourceMap> lock(m_loaded);
+	for (auto const& [_, resource] : lock.get()) { s_bytes -= resource.m_size; }
 	lock.get().clear();
 }
 } // namespace le
@@ -319,6 +319,26 @@ TWidget<std::pair<s64, s64>>::TWidget(MU sv id, MU s64& out_t, MU s64 min, MU s6
 #endif
 }
 
+bool mouseCaptured() {
+#if defined(LEVK_USE_IMGUI)
+	return ImGui::GetIO().WantCaptureMouse;
+#else
+	return false;
+#endif
+}
+
+void pick(In const& in, Out& out, input::Frame const& frame) {
+	if (!in.pick.index || !in.registry || mouseCaptured() || !frame.state.pressed(input::Key::eMouseButton1).has_value()) { return; }
+	glm::vec2 const half = frame.space.scene.size * 0.5f;
+	if (half.x <= 0.0f || half.y <= 0.0f) { return; }
+	// cursor position is in scene space: centred, y up
+	glm::vec2 const ndc = frame.state.cursor.position / half;
+	if (std::abs(ndc.x) > 1.0f || std::abs(ndc.y) > 1.0f) { return; }
+	if (auto const entity = in.pick.index->pick(SceneIndex::unproject(in.pick.viewProj, ndc))) {
+		if (auto node = in.registry->find<SceneNode>(*entity)) { out.inspecting = {node, *entity}; }
+	}
+}
+
 void displayScale(MU f32 renderScale) {
 #if defined(LEVK_USE_IMGUI)
 	auto& ds = ImGui::GetIO().DisplayFramebufferScale;
@@ -351,6 +371,7 @@ graphics::ScreenView Editor::update(Desktop& win, Renderer& renderer, input::Fra
 			if (!edi::Pane::s_blockResize) { m_storage.resizer(win, m_storage.gameView, frame); }
 			edi::Pane::s_blockResize = false;
 			m_storage.menu(s_in.menu, renderer);
+			edi::pick(s_in, s_out, frame);
 			glm::vec2 const& size = frame.space.display.window;
 			auto const rect = m_storage.gameView.rect();
 			f32 const offsetY = m_storage.gameView.topLeft.offset.y;
@@ -24,8 +24,19 @@ void showStats(graphics::ARenderer& renderer) {
 		auto const [isize, iunit] = utils::friendlySize(s.gfx.bytes.images);
 		t = Text(fmt::format("Buffers: {:.1f}{}", bsize, bunit));
 		t = Text(fmt::format("Images: {:.1f}{}", isize, iunit));
+		auto const [usize, uunit] = utils::friendlySize(s.gfx.uniforms.highWater);
+		auto const [csize, cunit] = utils::friendlySize(s.gfx.uniforms.capacity);
+		t = Text(fmt::format("Uniforms (peak): {:.1f}{} / {:.1f}{}", usize, uunit, csize, cunit));
+		auto const [ssize, sunit] = utils::friendlySize(s.gfx.staging.peak);
+		auto const [scsize, scunit] = utils::friendlySize(s.gfx.staging.capacity);
+		t = Text(fmt::format("Staging (peak): {:.1f}{} / {:.1f}{} ({} stalls)", ssize, sunit, scsize, scunit, s.gfx.staging.stalls));
+		t = Text(fmt::format("Copies (recorded / submitted): {} / {}", s.gfx.transfers.recorded, s.gfx.transfers.submitted));
+		auto const [rsize, runit] = utils::friendlySize(s.assets.resourceBytes);
+		t = Text(fmt::format("Resources: {:.1f}{}", rsize, runit));
 		t = Text(fmt::format("Draw calls: {}", s.gfx.drawCalls));
 		t = Text(fmt::format("Triangles: {}", s.gfx.triCount));
+		t = Text(fmt::format("Descriptor writes: {}", s.gfx.descriptorWrites));
+		t = Text(fmt::format("Items (visible / culled): {} / {}", s.gfx.items.visible, s.gfx.items.culled));
 		t = Text(fmt::format("Window: {}x{}", s.gfx.extents.window.x, s.gfx.extents.window.y));
 		t = Text(fmt::format("Swapchain: {}x{}", s.gfx.extents.swapchain.x, s.gfx.extents.swapchain.y));
 		t = Text(fmt::format("Renderer: {}x{}", s.gfx.extents.renderer.x, s.gfx.extents.renderer.y));
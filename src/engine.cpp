@@ -1,8 +1,10 @@
 #include <iostream>
 #include <build_version.hpp>
+#include <engine/assets/resources.hpp>
 #include <engine/engine.hpp>
 #include <engine/gui/view.hpp>
 #include <engine/input/space.hpp>
+#include <engine/scene/scene_drawer.hpp>
 #include <engine/utils/logger.hpp>
 #include <graphics/common.hpp>
 #include <graphics/mesh.hpp>
@@ -146,14 +148,25 @@ void Engine::updateStats() {
 	}
 	s_stats.gfx.bytes.buffers = m_gfx->boot.vram.bytes(graphics::Resource::Type::eBuffer);
 	s_stats.gfx.bytes.images = m_gfx->boot.vram.bytes(graphics::Resource::Type::eImage);
+	auto const& arena = m_gfx->context.uniformArena().stats();
+	s_stats.gfx.uniforms = {arena.used, arena.highWater, arena.capacity};
+	auto const transfer = m_gfx->boot.vram.transferStats();
+	s_stats.gfx.staging = {transfer.staging.peak, transfer.staging.capacity, transfer.staging.stalls};
+	s_stats.gfx.transfers = {transfer.recorded, transfer.submitted};
 	s_stats.gfx.drawCalls = graphics::CommandBuffer::s_drawCalls.load();
 	s_stats.gfx.triCount = graphics::Mesh::s_trisDrawn.load();
+	s_stats.gfx.descriptorWrites = graphics::DescriptorSet::s_writes.load();
+	s_stats.gfx.items = {SceneDrawer::Culler::s_visible.load(), SceneDrawer::Culler::s_culled.load()};
+	s_stats.assets.resourceBytes = Resources::s_bytes.load();
 	s_stats.gfx.extents.window = windowSize();
 	s_stats.gfx.extents.swapchain = m_gfx ? m_gfx->context.extent() : Extent2D(0);
 	s_stats.gfx.extents.renderer =
 		m_gfx ? graphics::ARenderer::scaleExtent(s_stats.gfx.extents.swapchain, m_gfx->context.renderer().renderScale()) : Extent2D(0);
 	graphics::CommandBuffer::s_drawCalls.store(0);
 	graphics::Mesh::s_trisDrawn.store(0);
+	graphics::DescriptorSet::s_writes.store(0);
+	SceneDrawer::Culler::s_visible.store(0);
+	SceneDrawer::Culler::s_culled.store(0);
 }
 
 void Engine::bootImpl() {
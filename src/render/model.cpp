@@ -1,46 +1,18 @@
+#include <fstream>
 #include <sstream>
 #include <unordered_map>
 #include <unordered_set>
 #include <fmt/format.h>
 #include <tinyobjloader/tiny_obj_loader.h>
+#include <core/flat_map.hpp>
 #include <core/io/reader.hpp>
 #include <dumb_json/json.hpp>
 #include <engine/assets/asset_store.hpp>
 #include <engine/render/model.hpp>
+#include <engine/utils/logger.hpp>
 #include <graphics/mesh.hpp>
 #include <graphics/texture.hpp>
 
-#if !defined(__ANDROID__)
-#include <glm/gtx/hash.hpp>
-#endif
-
-#if defined(__ANDROID__)
-namespace std {
-namespace {
-struct fhasher {
-	std::size_t i = 0;
-
-	std::size_t operator()(float f) noexcept { return std::hash<float>{}(f) << i++; }
-};
-} // namespace
-
-template <>
-struct hash<glm::vec2> {
-	size_t operator()(glm::vec2 const& v) const noexcept {
-		fhasher f;
-		return f(v.x) ^ f(v.y);
-	}
-};
-template <>
-struct hash<glm::vec3> {
-	size_t operator()(glm::vec3 const& v) const noexcept {
-		fhasher f;
-		return f(v.x) ^ f(v.y) ^ f(v.z);
-	}
-};
-} // namespace std
-#endif
-
 namespace le {
 namespace {
 constexpr glm::vec2 texCoords(Span<f32 const> arr, std::size_t idx, bool invertY) noexcept {
@@ -92,16 +64,26 @@ class OBJReader final {
 		glm::vec3 origin = glm::vec3(0.0f);
 		f32 scale = 1.0f;
 		bool invertV = true;
+		bool optimise = false;
 	};
 
   private:
-	struct IncrHasher {
-		std::size_t count = 0;
+	struct IndexTriple {
+		int vertex = -1;
+		int normal = -1;
+		int texCoord = -1;
 
-		template <typename T>
-		std::size_t operator()(T const& t) noexcept {
-			return std::hash<T>{}(t) << count++;
-		}
+		bool operator==(IndexTriple const&) const = default;
+
+		struct Hasher {
+			std::size_t operator()(IndexTriple const& t) const noexcept {
+				// mix (splitmix64 finaliser) so that linear probing sees well distributed low bits
+				u64 h = (u64(u32(t.vertex)) << 32) ^ (u64(u32(t.normal)) << 16) ^ u64(u32(t.texCoord));
+				h = (h ^ (h >> 30)) * 0xbf58476d1ce4e5b9ULL;
+				h = (h ^ (h >> 27)) * 0x94d049bb133111ebULL;
+				return std::size_t(h ^ (h >> 31));
+			}
+		};
 	};
 
 	std::stringstream m_obj;
@@ -117,6 +99,7 @@ class OBJReader final {
 	glm::vec3 m_origin;
 	f32 m_scale = 1.0f;
 	bool m_invertV = true;
+	bool m_optimise = false;
 
   public:
 	OBJReader(Data data);
@@ -134,7 +117,8 @@ class OBJReader final {
 
 OBJReader::OBJReader(Data data)
 	: m_obj(std::move(data.obj)), m_mtl(std::move(data.mtl)), m_modelID(std::move(data.modelID)), m_jsonID(std::move(data.jsonID)),
-	  m_samplerID(std::move(data.samplerID)), m_origin(data.origin), m_scale(data.scale), m_invertV(data.invertV) {}
+	  m_samplerID(std::move(data.samplerID)), m_origin(data.origin), m_scale(data.scale), m_invertV(data.invertV),
+	  m_optimise(data.optimise) {}
 
 Model::Result<Model::CreateInfo> OBJReader::operator()(io::Reader const& reader) {
 	auto const idStr = m_jsonID.generic_string();
@@ -152,7 +136,7 @@ Model::Result<Model::CreateInfo> OBJReader::operator()(io::Reader const& reader)
 	Model::CreateInfo ret;
 	for (auto const& shape : m_shapes) { ret.meshes.push_back(processShape(ret, shape)); }
 	for (auto& texture : ret.textures) {
-		auto bytes = reader.bytes(texture.filename);
+		auto bytes = reader.view(texture.filename);
 		ensure(bytes.has_value(), "Texture not found!");
 		if (bytes) { texture.bytes = std::move(bytes).value(); }
 	}
@@ -226,23 +210,20 @@ std::vector<std::size_t> OBJReader::materials(Model::CreateInfo& info, tinyobj::
 graphics::Geometry OBJReader::vertices(tinyobj::shape_t const& shape) {
 	graphics::Geometry ret;
 	ret.reserve((u32)m_attrib.vertices.size(), (u32)shape.mesh.indices.size());
-	std::unordered_map<std::size_t, u32> vertIndices;
-	vertIndices.reserve(shape.mesh.indices.size());
+	// dedup on the exact index triple: vertices sharing (position, normal, texcoord) indices are identical
+	FlatMap<IndexTriple, u32, IndexTriple::Hasher> vertIndices(shape.mesh.indices.size());
 	for (auto const& idx : shape.mesh.indices) {
-		glm::vec3 const p = m_scale * (m_origin + vec3(m_attrib.vertices, (std::size_t)idx.vertex_index));
-		glm::vec3 const c = vec3(m_attrib.colors, (std::size_t)idx.vertex_index);
-		glm::vec3 const n = vec3(m_attrib.normals, idx.normal_index);
-		glm::vec2 const t = texCoords(m_attrib.texcoords, idx.texcoord_index, m_invertV);
-		IncrHasher inc;
-		std::size_t const hash = inc(p) ^ inc(c) ^ inc(n) ^ inc(t);
-		if (auto const search = vertIndices.find(hash); search != vertIndices.end()) {
-			ret.indices.push_back(search->second);
-		} else {
-			auto const idx = ret.addVertex({p, c, n, t});
-			ret.indices.push_back(idx);
-			vertIndices.emplace(hash, idx);
+		auto const [index, bNew] = vertIndices.emplace({idx.vertex_index, idx.normal_index, idx.texcoord_index}, (u32)ret.vertices.size());
+		if (bNew) {
+			glm::vec3 const p = m_scale * (m_origin + vec3(m_attrib.vertices, (std::size_t)idx.vertex_index));
+			glm::vec3 const c = vec3(m_attrib.colors, (std::size_t)idx.vertex_index);
+			glm::vec3 const n = vec3(m_attrib.normals, idx.normal_index);
+			glm::vec2 const t = texCoords(m_attrib.texcoords, idx.texcoord_index, m_invertV);
+			ret.addVertex({p, c, n, t});
 		}
+		ret.indices.push_back(*index);
 	}
+	if (m_optimise) { graphics::optimiseVertexCache(ret.indices, (u32)ret.vertices.size()); }
 	ret.vertices.shrink_to_fit();
 	ret.indices.shrink_to_fit();
 	return ret;
@@ -250,6 +231,38 @@ graphics::Geometry OBJReader::vertices(tinyobj::shape_t const& shape) {
 } // namespace
 
 namespace {
+// FNV-1a: stable across runs / builds (unlike std::hash), baked into blobs
+u64 sourceHash(std::initializer_list<std::string_view> sources) noexcept {
+	u64 ret = 0xcbf29ce484222325ULL;
+	for (std::string_view const source : sources) {
+		for (char const c : source) { ret = (ret ^ (u8)c) * 0x100000001b3ULL; }
+		ret = (ret ^ 0xff) * 0x100000001b3ULL; // separator
+	}
+	return ret;
+}
+
+struct Sources {
+	std::string obj;
+	std::optional<std::string> mtl;
+
+	static std::optional<Sources> read(io::Reader const& reader, io::Path const& objID, std::optional<io::Path> const& mtlID) {
+		auto obj = reader.string(objID);
+		if (!obj) { return std::nullopt; }
+		Sources ret{std::move(obj).value(), std::nullopt};
+		if (mtlID) {
+			if (auto mtl = reader.string(*mtlID)) { ret.mtl = std::move(mtl).value(); }
+		}
+		return ret;
+	}
+
+	u64 hash() const noexcept { return sourceHash({obj, mtl ? std::string_view(*mtl) : std::string_view()}); }
+};
+
+void logLoad(io::Path const& jsonID, std::string_view source, time::Point start) {
+	auto const ms = time::diff<Time_us>(start).count() / 1000.0f;
+	utils::g_log.log(dl::level::info, 1, "[{}] [Model] [{}] loaded from {} in {:.2f}ms", utils::g_name, jsonID.generic_string(), source, ms);
+}
+
 graphics::Texture const* texture(std::unordered_map<Hash, graphics::Texture> const& map, Span<Model::TexData const> tex, Span<std::size_t const> indices) {
 	if (!indices.empty()) {
 		std::size_t const idx = indices.front();
@@ -262,7 +275,7 @@ graphics::Texture const* texture(std::unordered_map<Hash, graphics::Texture> con
 }
 } // namespace
 
-Model::Result<Model::CreateInfo> Model::load(io::Path modelID, io::Path jsonID, io::Reader const& reader) {
+Model::Result<Model::CreateInfo> Model::load(io::Path modelID, io::Path jsonID, io::Reader const& reader, io::Reader const* medium) {
 	auto res = reader.string(jsonID);
 	if (!res) { return std::string("JSON not found"); }
 	dj::json_t json;
@@ -270,39 +283,80 @@ Model::Result<Model::CreateInfo> Model::load(io::Path modelID, io::Path jsonID,
 	if (result.failure || !result.errors.empty() || !json.is_object()) { return std::string("Failed to read json: ") + result.to_string(); }
 	if (!json.contains("obj")) { return std::string("JSON missing obj"); }
 	auto const jsonDir = jsonID.parent_path();
+	auto const start = time::now();
 	auto const objID = jsonDir / json["obj"].as<std::string>();
-	auto const mtlID = jsonDir / (json.contains("mtl") ? json["mtl"].as<std::string>() : std::string());
-	auto obj = reader.sstream(objID);
-	auto mtl = reader.sstream(mtlID);
-	if (!obj) { return std::string("obj not found"); }
+	auto const mtlID = json.contains("mtl") ? std::optional<io::Path>(jsonDir / json["mtl"].as<std::string>()) : std::nullopt;
+	// json (scale, origin, optimise, ...) and sources: any edit invalidates the baked blob
+	u64 const jsonHash = sourceHash({*res});
+	std::optional<Sources> sources;
+	io::Path bakedID;
+	if (auto pBaked = json.find("baked")) {
+		bakedID = jsonDir / pBaked->as<std::string>();
+		if (auto blob = reader.present(bakedID) ? reader.view(bakedID) : io::Reader::Result<io::ByteView>(kt::null_result)) {
+			// obj / mtl are only read (and monitored) in debug builds: release builds don't hot reload, and trust the blob
+			std::optional<u64> objHash;
+			if constexpr (levk_debug) {
+				sources = Sources::read(reader, objID, mtlID);
+				if (sources) { objHash = sources->hash(); }
+			}
+			if (auto ret = unbake(std::move(blob).value(), jsonHash, objHash)) {
+				for (auto& texture : ret->textures) {
+					auto bytes = reader.view(texture.filename);
+					ensure(bytes.has_value(), "Texture not found!");
+					if (bytes) { texture.bytes = std::move(bytes).value(); }
+				}
+				logLoad(jsonID, "baked", start);
+				return ret;
+			}
+			utils::g_log.log(dl::level::info, 1, "[{}] [Model] Baked model [{}] stale or invalid, rebaking", utils::g_name, bakedID.generic_string());
+		}
+	}
+	if (!sources) { sources = Sources::read(reader, objID, mtlID); }
+	if (!sources) { return std::string("obj not found"); }
+	u64 const objHash = sources->hash();
 	auto pSamplerID = json.find("sampler");
 	auto pScale = json.find("scale");
+	auto pOptimise = json.find("optimise");
 	OBJReader::Data objData;
-	objData.obj = std::move(obj).value();
-	if (mtl) { objData.mtl = std::move(mtl).value(); }
+	objData.obj = std::stringstream(std::move(sources->obj));
+	if (sources->mtl) { objData.mtl = std::stringstream(std::move(*sources->mtl)); }
 	objData.modelID = std::move(modelID);
-	objData.jsonID = std::move(jsonID);
+	objData.jsonID = jsonID;
 	objData.modelID = jsonDir;
 	objData.samplerID = pSamplerID ? pSamplerID->as<std::string>() : "samplers/default";
 	objData.scale = pScale ? pScale->as<f32>() : 1.0f;
 	objData.origin = vec3(json, "origin");
+	objData.optimise = pOptimise && pOptimise->as<bool>();
 	OBJReader parser(std::move(objData));
-	return parser(reader);
+	auto ret = parser(reader);
+	if (ret) {
+		logLoad(jsonID, "obj", start);
+		// bake on first load if the asset requests it and lives on the filesystem
+		if (auto fr = dynamic_cast<io::FileReader const*>(medium ? medium : &reader); fr && !bakedID.empty()) {
+			auto const path = fr->fullPath(jsonID).parent_path() / bakedID.filename();
+			auto const blob = bake(*ret, jsonHash, objHash);
+			if (std::ofstream file(path.string(), std::ios::binary); file && file.write(reinterpret_cast<char const*>(blob.data()), (std::streamsize)blob.size())) {
+				utils::g_log.log(dl::level::info, 1, "[{}] [Model] Baked [{}] ({} bytes)", utils::g_name, path.generic_string(), blob.size());
+			}
+		}
+	}
+	return ret;
 }
 
-Model::Result<Span<Primitive const>> Model::construct(not_null<VRAM*> vram, CreateInfo const& info, Sampler const& sampler,
-													  std::optional<vk::Format> forceFormat) {
+Model::Result<Span<Primitive const>> Model::construct(not_null<VRAM*> vram, CreateInfo info, Sampler const& sampler, std::optional<vk::Format> forceFormat) {
 	Map<Material> materials;
 	decltype(m_storage) storage;
-	for (auto const& tex : info.textures) {
+	for (auto& tex : info.textures) {
 		if (!tex.bytes.empty()) {
 			graphics::Texture::CreateInfo tci;
 			tci.forceFormat = forceFormat;
 			tci.sampler = sampler.sampler();
-			tci.data = graphics::Texture::Img{tex.bytes.begin(), tex.bytes.end()};
+			tci.data = graphics::Texture::ImgView(tex.bytes.bytes);
 			graphics::Texture texture(vram);
 			if (!texture.construct(tci)) { return std::string("Failed to construct texture"); }
 			storage.textures.emplace(tex.id, std::move(texture));
+			// decoded and staged: drop the file contents
+			tex.bytes = {};
 		}
 	}
 	for (auto const& mat : info.materials) {
@@ -314,7 +368,11 @@ Model::Result<Span<Primitive const>> Model::construct(not_null<VRAM*> vram, Crea
 	}
 	for (auto const& m : info.meshes) {
 		graphics::Mesh mesh(vram);
-		mesh.construct(m.geometry);
+		if (!m.vertices.empty()) {
+			mesh.construct(m.vertices, m.indices);
+		} else {
+			mesh.construct(m.geometry);
+		}
 		auto [it, _] = storage.meshes.emplace((info.id / m.id).generic_string(), std::move(mesh));
 		Primitive prim;
 		prim.mesh = &it->second;
@@ -329,4 +387,16 @@ Model::Result<Span<Primitive const>> Model::construct(not_null<VRAM*> vram, Crea
 	m_storage = std::move(storage);
 	return Span<Primitive const>(m_storage.primitives);
 }
+
+void Model::wait() const {
+	for (auto const& [_, texture] : m_storage.textures) { texture.wait(); }
+	for (auto const& [_, mesh] : m_storage.meshes) { mesh.wait(); }
+}
+
+u64 Model::bytes() const noexcept {
+	u64 ret = 0;
+	for (auto const& [_, texture] : m_storage.textures) { ret += texture.bytes(); }
+	for (auto const& [_, mesh] : m_storage.meshes) { ret += mesh.bytes(); }
+	return ret;
+}
 } // namespace le
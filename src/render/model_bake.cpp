@@ -0,0 +1,197 @@
+#include <cstring>
+#include <engine/render/model.hpp>
+
+namespace le {
+namespace {
+// Layout (little-endian, native float):
+// header: magic[4], version, sizeof(Vertex), json hash, obj / mtl hash, texture / material / mesh counts, origin
+// textures: id, filename, samplerID
+// materials: id, Ka / Kd / Ks / Tf (colour, type), Ns, d, illum, diffuse / specular / alpha / bump indices
+// meshes: id, material indices, vertex count, index count, [pad to 4], vertices, indices
+constexpr char magic[4] = {'L', 'V', 'K', 'M'};
+
+// minimum encoded sizes (empty strings / index lists): bound counts read from the blob before allocating
+constexpr std::size_t minTexture = 2 * sizeof(u32) + sizeof(u64);
+constexpr std::size_t minMaterial = sizeof(u32) + 4 * 2 * sizeof(u32) + 2 * sizeof(f32) + sizeof(s32) + 4 * sizeof(u32);
+constexpr std::size_t minMesh = 4 * sizeof(u32);
+
+class BlobWriter {
+  public:
+	BlobWriter(bytearray& out) noexcept : m_out(out) {}
+
+	void write(void const* data, std::size_t size) {
+		auto const pos = m_out.size();
+		m_out.resize(pos + size);
+		if (size > 0) { std::memcpy(m_out.data() + pos, data, size); }
+	}
+	template <typename T>
+	void pod(T const& t) {
+		static_assert(std::is_trivially_copyable_v<T>);
+		write(&t, sizeof(T));
+	}
+	void str(std::string_view str) {
+		pod((u32)str.size());
+		write(str.data(), str.size());
+	}
+	void indices(Span<std::size_t const> indices) {
+		pod((u32)indices.size());
+		for (std::size_t const idx : indices) { pod((u32)idx); }
+	}
+	void rgba(graphics::RGBA const& rgba) {
+		pod(rgba.colour.toU32());
+		pod((u32)rgba.type);
+	}
+	void align(std::size_t alignment) {
+		while (m_out.size() % alignment != 0) { m_out.push_back({}); }
+	}
+
+  private:
+	bytearray& m_out;
+};
+
+class BlobReader {
+  public:
+	BlobReader(Span<std::byte const> in) noexcept : m_in(in) {}
+
+	std::byte const* read(std::size_t size) noexcept {
+		if (!m_ok || m_pos + size > m_in.size()) {
+			m_ok = false;
+			return nullptr;
+		}
+		auto const ret = m_in.data() + m_pos;
+		m_pos += size;
+		return ret;
+	}
+	template <typename T>
+	T pod() noexcept {
+		T ret{};
+		if (auto data = read(sizeof(T))) { std::memcpy(&ret, data, sizeof(T)); }
+		return ret;
+	}
+	std::string str() {
+		auto const size = pod<u32>();
+		auto const data = read(size);
+		return data ? std::string(reinterpret_cast<char const*>(data), size) : std::string();
+	}
+	// u32 element count: fails if that many elements of at least minSize bytes can't fit in the remaining bytes
+	std::size_t count(std::size_t minSize) noexcept {
+		auto const ret = pod<u32>();
+		if (!m_ok || ret > (m_in.size() - m_pos) / minSize) {
+			m_ok = false;
+			return 0;
+		}
+		return ret;
+	}
+	std::vector<std::size_t> indices() {
+		std::vector<std::size_t> ret(count(sizeof(u32)));
+		for (auto& idx : ret) { idx = pod<u32>(); }
+		return m_ok ? ret : std::vector<std::size_t>();
+	}
+	graphics::RGBA rgba() noexcept {
+		Colour const colour(pod<u32>());
+		return graphics::RGBA(colour, (graphics::RGBA::Type)pod<u32>());
+	}
+	template <typename T>
+	Span<T const> span(std::size_t count) noexcept {
+		auto const data = read(count * sizeof(T));
+		return data ? Span<T const>(reinterpret_cast<T const*>(data), count) : Span<T const>();
+	}
+	void align(std::size_t alignment) noexcept {
+		if (m_pos % alignment != 0) { read(alignment - m_pos % alignment); }
+	}
+
+	bool ok() const noexcept { return m_ok; }
+
+  private:
+	Span<std::byte const> m_in;
+	std::size_t m_pos = 0;
+	bool m_ok = true;
+};
+} // namespace
+
+bytearray Model::bake(CreateInfo const& info, u64 jsonHash, u64 sourceHash) {
+	bytearray ret;
+	BlobWriter out(ret);
+	out.write(magic, sizeof(magic));
+	out.pod(bakeVersion);
+	out.pod((u32)sizeof(graphics::Vertex));
+	out.pod(jsonHash);
+	out.pod(sourceHash);
+	out.pod((u32)info.textures.size());
+	out.pod((u32)info.materials.size());
+	out.pod((u32)info.meshes.size());
+	out.pod(info.origin);
+	for (auto const& tex : info.textures) {
+		out.str(tex.id.generic_string());
+		out.str(tex.filename.generic_string());
+		out.pod((u64)tex.samplerID.hash);
+	}
+	for (auto const& mat : info.materials) {
+		out.str(mat.id.generic_string());
+		for (auto const* rgba : {&mat.mtl.Ka, &mat.mtl.Kd, &mat.mtl.Ks, &mat.mtl.Tf}) { out.rgba(*rgba); }
+		out.pod(mat.mtl.Ns);
+		out.pod(mat.mtl.d);
+		out.pod(mat.mtl.illum);
+		for (auto const* indices : {&mat.diffuse, &mat.specular, &mat.alpha, &mat.bump}) { out.indices(*indices); }
+	}
+	for (auto const& mesh : info.meshes) {
+		auto const vertices = mesh.vertices.empty() ? Span<graphics::Vertex const>(mesh.geometry.vertices) : mesh.vertices;
+		auto const indices = mesh.vertices.empty() ? Span<u32 const>(mesh.geometry.indices) : mesh.indices;
+		out.str(mesh.id.generic_string());
+		out.indices(mesh.matIndices);
+		out.pod((u32)vertices.size());
+		out.pod((u32)indices.size());
+		out.align(alignof(graphics::Vertex));
+		out.write(vertices.data(), vertices.size_bytes());
+		out.write(indices.data(), indices.size_bytes());
+	}
+	return ret;
+}
+
+Model::Result<Model::CreateInfo> Model::unbake(io::ByteView blob, std::optional<u64> jsonHash, std::optional<u64> sourceHash) {
+	CreateInfo ret;
+	ret.blob = std::move(blob);
+	BlobReader in(ret.blob.bytes);
+	auto const header = in.read(sizeof(magic));
+	if (!header || std::memcmp(header, magic, sizeof(magic)) != 0) { return std::string("Invalid magic"); }
+	if (in.pod<u32>() != bakeVersion) { return std::string("Version mismatch"); }
+	if (in.pod<u32>() != sizeof(graphics::Vertex)) { return std::string("Vertex layout mismatch"); }
+	if (auto const baked = in.pod<u64>(); jsonHash && *jsonHash != baked) { return std::string("JSON modified"); }
+	if (auto const baked = in.pod<u64>(); sourceHash && *sourceHash != baked) { return std::string("Sources modified"); }
+	auto const textures = in.count(minTexture);
+	auto const materials = in.count(minMaterial);
+	auto const meshes = in.count(minMesh);
+	if (!in.ok()) { return std::string("Invalid counts"); }
+	ret.textures.resize(textures);
+	ret.materials.resize(materials);
+	ret.meshes.resize(meshes);
+	ret.origin = in.pod<glm::vec3>();
+	for (auto& tex : ret.textures) {
+		tex.id = in.str();
+		tex.filename = in.str();
+		tex.samplerID.hash = (std::size_t)in.pod<u64>();
+		tex.hash = tex.id;
+	}
+	for (auto& mat : ret.materials) {
+		mat.id = in.str();
+		mat.hash = mat.id;
+		for (auto* rgba : {&mat.mtl.Ka, &mat.mtl.Kd, &mat.mtl.Ks, &mat.mtl.Tf}) { *rgba = in.rgba(); }
+		mat.mtl.Ns = in.pod<f32>();
+		mat.mtl.d = in.pod<f32>();
+		mat.mtl.illum = in.pod<s32>();
+		for (auto* indices : {&mat.diffuse, &mat.specular, &mat.alpha, &mat.bump}) { *indices = in.indices(); }
+	}
+	for (auto& mesh : ret.meshes) {
+		mesh.id = in.str();
+		mesh.hash = mesh.id;
+		mesh.matIndices = in.indices();
+		auto const vertCount = in.pod<u32>();
+		auto const indexCount = in.pod<u32>();
+		in.align(alignof(graphics::Vertex));
+		mesh.vertices = in.span<graphics::Vertex>(vertCount);
+		mesh.indices = in.span<u32>(indexCount);
+	}
+	if (!in.ok()) { return std::string("Truncated blob"); }
+	return Result<CreateInfo>(std::move(ret));
+}
+} // namespace le
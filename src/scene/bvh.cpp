@@ -0,0 +1,226 @@
+#include <algorithm>
+#include <engine/scene/bvh.hpp>
+
+namespace le {
+namespace {
+using AABB = BVH::AABB;
+
+AABB merge(AABB const& a, AABB const& b) noexcept { return {glm::min(a.min, b.min), glm::max(a.max, b.max)}; }
+
+f32 area(AABB const& aabb) noexcept {
+	glm::vec3 const d = aabb.max - aabb.min;
+	return 2.0f * (d.x * d.y + d.y * d.z + d.z * d.x);
+}
+
+bool contains(AABB const& outer, AABB const& inner) noexcept {
+	return outer.min.x <= inner.min.x && outer.min.y <= inner.min.y && outer.min.z <= inner.min.z && inner.max.x <= outer.max.x &&
+		   inner.max.y <= outer.max.y && inner.max.z <= outer.max.z;
+}
+} // namespace
+
+BVH::Proxy BVH::insert(AABB const& aabb, u64 payload) {
+	Proxy const ret = allocate();
+	Node& node = m_nodes[(std::size_t)ret];
+	glm::vec3 const margin(m_margin);
+	node.aabb = {aabb.min - margin, aabb.max + margin};
+	node.payload = payload;
+	node.height = 0;
+	insertLeaf(ret);
+	++m_leaves;
+	return ret;
+}
+
+void BVH::remove(Proxy proxy) {
+	ensure(proxy >= 0 && (std::size_t)proxy < m_nodes.size() && m_nodes[(std::size_t)proxy].leaf(), "Invalid proxy");
+	removeLeaf(proxy);
+	release(proxy);
+	--m_leaves;
+}
+
+bool BVH::update(Proxy proxy, AABB const& aabb) {
+	ensure(proxy >= 0 && (std::size_t)proxy < m_nodes.size() && m_nodes[(std::size_t)proxy].leaf(), "Invalid proxy");
+	if (contains(m_nodes[(std::size_t)proxy].aabb, aabb)) { return false; }
+	removeLeaf(proxy);
+	glm::vec3 const margin(m_margin);
+	m_nodes[(std::size_t)proxy].aabb = {aabb.min - margin, aabb.max + margin};
+	insertLeaf(proxy);
+	return true;
+}
+
+void BVH::clear() noexcept {
+	m_nodes.clear();
+	m_root = m_free = null;
+	m_leaves = 0;
+}
+
+bool BVH::intersect(graphics::Frustum const& frustum, AABB const& aabb) noexcept {
+	// reject if the AABB's positive vertex is behind any plane
+	for (std::size_t idx = 0; idx < graphics::Frustum::count; ++idx) {
+		f32 const x = frustum.nx[idx] >= 0.0f ? aabb.max.x : aabb.min.x;
+		f32 const y = frustum.ny[idx] >= 0.0f ? aabb.max.y : aabb.min.y;
+		f32 const z = frustum.nz[idx] >= 0.0f ? aabb.max.z : aabb.min.z;
+		if (frustum.nx[idx] * x + frustum.ny[idx] * y + frustum.nz[idx] * z + frustum.d[idx] < 0.0f) { return false; }
+	}
+	return true;
+}
+
+bool BVH::intersect(Ray const& ray, AABB const& aabb, f32& out_t) noexcept {
+	// slab test
+	f32 tmin = 0.0f, tmax = ray.length;
+	for (int axis = 0; axis < 3; ++axis) {
+		f32 const o = ray.origin[axis], d = ray.direction[axis];
+		if (d == 0.0f) {
+			if (o < aabb.min[axis] || o > aabb.max[axis]) { return false; }
+			continue;
+		}
+		f32 const inv = 1.0f / d;
+		f32 t0 = (aabb.min[axis] - o) * inv, t1 = (aabb.max[axis] - o) * inv;
+		if (t0 > t1) { std::swap(t0, t1); }
+		tmin = std::max(tmin, t0);
+		tmax = std::min(tmax, t1);
+		if (tmin > tmax) { return false; }
+	}
+	out_t = tmin;
+	return true;
+}
+
+BVH::Proxy BVH::allocate() {
+	if (m_free == null) {
+		m_nodes.push_back({});
+		return Proxy(m_nodes.size() - 1);
+	}
+	Proxy const ret = m_free;
+	m_free = m_nodes[(std::size_t)ret].parent;
+	m_nodes[(std::size_t)ret] = {};
+	return ret;
+}
+
+void BVH::release(Proxy proxy) noexcept {
+	m_nodes[(std::size_t)proxy] = {};
+	m_nodes[(std::size_t)proxy].parent = m_free;
+	m_free = proxy;
+}
+
+void BVH::insertLeaf(Proxy leaf) {
+	if (m_root == null) {
+		m_root = leaf;
+		m_nodes[(std::size_t)leaf].parent = null;
+		return;
+	}
+	// descend choosing the cheapest sibling by surface area heuristic
+	AABB const leafBox = m_nodes[(std::size_t)leaf].aabb;
+	Proxy index = m_root;
+	while (!m_nodes[(std::size_t)index].leaf()) {
+		Node const& node = m_nodes[(std::size_t)index];
+		f32 const nodeArea = area(node.aabb);
+		f32 const combined = area(merge(node.aabb, leafBox));
+		f32 const cost = 2.0f * combined;
+		f32 const inherit = 2.0f * (combined - nodeArea);
+		auto const childCost = [&](Proxy child) {
+			Node const& c = m_nodes[(std::size_t)child];
+			f32 const merged = area(merge(c.aabb, leafBox));
+			return c.leaf() ? merged + inherit : merged - area(c.aabb) + inherit;
+		};
+		f32 const costL = childCost(node.left);
+		f32 const costR = childCost(node.right);
+		if (cost < costL && cost < costR) { break; }
+		index = costL < costR ? node.left : node.right;
+	}
+	Proxy const sibling = index;
+	Proxy const oldParent = m_nodes[(std::size_t)sibling].parent;
+	Proxy const newParent = allocate();
+	{
+		Node& np = m_nodes[(std::size_t)newParent];
+		np.parent = oldParent;
+		np.aabb = merge(leafBox, m_nodes[(std::size_t)sibling].aabb);
+		np.height = m_nodes[(std::size_t)sibling].height + 1;
+		np.left = sibling;
+		np.right = leaf;
+	}
+	if (oldParent != null) {
+		Node& op = m_nodes[(std::size_t)oldParent];
+		(op.left == sibling ? op.left : op.right) = newParent;
+	} else {
+		m_root = newParent;
+	}
+	m_nodes[(std::size_t)sibling].parent = newParent;
+	m_nodes[(std::size_t)leaf].parent = newParent;
+	refit(m_nodes[(std::size_t)leaf].parent);
+}
+
+void BVH::removeLeaf(Proxy leaf) {
+	if (leaf == m_root) {
+		m_root = null;
+		return;
+	}
+	Proxy const parent = m_nodes[(std::size_t)leaf].parent;
+	Proxy const grandParent = m_nodes[(std::size_t)parent].parent;
+	Proxy const sibling = m_nodes[(std::size_t)parent].left == leaf ? m_nodes[(std::size_t)parent].right : m_nodes[(std::size_t)parent].left;
+	if (grandParent != null) {
+		Node& gp = m_nodes[(std::size_t)grandParent];
+		(gp.left == parent ? gp.left : gp.right) = sibling;
+		m_nodes[(std::size_t)sibling].parent = grandParent;
+		release(parent);
+		refit(grandParent);
+	} else {
+		m_root = sibling;
+		m_nodes[(std::size_t)sibling].parent = null;
+		release(parent);
+	}
+	m_nodes[(std::size_t)leaf].parent = null;
+}
+
+void BVH::refit(Proxy index) {
+	while (index != null) {
+		index = balance(index);
+		Node& node = m_nodes[(std::size_t)index];
+		Node const& left = m_nodes[(std::size_t)node.left];
+		Node const& right = m_nodes[(std::size_t)node.right];
+		node.height = 1 + std::max(left.height, right.height);
+		node.aabb = merge(left.aabb, right.aabb);
+		index = node.parent;
+	}
+}
+
+// AVL-style rotation: promotes the taller grandchild if children heights differ by more than one
+BVH::Proxy BVH::balance(Proxy iA) {
+	Node& A = m_nodes[(std::size_t)iA];
+	if (A.leaf() || A.height < 2) { return iA; }
+	Proxy const iB = A.left, iC = A.right;
+	s32 const diff = m_nodes[(std::size_t)iC].height - m_nodes[(std::size_t)iB].height;
+	if (diff == 0 || diff == 1 || diff == -1) { return iA; }
+	// rotate the taller child (X) up; its other child (S) is the shorter sibling
+	bool const bRight = diff > 1;
+	Proxy const iX = bRight ? iC : iB;
+	Proxy const iS = bRight ? iB : iC;
+	Node& X = m_nodes[(std::size_t)iX];
+	Proxy const iF = X.left, iG = X.right;
+	Node& F = m_nodes[(std::size_t)iF];
+	Node& G = m_nodes[(std::size_t)iG];
+	X.left = iA;
+	X.parent = A.parent;
+	A.parent = iX;
+	if (X.parent != null) {
+		Node& P = m_nodes[(std::size_t)X.parent];
+		(P.left == iA ? P.left : P.right) = iX;
+	} else {
+		m_root = iX;
+	}
+	Node const& S = m_nodes[(std::size_t)iS];
+	bool const bKeepF = F.height > G.height;
+	Proxy const iUp = bKeepF ? iF : iG;
+	Proxy const iDown = bKeepF ? iG : iF;
+	X.right = iUp;
+	if (bRight) {
+		A.right = iDown;
+	} else {
+		A.left = iDown;
+	}
+	m_nodes[(std::size_t)iDown].parent = iA;
+	A.aabb = merge(S.aabb, m_nodes[(std::size_t)iDown].aabb);
+	A.height = 1 + std::max(S.height, m_nodes[(std::size_t)iDown].height);
+	X.aabb = merge(A.aabb, m_nodes[(std::size_t)iUp].aabb);
+	X.height = 1 + std::max(A.height, m_nodes[(std::size_t)iUp].height);
+	return iX;
+}
+} // namespace le
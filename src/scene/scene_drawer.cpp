@@ -1,19 +1,46 @@
+#include <algorithm>
+#include <atomic>
+#include <memory>
 #include <core/utils/std_hash.hpp>
 #include <dumb_ecf/registry.hpp>
+#include <engine/assets/asset_store.hpp>
 #include <engine/gui/view.hpp>
+#include <engine/render/model.hpp>
 #include <engine/scene/scene_drawer.hpp>
+#include <engine/scene/scene_index.hpp>
 #include <engine/scene/scene_node.hpp>
+#include <graphics/mesh.hpp>
 #include <graphics/utils/utils.hpp>
 
 namespace le {
+namespace {
+// runs fn(begin, end) over [0, count) in batches: the first on the calling thread, the rest staged on scheduler workers;
+// blocks (on an atomic wait, not a spin) until every batch is done
+template <typename F>
+void parallel(dts::scheduler& scheduler, std::size_t count, std::size_t batch, F const& fn) {
+	// shared: a task may still be notifying after the waiter has observed zero
+	auto const pending = std::make_shared<std::atomic<std::size_t>>((count - 1) / batch);
+	dts::scheduler::stage_t stage;
+	for (std::size_t begin = batch; begin < count; begin += batch) {
+		stage.tasks.push_back([&fn, pending, begin, end = std::min(begin + batch, count)]() {
+			fn(begin, end);
+			if (pending->fetch_sub(1) == 1) { pending->notify_one(); }
+		});
+	}
+	scheduler.stage(std::move(stage));
+	fn(0, std::min(batch, count));
+	for (auto p = pending->load(); p > 0; p = pending->load()) { pending->wait(p); }
+}
+} // namespace
+
 std::size_t DrawGroup::Hasher::operator()(DrawGroup const& gr) const noexcept {
 	return std::hash<graphics::Pipeline const*>{}(gr.pipeline) ^ (std::hash<s64>{}(gr.order) << 1);
 }
 
 void SceneDrawer::Populator3D::operator()(ItemMap& map, decf::registry_t const& registry) const {
-	for (auto& [_, d] : registry.view<DrawGroup, SceneNode, PrimList>()) {
+	for (auto& [entity, d] : registry.view<DrawGroup, SceneNode, PrimList>()) {
 		auto& [gr, node, pl] = d;
-		if (!pl.empty() && gr.pipeline) { map[gr].push_back({node.model(), std::nullopt, pl}); }
+		if (!pl.empty() && gr.pipeline) { map[gr].push_back({node.model(), std::nullopt, pl, entity}); }
 	}
 }
 
@@ -31,8 +58,255 @@ void SceneDrawer::add(ItemMap& map, DrawGroup const& group, gui::TreeRoot const&
 	for (auto& node : root.nodes()) { add(map, group, *node); }
 }
 
+void SceneDrawer::Instancer::instance(std::vector<Instances>& out_instances, Span<Item const> items, bool bOrdered) {
+	out_instances.clear();
+	for (auto& [_, bucket] : m_buckets) { bucket.clear(); }
+	auto const match = [&out_instances](std::size_t idx, Primitive const& prim) {
+		auto const& inst = out_instances[idx];
+		return !inst.scissor && inst.primitive->mesh == prim.mesh && inst.primitive->material == prim.material;
+	};
+	for (Item const& item : items) {
+		for (Primitive const& prim : item.primitives) {
+			if (!prim.mesh) { continue; }
+			if (item.scissor) {
+				out_instances.push_back({&prim, {item.model}, item.scissor});
+				continue;
+			}
+			if (bOrdered) {
+				if (!out_instances.empty() && match(out_instances.size() - 1, prim)) {
+					out_instances.back().models.push_back(item.model);
+				} else {
+					out_instances.push_back({&prim, {item.model}, std::nullopt});
+				}
+				continue;
+			}
+			auto& bucket = m_buckets[prim.mesh];
+			auto const it = std::find_if(bucket.begin(), bucket.end(), [&match, &prim](std::size_t idx) { return match(idx, prim); });
+			if (it != bucket.end()) {
+				out_instances[*it].models.push_back(item.model);
+			} else {
+				bucket.push_back(out_instances.size());
+				out_instances.push_back({&prim, {item.model}, std::nullopt});
+			}
+		}
+	}
+}
+
+void SceneDrawer::Builder::add(decf::entity_t entity) { m_events.push_back({entity, true}); }
+
+void SceneDrawer::Builder::remove(decf::entity_t entity) { m_events.push_back({entity, false}); }
+
+Span<SceneDrawer::Group const> SceneDrawer::Builder::build(decf::registry_t const& registry, bool sort, Scheduler* scheduler) {
+	m_dirty.clear();
+	if (!m_built) {
+		m_events.clear();
+		scan(registry);
+		layout(sort);
+	} else if (!m_events.empty()) {
+		apply(registry);
+		layout(sort);
+	} else {
+		for (Entry& entry : m_entries) {
+			if (entry.node->stale() || entry.node->generation() != entry.generation) { m_dirty.push_back(&entry); }
+		}
+	}
+	refresh(scheduler);
+	return m_groups;
+}
+
+void SceneDrawer::Builder::clear() noexcept {
+	m_groups.clear();
+	m_index.clear();
+	m_entries.clear();
+	m_entryIndex.clear();
+	m_events.clear();
+	m_dirty.clear();
+	m_built = false;
+}
+
+void SceneDrawer::Builder::scan(decf::registry_t const& registry) {
+	m_entries.clear();
+	m_entryIndex.clear();
+	for (auto& [entity, d] : registry.view<DrawGroup, SceneNode, PrimList>()) {
+		auto& [gr, node, pl] = d;
+		track(entity, gr, node, pl);
+	}
+	m_built = true;
+}
+
+void SceneDrawer::Builder::apply(decf::registry_t const& registry) {
+	for (Event const& event : m_events) {
+		if (event.add) {
+			auto const gr = registry.find<DrawGroup>(event.entity);
+			auto const node = registry.find<SceneNode>(event.entity);
+			auto const pl = registry.find<PrimList>(event.entity);
+			if (gr && node && pl) {
+				track(event.entity, *gr, *node, *pl);
+				continue;
+			}
+		}
+		untrack(event.entity);
+	}
+	m_events.clear();
+}
+
+void SceneDrawer::Builder::track(decf::entity_t entity, DrawGroup const& group, SceneNode const& node, PrimList const& primitives) {
+	if (primitives.empty() || !group.pipeline) {
+		untrack(entity);
+		return;
+	}
+	// components are never relocated while attached (SceneNode hierarchies rely on this too)
+	Entry const entry{entity, group, &node, primitives};
+	if (auto const [it, bNew] = m_entryIndex.emplace(entity, m_entries.size()); bNew) {
+		m_entries.push_back(entry);
+	} else {
+		m_entries[it->second] = entry;
+	}
+}
+
+void SceneDrawer::Builder::untrack(decf::entity_t entity) {
+	if (auto const it = m_entryIndex.find(entity); it != m_entryIndex.end()) {
+		std::size_t const idx = it->second;
+		m_entryIndex.erase(it);
+		if (idx + 1 < m_entries.size()) {
+			m_entries[idx] = std::move(m_entries.back());
+			m_entryIndex[m_entries[idx].entity] = idx;
+		}
+		m_entries.pop_back();
+	}
+}
+
+void SceneDrawer::Builder::layout(bool sort) {
+	// recycle item storage of existing groups
+	std::unordered_map<DrawGroup, std::vector<Item>, DrawGroup::Hasher> recycled;
+	for (Group& group : m_groups) {
+		group.items.clear();
+		recycled.emplace(group.group, std::move(group.items));
+	}
+	m_groups.clear();
+	m_index.clear();
+	for (Entry& entry : m_entries) {
+		auto [it, bNew] = m_index.emplace(entry.group, m_groups.size());
+		if (bNew) {
+			Group group{entry.group, {}};
+			if (auto rit = recycled.find(entry.group); rit != recycled.end()) { group.items = std::move(rit->second); }
+			m_groups.push_back(std::move(group));
+		}
+		auto& items = m_groups[it->second].items;
+		entry.groupIdx = it->second;
+		entry.itemIdx = items.size();
+		items.push_back({glm::mat4(1.0f), std::nullopt, entry.primitives, entry.entity});
+	}
+	if (sort) {
+		std::sort(m_groups.begin(), m_groups.end());
+		for (std::size_t idx = 0; idx < m_groups.size(); ++idx) { m_index[m_groups[idx].group] = idx; }
+		for (Entry& entry : m_entries) { entry.groupIdx = m_index[entry.group]; }
+	}
+	for (Entry& entry : m_entries) { m_dirty.push_back(&entry); }
+}
+
+void SceneDrawer::Builder::refresh(Scheduler* scheduler) {
+	auto const update = [this](Entry& entry) {
+		m_groups[entry.groupIdx].items[entry.itemIdx].model = entry.node->model();
+		entry.generation = entry.node->generation();
+	};
+	std::size_t const batch = std::max(m_batch, std::size_t(1));
+	if (!scheduler || m_dirty.size() <= batch) {
+		for (Entry* entry : m_dirty) { update(*entry); }
+		return;
+	}
+	// refresh parents of stale nodes serially so that each task only writes to its own nodes
+	for (Entry const* entry : m_dirty) {
+		if (auto parent = entry->node->parent()) { parent->refresh(); }
+	}
+	parallel(*scheduler, m_dirty.size(), batch, [this, update](std::size_t begin, std::size_t end) {
+		for (std::size_t idx = begin; idx < end; ++idx) { update(*m_dirty[idx]); }
+	});
+}
+
+Span<SceneDrawer::Group const> SceneDrawer::Culler::cull(Span<Group const> groups, graphics::Frustum const& frustum, Scheduler* scheduler) {
+	return cull(groups, frustum, nullptr, scheduler);
+}
+
+Span<SceneDrawer::Group const> SceneDrawer::Culler::cull(Span<Group const> groups, graphics::Frustum const& frustum, SceneIndex const& index,
+														 Scheduler* scheduler) {
+	return cull(groups, frustum, &index, scheduler);
+}
+
+Span<SceneDrawer::Group const> SceneDrawer::Culler::cull(Span<Group const> groups, graphics::Frustum const& frustum, SceneIndex const* index,
+														 Scheduler* scheduler) {
+	m_hits.clear();
+	if (index) {
+		index->query(frustum, [this](decf::entity_t entity) {
+			m_hits.insert(entity);
+			return true;
+		});
+	}
+	m_offsets.clear();
+	std::size_t total = 0;
+	for (Group const& group : groups) {
+		m_offsets.push_back(total);
+		total += group.items.size();
+	}
+	m_visible.resize(total);
+	auto const test = [this, groups, &frustum, index](std::size_t begin, std::size_t end) {
+		// first group containing begin
+		auto const first = std::upper_bound(m_offsets.begin(), m_offsets.end(), begin) - m_offsets.begin() - 1;
+		for (std::size_t gr = (std::size_t)first, idx = begin; idx < end; ++gr) {
+			Group const& group = groups[gr];
+			std::size_t const groupEnd = std::min(end, m_offsets[gr] + group.items.size());
+			for (; idx < groupEnd; ++idx) {
+				Item const& item = group.items[idx - m_offsets[gr]];
+				bool const bIndexed = index && index->contains(item.entity);
+				bool const bVisible = bIndexed ? m_hits.contains(item.entity) : visible(item, frustum);
+				m_visible[idx] = group.group.order < 0 || item.scissor || bVisible ? 1 : 0;
+			}
+		}
+	};
+	std::size_t const batch = std::max(m_batch, std::size_t(1));
+	if (!scheduler || total <= batch) {
+		test(0, total);
+	} else {
+		parallel(*scheduler, total, batch, test);
+	}
+	m_groups.resize(groups.size());
+	u32 visibleCount = 0;
+	for (std::size_t gr = 0; gr < groups.size(); ++gr) {
+		m_groups[gr].group = groups[gr].group;
+		auto& items = m_groups[gr].items;
+		items.clear();
+		for (std::size_t idx = 0; idx < groups[gr].items.size(); ++idx) {
+			if (m_visible[m_offsets[gr] + idx]) { items.push_back(groups[gr].items[idx]); }
+		}
+		visibleCount += (u32)items.size();
+	}
+	s_visible += visibleCount;
+	s_culled += u32(total) - visibleCount;
+	return m_groups;
+}
+
+bool SceneDrawer::Culler::visible(Item const& item, graphics::Frustum const& frustum) noexcept {
+	glm::mat4 const& m = item.model;
+	auto const len2 = [](glm::vec4 const& col) { return col.x * col.x + col.y * col.y + col.z * col.z; };
+	f32 const scale = std::sqrt(std::max({len2(m[0]), len2(m[1]), len2(m[2])}));
+	bool bBounded = false;
+	for (Primitive const& prim : item.primitives) {
+		if (!prim.mesh || !prim.mesh->bounds().valid) { continue; }
+		auto const& sphere = prim.mesh->bounds().sphere;
+		if (frustum.test(glm::vec3(m * glm::vec4(sphere.centre, 1.0f)), sphere.radius * scale)) { return true; }
+		bBounded = true;
+	}
+	return !bBounded;
+}
+
 void SceneDrawer::attach(decf::registry_t& reg, decf::entity_t entity, DrawGroup const& group, Span<Primitive const> primitives) {
 	reg.attach<PrimList>(entity) = {primitives.begin(), primitives.end()};
 	reg.attach<DrawGroup>(entity, group);
 }
+
+void SceneDrawer::attach(decf::registry_t& reg, decf::entity_t entity, DrawGroup const& group, Asset<Model> const& model) {
+	// PrimList points into model: an evicted Model would leave it dangling
+	reg.attach<Asset<Model>>(entity, model);
+	attach(reg, entity, group, model->primitives());
+}
 } // namespace le
@@ -0,0 +1,106 @@
+#include <dumb_ecf/registry.hpp>
+#include <engine/scene/scene_drawer.hpp>
+#include <engine/scene/scene_index.hpp>
+#include <engine/scene/scene_node.hpp>
+#include <glm/matrix.hpp>
+#include <graphics/mesh.hpp>
+
+namespace le {
+namespace {
+std::optional<SceneIndex::AABB> worldAABB(glm::mat4 const& m, Span<Primitive const> prims) {
+	std::optional<SceneIndex::AABB> ret;
+	for (Primitive const& prim : prims) {
+		if (!prim.mesh || !prim.mesh->bounds().valid) { continue; }
+		auto const& aabb = prim.mesh->bounds().aabb;
+		// transform centre + extents (Arvo): extent' = |M| * extent
+		glm::vec3 const centre = glm::vec3(m * glm::vec4(0.5f * (aabb.min + aabb.max), 1.0f));
+		glm::vec3 const e = 0.5f * (aabb.max - aabb.min);
+		glm::vec3 const extent = glm::abs(glm::vec3(m[0])) * e.x + glm::abs(glm::vec3(m[1])) * e.y + glm::abs(glm::vec3(m[2])) * e.z;
+		SceneIndex::AABB const box = {centre - extent, centre + extent};
+		ret = ret ? SceneIndex::AABB{glm::min(ret->min, box.min), glm::max(ret->max, box.max)} : box;
+	}
+	return ret;
+}
+} // namespace
+
+void SceneIndex::sync(decf::registry_t const& registry) {
+	++m_frame;
+	for (auto& [entity, d] : registry.view<SceneNode, PrimList>()) {
+		auto& [node, pl] = d;
+		auto [it, bNew] = m_records.emplace(entity, Record());
+		Record& record = it->second;
+		record.frame = m_frame;
+		if (!bNew && !node.stale() && node.generation() == record.generation) { continue; }
+		auto const aabb = worldAABB(node.model(), pl);
+		// retry next sync if no bounds yet (eg meshes still loading)
+		record.generation = aabb ? node.generation() : 0;
+		if (!aabb) {
+			if (record.proxy != BVH::null) {
+				m_freeSlots.push_back(m_bvh.payload(record.proxy));
+				m_bvh.remove(record.proxy);
+				record.proxy = BVH::null;
+			}
+			continue;
+		}
+		if (record.proxy == BVH::null) {
+			u64 slot = m_slots.size();
+			if (!m_freeSlots.empty()) {
+				slot = m_freeSlots.back();
+				m_freeSlots.pop_back();
+				m_slots[(std::size_t)slot] = entity;
+			} else {
+				m_slots.push_back(entity);
+			}
+			record.proxy = m_bvh.insert(*aabb, slot);
+		} else {
+			m_bvh.update(record.proxy, *aabb);
+		}
+	}
+	for (auto it = m_records.begin(); it != m_records.end();) {
+		if (it->second.frame != m_frame) {
+			if (it->second.proxy != BVH::null) {
+				m_freeSlots.push_back(m_bvh.payload(it->second.proxy));
+				m_bvh.remove(it->second.proxy);
+			}
+			it = m_records.erase(it);
+		} else {
+			++it;
+		}
+	}
+}
+
+void SceneIndex::clear() noexcept {
+	m_records.clear();
+	m_slots.clear();
+	m_freeSlots.clear();
+	m_bvh.clear();
+}
+
+bool SceneIndex::contains(decf::entity_t entity) const {
+	auto const it = m_records.find(entity);
+	return it != m_records.end() && it->second.proxy != BVH::null;
+}
+
+SceneIndex::Ray SceneIndex::unproject(glm::mat4 const& viewProj, glm::vec2 ndc, f32 length) {
+	glm::mat4 const inverse = glm::inverse(viewProj);
+	// depth is [0, 1] (GLM_FORCE_DEPTH_ZERO_TO_ONE)
+	glm::vec4 const near = inverse * glm::vec4(ndc, 0.0f, 1.0f);
+	glm::vec4 const far = inverse * glm::vec4(ndc, 1.0f, 1.0f);
+	glm::vec3 const origin = glm::vec3(near) / near.w;
+	return {origin, glm::normalize(glm::vec3(far) / far.w - origin), length};
+}
+
+std::optional<decf::entity_t> SceneIndex::pick(Ray const& ray) const {
+	std::optional<decf::entity_t> ret;
+	f32 nearest = ray.length;
+	query(ray, [&ret, &nearest](decf::entity_t entity, f32 t) {
+		// t == 0: origin inside the AABB (eg skyboxes)
+		if (t > 0.0f && t <= nearest) {
+			nearest = t;
+			ret = entity;
+		}
+		return true;
+	});
+	return ret;
+}
+} // namespace le
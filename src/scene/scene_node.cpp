@@ -2,6 +2,11 @@
 #include <glm/gtx/matrix_decompose.hpp>
 
 namespace le {
+TransformPool& SceneNode::pool() noexcept {
+	static TransformPool s_pool;
+	return s_pool;
+}
+
 glm::quat SceneNode::worldOrientation() const noexcept {
 	glm::vec3 pos;
 	glm::quat orn;
@@ -0,0 +1,245 @@
+#include <core/ensure.hpp>
+#include <engine/scene/transform_pool.hpp>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define LEVK_TRANSFORM_SSE
+#endif
+
+namespace le {
+namespace {
+// Column-major TRS (glm layout): R(q) * S in the upper 3x3, T in the last column
+glm::mat4 trs(f32 px, f32 py, f32 pz, f32 qx, f32 qy, f32 qz, f32 qw, f32 sx, f32 sy, f32 sz) noexcept {
+	f32 const xx = qx * qx, yy = qy * qy, zz = qz * qz;
+	f32 const xy = qx * qy, xz = qx * qz, yz = qy * qz;
+	f32 const wx = qw * qx, wy = qw * qy, wz = qw * qz;
+	glm::mat4 ret;
+	ret[0] = {(1.0f - 2.0f * (yy + zz)) * sx, 2.0f * (xy + wz) * sx, 2.0f * (xz - wy) * sx, 0.0f};
+	ret[1] = {2.0f * (xy - wz) * sy, (1.0f - 2.0f * (xx + zz)) * sy, 2.0f * (yz + wx) * sy, 0.0f};
+	ret[2] = {2.0f * (xz + wy) * sz, 2.0f * (yz - wx) * sz, (1.0f - 2.0f * (xx + yy)) * sz, 0.0f};
+	ret[3] = {px, py, pz, 1.0f};
+	return ret;
+}
+
+#if defined(LEVK_TRANSFORM_SSE)
+struct Lanes {
+	__m128 px, py, pz;
+	__m128 qx, qy, qz, qw;
+	__m128 sx, sy, sz;
+};
+
+// 4 transforms at once: compute each matrix element across lanes, then transpose lanes into columns
+void compose4(Lanes const& in, glm::mat4* const (&out)[4]) noexcept {
+	auto const one = _mm_set1_ps(1.0f);
+	auto const two = _mm_set1_ps(2.0f);
+	auto const zero = _mm_setzero_ps();
+	auto const xx = _mm_mul_ps(in.qx, in.qx), yy = _mm_mul_ps(in.qy, in.qy), zz = _mm_mul_ps(in.qz, in.qz);
+	auto const xy = _mm_mul_ps(in.qx, in.qy), xz = _mm_mul_ps(in.qx, in.qz), yz = _mm_mul_ps(in.qy, in.qz);
+	auto const wx = _mm_mul_ps(in.qw, in.qx), wy = _mm_mul_ps(in.qw, in.qy), wz = _mm_mul_ps(in.qw, in.qz);
+	__m128 c0[4] = {
+		_mm_mul_ps(_mm_sub_ps(one, _mm_mul_ps(two, _mm_add_ps(yy, zz))), in.sx),
+		_mm_mul_ps(_mm_mul_ps(two, _mm_add_ps(xy, wz)), in.sx),
+		_mm_mul_ps(_mm_mul_ps(two, _mm_sub_ps(xz, wy)), in.sx),
+		zero,
+	};
+	__m128 c1[4] = {
+		_mm_mul_ps(_mm_mul_ps(two, _mm_sub_ps(xy, wz)), in.sy),
+		_mm_mul_ps(_mm_sub_ps(one, _mm_mul_ps(two, _mm_add_ps(xx, zz))), in.sy),
+		_mm_mul_ps(_mm_mul_ps(two, _mm_add_ps(yz, wx)), in.sy),
+		zero,
+	};
+	__m128 c2[4] = {
+		_mm_mul_ps(_mm_mul_ps(two, _mm_add_ps(xz, wy)), in.sz),
+		_mm_mul_ps(_mm_mul_ps(two, _mm_sub_ps(yz, wx)), in.sz),
+		_mm_mul_ps(_mm_sub_ps(one, _mm_mul_ps(two, _mm_add_ps(xx, yy))), in.sz),
+		zero,
+	};
+	__m128 c3[4] = {in.px, in.py, in.pz, one};
+	_MM_TRANSPOSE4_PS(c0[0], c0[1], c0[2], c0[3]);
+	_MM_TRANSPOSE4_PS(c1[0], c1[1], c1[2], c1[3]);
+	_MM_TRANSPOSE4_PS(c2[0], c2[1], c2[2], c2[3]);
+	_MM_TRANSPOSE4_PS(c3[0], c3[1], c3[2], c3[3]);
+	for (std::size_t lane = 0; lane < 4; ++lane) {
+		f32* mat = &(*out[lane])[0][0];
+		_mm_storeu_ps(mat, c0[lane]);
+		_mm_storeu_ps(mat + 4, c1[lane]);
+		_mm_storeu_ps(mat + 8, c2[lane]);
+		_mm_storeu_ps(mat + 12, c3[lane]);
+	}
+}
+
+__m128 gather(std::vector<f32> const& vec, TransformPool::Index const (&idx)[4]) noexcept { return _mm_setr_ps(vec[idx[0]], vec[idx[1]], vec[idx[2]], vec[idx[3]]); }
+#endif
+} // namespace
+
+TransformPool::Index TransformPool::push(SceneTransform const& transform) {
+	if (!m_free.empty()) {
+		Index const ret = m_free.back();
+		m_free.pop_back();
+		set(ret, transform);
+		return ret;
+	}
+	Index const ret = size();
+	m_soa.px.push_back(transform.position.x);
+	m_soa.py.push_back(transform.position.y);
+	m_soa.pz.push_back(transform.position.z);
+	m_soa.qx.push_back(transform.orientation.x);
+	m_soa.qy.push_back(transform.orientation.y);
+	m_soa.qz.push_back(transform.orientation.z);
+	m_soa.qw.push_back(transform.orientation.w);
+	m_soa.sx.push_back(transform.scale.x);
+	m_soa.sy.push_back(transform.scale.y);
+	m_soa.sz.push_back(transform.scale.z);
+	m_matrices.push_back(transform.matrix());
+	m_dirty.push_back(0);
+	return ret;
+}
+
+void TransformPool::pop(Index index) noexcept {
+	ensure(index < size(), "Invalid index");
+	m_dirty[index] = 0;
+	m_free.push_back(index);
+}
+
+void TransformPool::set(Index index, SceneTransform const& transform) noexcept {
+	ensure(index < size(), "Invalid index");
+	m_soa.px[index] = transform.position.x;
+	m_soa.py[index] = transform.position.y;
+	m_soa.pz[index] = transform.position.z;
+	m_soa.qx[index] = transform.orientation.x;
+	m_soa.qy[index] = transform.orientation.y;
+	m_soa.qz[index] = transform.orientation.z;
+	m_soa.qw[index] = transform.orientation.w;
+	m_soa.sx[index] = transform.scale.x;
+	m_soa.sy[index] = transform.scale.y;
+	m_soa.sz[index] = transform.scale.z;
+	setDirty(index);
+}
+
+SceneTransform TransformPool::get(Index index) const noexcept {
+	ensure(index < size(), "Invalid index");
+	SceneTransform ret;
+	ret.position = position(index);
+	ret.orientation = orientation(index);
+	ret.scale = scale(index);
+	return ret;
+}
+
+void TransformPool::clear() noexcept {
+	for (auto* vec : {&m_soa.px, &m_soa.py, &m_soa.pz, &m_soa.qx, &m_soa.qy, &m_soa.qz, &m_soa.qw, &m_soa.sx, &m_soa.sy, &m_soa.sz}) { vec->clear(); }
+	m_matrices.clear();
+	m_dirty.clear();
+	m_stale.clear();
+	m_free.clear();
+}
+
+void TransformPool::reserve(std::size_t count) {
+	for (auto* vec : {&m_soa.px, &m_soa.py, &m_soa.pz, &m_soa.qx, &m_soa.qy, &m_soa.qz, &m_soa.qw, &m_soa.sx, &m_soa.sy, &m_soa.sz}) { vec->reserve(count); }
+	m_matrices.reserve(count);
+	m_dirty.reserve(count);
+}
+
+void TransformPool::position(Index index, glm::vec3 const& position) noexcept {
+	ensure(index < size(), "Invalid index");
+	m_soa.px[index] = position.x;
+	m_soa.py[index] = position.y;
+	m_soa.pz[index] = position.z;
+	setDirty(index);
+}
+
+void TransformPool::orient(Index index, glm::quat const& orientation) noexcept {
+	ensure(index < size(), "Invalid index");
+	m_soa.qx[index] = orientation.x;
+	m_soa.qy[index] = orientation.y;
+	m_soa.qz[index] = orientation.z;
+	m_soa.qw[index] = orientation.w;
+	setDirty(index);
+}
+
+void TransformPool::scale(Index index, glm::vec3 const& scale) noexcept {
+	ensure(index < size(), "Invalid index");
+	m_soa.sx[index] = scale.x;
+	m_soa.sy[index] = scale.y;
+	m_soa.sz[index] = scale.z;
+	setDirty(index);
+}
+
+glm::vec3 TransformPool::position(Index index) const noexcept {
+	ensure(index < size(), "Invalid index");
+	return {m_soa.px[index], m_soa.py[index], m_soa.pz[index]};
+}
+
+glm::quat TransformPool::orientation(Index index) const noexcept {
+	ensure(index < size(), "Invalid index");
+	return glm::quat(m_soa.qw[index], m_soa.qx[index], m_soa.qy[index], m_soa.qz[index]);
+}
+
+glm::vec3 TransformPool::scale(Index index) const noexcept {
+	ensure(index < size(), "Invalid index");
+	return {m_soa.sx[index], m_soa.sy[index], m_soa.sz[index]};
+}
+
+glm::mat4 const& TransformPool::matrix(Index index) const noexcept {
+	ensure(index < size(), "Invalid index");
+	if (m_dirty[index]) {
+		composeScalar(m_matrices, index, index + 1);
+		// stays in m_stale until the next update(), which skips it
+		m_dirty[index] = 0;
+	}
+	return m_matrices[index];
+}
+
+bool TransformPool::dirty(Index index) const noexcept {
+	ensure(index < size(), "Invalid index");
+	return m_dirty[index] != 0;
+}
+
+void TransformPool::update() noexcept {
+	std::erase_if(m_stale, [this](Index index) { return !m_dirty[index]; });
+	std::size_t begin = 0;
+#if defined(LEVK_TRANSFORM_SSE)
+	for (; begin + 4 <= m_stale.size(); begin += 4) {
+		Index const idx[4] = {m_stale[begin], m_stale[begin + 1], m_stale[begin + 2], m_stale[begin + 3]};
+		Lanes const in = {
+			gather(m_soa.px, idx), gather(m_soa.py, idx), gather(m_soa.pz, idx), gather(m_soa.qx, idx), gather(m_soa.qy, idx),
+			gather(m_soa.qz, idx), gather(m_soa.qw, idx), gather(m_soa.sx, idx), gather(m_soa.sy, idx), gather(m_soa.sz, idx),
+		};
+		compose4(in, {&m_matrices[idx[0]], &m_matrices[idx[1]], &m_matrices[idx[2]], &m_matrices[idx[3]]});
+	}
+#endif
+	for (; begin < m_stale.size(); ++begin) { composeScalar(m_matrices, m_stale[begin], m_stale[begin] + 1); }
+	for (Index const index : m_stale) { m_dirty[index] = 0; }
+	m_stale.clear();
+}
+
+void TransformPool::compose(Span<glm::mat4> out) const noexcept {
+	ensure(out.size() >= size(), "Insufficient output storage");
+	std::size_t begin = 0;
+#if defined(LEVK_TRANSFORM_SSE)
+	for (; begin + 4 <= size(); begin += 4) {
+		Lanes const in = {
+			_mm_loadu_ps(m_soa.px.data() + begin), _mm_loadu_ps(m_soa.py.data() + begin), _mm_loadu_ps(m_soa.pz.data() + begin),
+			_mm_loadu_ps(m_soa.qx.data() + begin), _mm_loadu_ps(m_soa.qy.data() + begin), _mm_loadu_ps(m_soa.qz.data() + begin),
+			_mm_loadu_ps(m_soa.qw.data() + begin), _mm_loadu_ps(m_soa.sx.data() + begin), _mm_loadu_ps(m_soa.sy.data() + begin),
+			_mm_loadu_ps(m_soa.sz.data() + begin),
+		};
+		compose4(in, {&out[begin], &out[begin + 1], &out[begin + 2], &out[begin + 3]});
+	}
+#endif
+	composeScalar(out, begin, size());
+}
+
+void TransformPool::composeScalar(Span<glm::mat4> out, std::size_t begin, std::size_t end) const noexcept {
+	for (std::size_t idx = begin; idx < end; ++idx) {
+		out[idx] = trs(m_soa.px[idx], m_soa.py[idx], m_soa.pz[idx], m_soa.qx[idx], m_soa.qy[idx], m_soa.qz[idx], m_soa.qw[idx], m_soa.sx[idx],
+					   m_soa.sy[idx], m_soa.sz[idx]);
+	}
+}
+
+void TransformPool::setDirty(Index index) noexcept {
+	if (!m_dirty[index]) {
+		m_dirty[index] = 1;
+		m_stale.push_back(index);
+	}
+}
+} // namespace le
@@ -0,0 +1,147 @@
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <dumb_tasks/scheduler.hpp>
+#include <engine/assets/asset_store.hpp>
+#include <ktest/ktest.hpp>
+
+namespace {
+using namespace le;
+
+struct Node {
+	int version = 0;
+};
+
+std::unordered_map<std::string, std::string> g_depends;
+// loads run on worker threads when a scheduler is passed to update()
+std::atomic<int> g_loads = 0;
+std::mutex g_mutex;
+std::unordered_map<std::string, int> g_loadsByID;
+
+int loads(std::string const& id) {
+	std::scoped_lock lock(g_mutex);
+	return g_loadsByID[id];
+}
+} // namespace
+
+namespace le {
+template <>
+struct AssetLoadData<Node> {
+	std::string id;
+};
+
+template <>
+struct AssetLoader<Node> {
+	std::optional<Node> load(AssetLoadInfo<Node> const& info) const {
+		++g_loads;
+		{
+			std::scoped_lock lock(g_mutex);
+			++g_loadsByID[info.m_data.id];
+		}
+		// find: may run on worker threads
+		if (auto const it = g_depends.find(info.m_data.id); it != g_depends.end() && !it->second.empty()) {
+			auto asset = info.m_store->find<Node>(it->second);
+			if (!asset) { return std::nullopt; }
+			info.reloadDepend(*asset);
+		}
+		return Node{g_loads.load()};
+	}
+	bool reload(Node& out_node, AssetLoadInfo<Node> const& info) const {
+		if (auto node = load(info)) {
+			out_node = *node;
+			return true;
+		}
+		return false;
+	}
+};
+} // namespace le
+
+namespace {
+TEST(reload_graph_cycles) {
+	detail::ReloadGraph graph;
+	graph.depends[Hash("a")] = {Hash("b")};
+	graph.depends[Hash("b")] = {Hash("a")};
+	graph.depends[Hash("c")] = {Hash("a")};
+	graph.dirty.insert(Hash("a"));
+	graph.build();
+	EXPECT_EQ(graph.cycle("a") > 0 && graph.cycle("a") == graph.cycle("b"), true);
+	EXPECT_EQ(graph.cycle("c"), 0U);
+	// the whole cycle is dirty, but its members don't block each other
+	EXPECT_EQ(graph.dirty.contains(Hash("b")), true);
+	EXPECT_EQ(graph.blocked("a"), false);
+	EXPECT_EQ(graph.blocked("b"), false);
+	EXPECT_EQ(graph.blocked("c"), true);
+}
+
+TEST(reload_cycle_as_unit) {
+	g_depends = {{"b", "a"}};
+	AssetStore store;
+	EXPECT_EQ(store.load<Node>("a", AssetLoadData<Node>{"a"}).has_value(), true);
+	EXPECT_EQ(store.load<Node>("b", AssetLoadData<Node>{"b"}).has_value(), true);
+	// a now depends on b: a <-> b
+	g_depends["a"] = "b";
+	store.forceDirty<Node>("a");
+	store.update();
+	int loads = g_loads;
+	for (int i = 0; i < 3; ++i) { store.update(); }
+	EXPECT_EQ(g_loads, loads);
+	// a dirty member reloads the whole cycle, once
+	store.forceDirty<Node>("b");
+	store.update();
+	EXPECT_EQ(g_loads, loads + 2);
+	loads = g_loads;
+	store.update();
+	EXPECT_EQ(g_loads, loads);
+}
+
+template <typename Pred>
+bool spin(Pred pred) {
+	auto const deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+	while (!pred()) {
+		if (std::chrono::steady_clock::now() > deadline) { return false; }
+		std::this_thread::yield();
+	}
+	return true;
+}
+
+TEST(reload_async_swap) {
+	g_depends = {{"b", "a"}};
+	g_loadsByID.clear();
+	AssetStore store;
+	// destroyed (drained) before the store
+	dts::scheduler scheduler;
+	auto a = store.load<Node>("a", AssetLoadData<Node>{"a"});
+	auto b = store.load<Node>("b", AssetLoadData<Node>{"b"});
+	ASSERT_EQ(a.has_value() && b.has_value(), true);
+	int modified = 0;
+	auto const tk = a->onModified([&modified]() { ++modified; });
+	int const oldA = a->get().version;
+	int const oldB = b->get().version;
+	store.forceDirty<Node>("a");
+	store.update(&scheduler);
+	// rebuilt on a worker: the old value stays visible until a subsequent update() commits it
+	ASSERT_EQ(spin([]() { return loads("a") == 2; }), true);
+	EXPECT_EQ(a->get().version, oldA);
+	EXPECT_EQ(modified, 0);
+	EXPECT_EQ(spin([&]() {
+				  store.update(&scheduler);
+				  return modified > 0;
+			  }),
+			  true);
+	EXPECT_EQ(modified, 1);
+	EXPECT_EQ(a->get().version != oldA, true);
+	// the swap dirtied b (reloadDepend): rebuilt and committed on later updates
+	EXPECT_EQ(spin([&]() {
+				  store.update(&scheduler);
+				  return b->get().version != oldB;
+			  }),
+			  true);
+	for (int i = 0; i < 3; ++i) { store.update(&scheduler); }
+	EXPECT_EQ(modified, 1);
+	EXPECT_EQ(loads("a"), 2);
+	EXPECT_EQ(loads("b"), 2);
+}
+} // namespace
@@ -0,0 +1,172 @@
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <thread>
+#include <utility>
+#include <core/ensure.hpp>
+#include <engine/assets/asset_store.hpp>
+#include <ktest/ktest.hpp>
+
+namespace {
+using namespace le;
+
+// tracks destruction of loaded instances: handles must never outlive the Blob they point to
+struct Blob {
+	static constexpr std::size_t npos = std::size_t(-1);
+	inline static std::array<std::atomic<bool>, 1024> s_alive{};
+	inline static std::atomic<std::size_t> s_next = 0;
+
+	u64 size = 0;
+	std::size_t token = npos;
+
+	static bool alive(std::size_t token) noexcept { return token < s_alive.size() && s_alive[token].load(); }
+
+	Blob(u64 size) : size(size), token(s_next++) {
+		ensure(token < s_alive.size(), "Too many Blobs");
+		s_alive[token] = true;
+	}
+	Blob(Blob&& rhs) noexcept : size(rhs.size), token(std::exchange(rhs.token, npos)) {}
+	Blob& operator=(Blob&& rhs) noexcept {
+		if (&rhs != this) {
+			kill();
+			size = rhs.size;
+			token = std::exchange(rhs.token, npos);
+		}
+		return *this;
+	}
+	~Blob() { kill(); }
+
+	void kill() noexcept {
+		if (token < s_alive.size()) { s_alive[token] = false; }
+	}
+	u64 bytes() const noexcept { return size; }
+};
+
+std::atomic<int> g_loads = 0;
+} // namespace
+
+namespace le {
+template <>
+struct AssetLoadData<Blob> {
+	u64 size = 0;
+	io::Path path;
+};
+
+template <>
+struct AssetLoader<Blob> {
+	std::optional<Blob> load(AssetLoadInfo<Blob> const& info) const {
+		++g_loads;
+		if (!info.m_data.path.empty() && !info.resource(info.m_data.path, Resource::Type::eBinary, Resource::Policy::eMonitored)) { return std::nullopt; }
+		return Blob(info.m_data.size);
+	}
+	bool reload(Blob&, AssetLoadInfo<Blob> const&) const { return false; }
+};
+} // namespace le
+
+namespace {
+TEST(residency_lru_order) {
+	AssetStore store;
+	for (char const* id : {"a", "b", "c"}) { EXPECT_EQ(store.load<Blob>(id, AssetLoadData<Blob>{64, {}}).has_value(), true); }
+	store.update();
+	// recency: a < c < b
+	for (char const* id : {"a", "c", "b"}) {
+		EXPECT_EQ(store.find<Blob>(id).has_value(), true);
+		store.update();
+	}
+	store.budget<Blob>({130, 0});
+	store.update();
+	EXPECT_EQ(store.residency<Blob>().evicted, 1U);
+	store.budget<Blob>({70, 0});
+	store.update();
+	auto const stats = store.residency<Blob>();
+	EXPECT_EQ(stats.resident, 1U);
+	EXPECT_EQ(stats.evictions, 2U);
+	// b (most recently used) is still resident, a (least) is restored
+	auto const loads = g_loads.load();
+	EXPECT_EQ(store.find<Blob>("b").has_value(), true);
+	EXPECT_EQ(g_loads.load(), loads);
+	EXPECT_EQ(store.find<Blob>("a").has_value(), true);
+	EXPECT_EQ(g_loads.load(), loads + 1);
+}
+
+TEST(residency_restore) {
+	AssetStore store;
+	EXPECT_EQ(store.load<Blob>("a", AssetLoadData<Blob>{64, {}}).has_value(), true);
+	store.budget<Blob>({1, 0});
+	// never evicted during the update it was used in
+	store.update();
+	store.update();
+	EXPECT_EQ(store.residency<Blob>().evicted, 1U);
+	auto a = store.find<Blob>("a");
+	EXPECT_EQ(a.has_value(), true);
+	EXPECT_EQ(a->get().size, 64U);
+	EXPECT_EQ(Blob::alive(a->get().token), true);
+	EXPECT_EQ(store.residency<Blob>().restores, 1U);
+	// live handles and subscribers keep the asset resident
+	for (int i = 0; i < 3; ++i) { store.update(); }
+	EXPECT_EQ(store.residency<Blob>().resident, 1U);
+	{
+		auto const tk = a->onModified([]() {});
+		a.reset();
+		for (int i = 0; i < 3; ++i) { store.update(); }
+		EXPECT_EQ(store.residency<Blob>().resident, 1U);
+	}
+	store.update();
+	EXPECT_EQ(store.residency<Blob>().evicted, 1U);
+	EXPECT_EQ(store.residency<Blob>().evictions, 2U);
+}
+
+TEST(residency_recheck_under_lock) {
+	AssetStore store;
+	EXPECT_EQ(store.load<Blob>("a", AssetLoadData<Blob>{64, {}}).has_value(), true);
+	store.budget<Blob>({1, 0});
+	std::atomic<bool> done = false;
+	std::atomic<bool> dangling = false;
+	// handles made between collecting candidates and evicting them must prevent eviction
+	std::thread reader([&]() {
+		while (!done.load()) {
+			if (auto a = store.find<Blob>("a")) {
+				auto const token = a->get().token;
+				std::this_thread::yield();
+				if (!Blob::alive(token)) { dangling = true; }
+			}
+			// skip some updates: the asset must become evictable for the race to occur
+			std::this_thread::sleep_for(std::chrono::microseconds(50));
+		}
+	});
+	for (int i = 0; i < 500; ++i) {
+		store.update();
+		std::this_thread::sleep_for(std::chrono::microseconds(20));
+	}
+	done = true;
+	reader.join();
+	EXPECT_EQ(dangling.load(), false);
+	EXPECT_NE(store.residency<Blob>().evictions, 0U);
+}
+
+TEST(residency_cpu_release) {
+	if constexpr (!levk_resourceMonitor) { return; }
+	auto const dir = std::filesystem::temp_directory_path() / "levk_residency_test";
+	std::filesystem::create_directories(dir);
+	{ std::ofstream(dir / "blob.bin", std::ios::binary) << std::string(256, 'x'); }
+	auto const before = Resources::s_bytes.load();
+	{
+		AssetStore store;
+		store.resources().fileReader().mount(dir.string());
+		EXPECT_EQ(store.load<Blob>("a", AssetLoadData<Blob>{64, "blob.bin"}).has_value(), true);
+		EXPECT_EQ(store.resources().loaded("blob.bin"), true);
+		store.budget<Blob>({0, 1});
+		store.update();
+		store.update();
+		// evicting the last watcher frees the monitored resource
+		EXPECT_EQ(store.residency<Blob>().evicted, 1U);
+		EXPECT_EQ(store.resources().loaded("blob.bin"), false);
+		EXPECT_EQ(Resources::s_bytes.load(), before);
+		EXPECT_EQ(store.find<Blob>("a").has_value(), true);
+		EXPECT_EQ(store.resources().loaded("blob.bin"), true);
+	}
+	std::filesystem::remove_all(dir);
+}
+} // namespace
@@ -0,0 +1,99 @@
+#include <chrono>
+#include <iostream>
+#include <mutex>
+#include <shared_mutex>
+#include <thread>
+#include <typeinfo>
+#include <core/ensure.hpp>
+#include <engine/assets/asset_store.hpp>
+
+using namespace le;
+
+namespace {
+using clock_t = std::chrono::steady_clock;
+
+constexpr std::size_t maxThreads = 16;
+constexpr std::size_t assetCount = 1024;
+constexpr std::size_t lookupsPerThread = 200000;
+
+struct Blob {
+	u64 value = 0;
+};
+
+struct Sampler {
+	u64 value = 0;
+};
+
+// previous AssetStore read path: shared lock on all assets, typeid lookup, exclusive lock on delegates
+struct Baseline {
+	struct Entry {
+		Blob blob;
+		Delegate<>* onModified = {};
+	};
+
+	mutable std::shared_mutex assetsMutex;
+	std::unordered_map<std::size_t, std::unordered_map<Hash, Entry>> storeMap;
+	mutable std::mutex delegatesMutex;
+	mutable std::unordered_map<Hash, Delegate<>> delegates;
+
+	Blob const* find(Hash id) const {
+		std::shared_lock lock(assetsMutex);
+		if (auto it = storeMap.find(typeid(Blob).hash_code()); it != storeMap.end()) {
+			if (auto entry = it->second.find(id); entry != it->second.end()) {
+				std::scoped_lock dlock(delegatesMutex);
+				[[maybe_unused]] auto& onModified = delegates[id];
+				return &entry->second.blob;
+			}
+		}
+		return nullptr;
+	}
+};
+
+std::string assetID(std::size_t idx) { return "blobs/" + std::to_string(idx); }
+
+template <typename F>
+f64 run(std::string_view name, std::size_t threadCount, F find) {
+	std::vector<Hash> ids;
+	for (std::size_t idx = 0; idx < assetCount; ++idx) { ids.push_back(assetID(idx)); }
+	std::atomic<u64> sum = 0;
+	auto const start = clock_t::now();
+	std::vector<std::thread> threads;
+	for (std::size_t t = 0; t < threadCount; ++t) {
+		threads.emplace_back([&ids, &sum, &find, t]() {
+			u64 local = 0;
+			std::size_t idx = t * 7919;
+			for (std::size_t i = 0; i < lookupsPerThread; ++i) {
+				idx = (idx * 1103515245 + 12345) % ids.size();
+				local += find(ids[idx]);
+			}
+			sum += local;
+		});
+	}
+	for (auto& thread : threads) { thread.join(); }
+	f64 const ms = std::chrono::duration<f64, std::milli>(clock_t::now() - start).count();
+	ensure(sum > 0, "Invalid lookups");
+	f64 const nsPerLookup = ms * 1e6 / f64(lookupsPerThread);
+	std::cout << name << ": " << threadCount << " threads x " << lookupsPerThread << " lookups in " << ms << "ms (" << nsPerLookup << "ns / lookup / thread)\n";
+	return ms;
+}
+} // namespace
+
+int main() {
+	Baseline baseline;
+	AssetStore store;
+	store.add("samplers/default", Sampler{1});
+	for (std::size_t idx = 0; idx < assetCount; ++idx) {
+		baseline.storeMap[typeid(Blob).hash_code()][assetID(idx)] = {Blob{idx + 1}, {}};
+		store.add(assetID(idx), Blob{idx + 1});
+	}
+	// contention only shows with as many cores as threads: on fewer cores this mostly measures per-lookup overhead
+	auto const cores = std::thread::hardware_concurrency();
+	std::cout << "hardware threads: " << cores << (cores < maxThreads ? " (fewer than benchmark threads: contention understated)" : "") << "\n";
+	for (std::size_t threads = 1; threads <= maxThreads; threads *= 4) {
+		f64 const before = run("Baseline (global locks)", threads, [&baseline](Hash id) { return baseline.find(id)->value; });
+		f64 const after = run("AssetStore::find", threads, [&store](Hash id) { return store.find<Blob>(id)->get().value; });
+		run("AssetStore::find (+ Sampler)", threads,
+			[&store](Hash id) { return store.find<Blob>(id)->get().value + store.get<Sampler>("samplers/default")->value; });
+		std::cout << "speedup (" << threads << " threads): " << before / after << "x\n";
+	}
+}
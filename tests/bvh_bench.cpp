@@ -0,0 +1,149 @@
+#include <chrono>
+#include <iostream>
+#include <string_view>
+#include <core/ensure.hpp>
+#include <core/maths.hpp>
+#include <engine/scene/bvh.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+using namespace le;
+
+namespace {
+using clock_t = std::chrono::steady_clock;
+
+constexpr std::size_t queryCount = 1000;
+
+f64 elapsed(clock_t::time_point start) { return std::chrono::duration<f64>(clock_t::now() - start).count(); }
+
+BVH::AABB box(glm::vec3 const& centre, f32 half) { return {centre - glm::vec3(half), centre + glm::vec3(half)}; }
+
+glm::vec3 randomPoint(f32 extent) {
+	return {maths::randomRange(-extent, extent), maths::randomRange(-extent, extent), maths::randomRange(-extent, extent)};
+}
+
+glm::vec3 randomDirection() {
+	glm::vec3 ret = randomPoint(1.0f);
+	while (glm::dot(ret, ret) < 0.01f) { ret = randomPoint(1.0f); }
+	return glm::normalize(ret);
+}
+
+// 60 degree camera at a random point looking in a random direction, far plane at depth
+graphics::Frustum randomFrustum(f32 extent, f32 depth) {
+	glm::vec3 const eye = randomPoint(extent);
+	glm::vec3 const dir = randomDirection();
+	glm::vec3 const up = std::abs(dir.y) > 0.99f ? glm::vec3(1.0f, 0.0f, 0.0f) : glm::vec3(0.0f, 1.0f, 0.0f);
+	return graphics::Frustum::make(glm::perspective(glm::radians(60.0f), 16.0f / 9.0f, 0.1f, depth) * glm::lookAt(eye, eye + dir, up));
+}
+
+struct Timed {
+	f64 bvh = 0.0;
+	f64 linear = 0.0;
+	std::size_t hits = 0;
+	std::size_t expected = 0;
+};
+
+// time queries via the BVH against a linear scan over all (fat) AABBs, counting hits of each
+template <typename Q, typename B, typename L>
+Timed timed(std::vector<Q> const& queries, std::vector<BVH::Proxy> const& proxies, BVH const& bvh, B byBVH, L byLinear) {
+	Timed ret;
+	auto start = clock_t::now();
+	for (auto const& query : queries) { ret.hits += byBVH(query); }
+	ret.bvh = elapsed(start);
+	start = clock_t::now();
+	for (auto const& query : queries) {
+		for (auto const proxy : proxies) {
+			if (byLinear(query, bvh.fatAABB(proxy))) { ++ret.expected; }
+		}
+	}
+	ret.linear = elapsed(start);
+	return ret;
+}
+
+void report(std::string_view name, Timed const& timed) {
+	std::cout << "  " << name << f64(queryCount) / timed.bvh << " / sec (linear: " << f64(queryCount) / timed.linear << " / sec, " << timed.hits << " hits)\n";
+}
+
+bool run(std::size_t count) {
+	f32 const extent = std::cbrt(f32(count)) * 4.0f;
+	std::vector<glm::vec3> centres;
+	std::vector<BVH::Proxy> proxies;
+	centres.reserve(count);
+	proxies.reserve(count);
+	for (std::size_t idx = 0; idx < count; ++idx) { centres.push_back(randomPoint(extent)); }
+	BVH bvh;
+	auto start = clock_t::now();
+	for (std::size_t idx = 0; idx < count; ++idx) { proxies.push_back(bvh.insert(box(centres[idx], 0.5f), idx)); }
+	f64 const insert = elapsed(start);
+	// refit: move 10% of objects (most stay within their fat AABBs)
+	std::size_t const moved = count / 10;
+	start = clock_t::now();
+	for (std::size_t idx = 0; idx < moved; ++idx) {
+		std::size_t const obj = (idx * 7919) % count;
+		centres[obj] += randomPoint(0.2f);
+		bvh.update(proxies[obj], box(centres[obj], 0.5f));
+	}
+	f64 const refit = elapsed(start);
+	std::vector<BVH::AABB> boxes;
+	std::vector<graphics::Frustum> frusta;
+	std::vector<BVH::Ray> rays;
+	for (std::size_t idx = 0; idx < queryCount; ++idx) {
+		boxes.push_back(box(randomPoint(extent), 4.0f));
+		frusta.push_back(randomFrustum(extent, 16.0f));
+		rays.push_back({randomPoint(extent), randomDirection(), 2.0f * extent});
+	}
+	auto const aabbs = timed(
+		boxes, proxies, bvh,
+		[&bvh](BVH::AABB const& query) {
+			std::size_t hits = 0;
+			bvh.query(query, [&hits](u64) {
+				++hits;
+				return true;
+			});
+			return hits;
+		},
+		[](BVH::AABB const& query, BVH::AABB const& aabb) { return BVH::overlap(query, aabb); });
+	auto const frustums = timed(
+		frusta, proxies, bvh,
+		[&bvh](graphics::Frustum const& query) {
+			std::size_t hits = 0;
+			bvh.query(query, [&hits](u64) {
+				++hits;
+				return true;
+			});
+			return hits;
+		},
+		[](graphics::Frustum const& query, BVH::AABB const& aabb) { return BVH::intersect(query, aabb); });
+	auto const raycasts = timed(
+		rays, proxies, bvh,
+		[&bvh](BVH::Ray const& query) {
+			std::size_t hits = 0;
+			bvh.query(query, [&hits](u64, f32) {
+				++hits;
+				return true;
+			});
+			return hits;
+		},
+		[](BVH::Ray const& query, BVH::AABB const& aabb) {
+			f32 t;
+			return BVH::intersect(query, aabb, t);
+		});
+	std::cout << count << " objects [height " << bvh.height() << "]\n";
+	std::cout << "  insert:  " << f64(count) / insert / 1e6 << "M / sec\n";
+	std::cout << "  refit:   " << f64(moved) / refit / 1e6 << "M / sec\n";
+	report("aabb:    ", aabbs);
+	report("frustum: ", frustums);
+	report("ray:     ", raycasts);
+	bool const ret = aabbs.hits == aabbs.expected && frustums.hits == frustums.expected && raycasts.hits == raycasts.expected;
+	ensure(ret, "Query mismatch");
+	return ret;
+}
+} // namespace
+
+int main(int argc, char const* const argv[]) {
+	// 1M objects (~seconds of linear scans) only on request: bench-bvh --large
+	bool const bLarge = argc > 1 && std::string_view(argv[1]) == "--large";
+	bool bPass = true;
+	for (std::size_t const count : {std::size_t(10000), std::size_t(100000)}) { bPass &= run(count); }
+	if (bLarge) { bPass &= run(1000000); }
+	return bPass ? 0 : 1;
+}
@@ -0,0 +1,105 @@
+#include <array>
+#include <chrono>
+#include <iostream>
+#include <string_view>
+#include <glm/mat4x4.hpp>
+#include <glm/vec4.hpp>
+#include <graphics/context/vram.hpp>
+#include <graphics/render/descriptor_set.hpp>
+#include <graphics/render/uniform_arena.hpp>
+#include "headless_device.hpp"
+
+using namespace le;
+
+namespace {
+using clock_t = std::chrono::steady_clock;
+using test::makeDevice;
+
+constexpr std::size_t objectCount = 10000;
+constexpr std::size_t warmupFrames = 3;
+constexpr std::size_t frameCount = 30;
+
+struct Material {
+	glm::vec4 ambient;
+	glm::vec4 diffuse;
+	glm::vec4 specular;
+	glm::vec4 params;
+};
+
+// set 1 of the demo's lit pipeline: per-object model matrix + material
+std::array<graphics::BindingInfo, 2> bindings(bool dynamic) {
+	auto const ubo = dynamic ? vk::DescriptorType::eUniformBufferDynamic : vk::DescriptorType::eUniformBuffer;
+	std::array<graphics::BindingInfo, 2> ret;
+	ret[0].binding = vk::DescriptorSetLayoutBinding(0, ubo, 1, vk::ShaderStageFlagBits::eVertex);
+	ret[0].name = "model";
+	ret[1].binding = vk::DescriptorSetLayoutBinding(1, ubo, 1, vk::ShaderStageFlagBits::eFragment);
+	ret[1].name = "material";
+	return ret;
+}
+
+// objectCount objects per frame: write uniforms, update descriptors, record binds (no draws / submits)
+void run(graphics::Device& device, graphics::VRAM& vram, bool dynamic) {
+	auto const infos = bindings(dynamic);
+	std::array<vk::DescriptorSetLayoutBinding, 2> const layoutBindings = {infos[0].binding, infos[1].binding};
+	auto setLayout = device.makeDescriptorSetLayout(layoutBindings);
+	auto pipeLayout = device.makePipelineLayout({}, setLayout);
+	auto cmdPool = device.makeCommandPool(vk::CommandPoolCreateFlagBits::eResetCommandBuffer, QType::eGraphics);
+	auto const cb = device.device().allocateCommandBuffers(vk::CommandBufferAllocateInfo(cmdPool, vk::CommandBufferLevel::ePrimary, 1)).front();
+	graphics::UniformArena arena(&vram, {});
+	std::string_view const name = dynamic ? "dynamic offsets" : "set per object";
+	graphics::DescriptorPool pool(&device, {name, setLayout, infos, 2_B, 0});
+	glm::mat4 const model(1.0f);
+	Material const material{};
+	f64 ms = 0.0;
+	u32 writes = 0;
+	for (std::size_t frame = 0; frame < warmupFrames + frameCount; ++frame) {
+		bool const timed = frame >= warmupFrames;
+		pool.swap();
+		arena.next();
+		auto const writesBefore = graphics::DescriptorSet::s_writes.load();
+		auto const start = clock_t::now();
+		for (std::size_t idx = 0; idx < objectCount; ++idx) {
+			auto const m = arena.write(model);
+			auto const mat = arena.write(material);
+			if (dynamic) {
+				pool.updateDynamic(0, m, idx);
+				pool.updateDynamic(1, mat, idx);
+			} else {
+				auto& ds = pool.index(idx);
+				ds.update(0, m, vk::DescriptorType::eUniformBuffer);
+				ds.update(1, mat, vk::DescriptorType::eUniformBuffer);
+			}
+		}
+		cb.begin(vk::CommandBufferBeginInfo(vk::CommandBufferUsageFlagBits::eOneTimeSubmit));
+		for (std::size_t idx = 0; idx < objectCount; ++idx) {
+			if (dynamic) {
+				if (auto const set = pool.dynamicSet(idx)) {
+					auto const& [ds, offsets] = *set;
+					cb.bindDescriptorSets(vk::PipelineBindPoint::eGraphics, pipeLayout, 0, ds.get(), vk::ArrayProxy<u32 const>((u32)offsets.size(), offsets.data()));
+				}
+			} else {
+				cb.bindDescriptorSets(vk::PipelineBindPoint::eGraphics, pipeLayout, 0, pool.index(idx).get(), {});
+			}
+		}
+		cb.end();
+		if (timed) {
+			ms += std::chrono::duration<f64, std::milli>(clock_t::now() - start).count();
+			writes += graphics::DescriptorSet::s_writes.load() - writesBefore;
+		}
+	}
+	std::cout << name << ": " << objectCount << " objects, " << ms / f64(frameCount) << "ms / frame, " << writes / frameCount << " descriptor writes / frame, "
+			  << arena.stats().blocks << " arena blocks\n";
+	device.device().waitIdle();
+	device.destroy(cmdPool, pipeLayout, setLayout);
+}
+} // namespace
+
+int main() {
+	graphics::Instance instance;
+	auto device = makeDevice(instance);
+	if (!device) { return 0; }
+	graphics::VRAM vram(&*device);
+	run(*device, vram, false);
+	run(*device, vram, true);
+	vram.waitIdle();
+}
@@ -0,0 +1,50 @@
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <thread>
+#include <core/io/file_watcher.hpp>
+#include <ktest/ktest.hpp>
+
+namespace {
+using namespace le;
+namespace stdfs = std::filesystem;
+
+void write(stdfs::path const& path, std::string_view text) { std::ofstream(path) << text; }
+
+// events are delivered by the watcher thread: wait (bounded) for one
+bool consumed(io::FileWatcher& watcher, stdfs::path const& path) {
+	for (int i = 0; i < 200; ++i) {
+		if (watcher.consume(path)) { return true; }
+		std::this_thread::sleep_for(std::chrono::milliseconds(5));
+	}
+	return false;
+}
+
+TEST(file_watcher_lost_directory) {
+	if (!io::FileWatcher::supported()) { return; }
+	auto const dir = stdfs::temp_directory_path() / "levk_watcher_test";
+	auto const file = dir / "file.txt";
+	stdfs::remove_all(dir);
+	stdfs::create_directories(dir);
+	write(file, "0");
+	io::FileWatcher watcher;
+	EXPECT_EQ(watcher.watch(file), true);
+	EXPECT_EQ(watcher.consume(file), false);
+	write(file, "1");
+	EXPECT_EQ(consumed(watcher, file), true);
+	// watch lost: the file must be polled until its directory is watched again
+	stdfs::remove_all(dir);
+	EXPECT_EQ(consumed(watcher, file), true);
+	EXPECT_EQ(watcher.consume(file), true);
+	stdfs::create_directories(dir);
+	write(file, "2");
+	EXPECT_EQ(watcher.consume(file), true);
+	// re-watched: events again
+	for (int i = 0; i < 10 && watcher.consume(file); ++i) { std::this_thread::sleep_for(std::chrono::milliseconds(5)); }
+	EXPECT_EQ(watcher.consume(file), false);
+	write(file, "3");
+	EXPECT_EQ(consumed(watcher, file), true);
+	watcher.unwatch(file);
+	stdfs::remove_all(dir);
+}
+} // namespace
@@ -0,0 +1,59 @@
+#include <string>
+#include <core/flat_map.hpp>
+#include <ktest/ktest.hpp>
+
+namespace {
+using namespace le;
+
+struct Triple {
+	int v, n, t;
+
+	bool operator==(Triple const&) const = default;
+};
+
+// Every key collides: lookups must still distinguish keys
+struct CollidingHasher {
+	std::size_t operator()(Triple const&) const noexcept { return 42; }
+};
+
+TEST(flat_map_insert_find) {
+	FlatMap<int, std::string> map;
+	for (int i = 0; i < 1000; ++i) { EXPECT_EQ(map.emplace(i, std::to_string(i)).second, true); }
+	EXPECT_EQ(map.size(), 1000U);
+	for (int i = 0; i < 1000; ++i) {
+		auto const str = map.find(i);
+		EXPECT_EQ(str && *str == std::to_string(i), true);
+	}
+	EXPECT_EQ(map.find(1000) == nullptr, true);
+	EXPECT_EQ(map.emplace(7, "x").second, false);
+	EXPECT_EQ(*map.find(7), "7");
+}
+
+TEST(flat_map_collisions) {
+	FlatMap<Triple, u32, CollidingHasher> map;
+	u32 next = 0;
+	for (int v = 0; v < 8; ++v) {
+		for (int n = 0; n < 8; ++n) {
+			for (int t = 0; t < 8; ++t) {
+				auto const [value, inserted] = map.emplace({v, n, t}, next);
+				EXPECT_EQ(inserted, true);
+				EXPECT_EQ(*value, next);
+				++next;
+			}
+		}
+	}
+	EXPECT_EQ(map.size(), std::size_t(next));
+	EXPECT_EQ(*map.find({3, 1, 4}), u32(3 * 64 + 1 * 8 + 4));
+	EXPECT_EQ(map.find({8, 0, 0}) == nullptr, true);
+}
+
+TEST(flat_map_clear_reserve) {
+	FlatMap<int, int> map(100);
+	auto const capacity = map.capacity();
+	for (int i = 0; i < 100; ++i) { map.emplace(i, i * 2); }
+	EXPECT_EQ(map.capacity(), capacity);
+	map.clear();
+	EXPECT_EQ(map.empty(), true);
+	EXPECT_EQ(map.find(10) == nullptr, true);
+}
+} // namespace
@@ -0,0 +1,24 @@
+#pragma once
+#include <array>
+#include <iostream>
+#include <optional>
+#include <string_view>
+#include <graphics/context/device.hpp>
+#include <graphics/context/instance.hpp>
+
+namespace le::test {
+// headless: no window / swapchain required (lavapipe et al)
+inline std::optional<graphics::Device> makeDevice(graphics::Instance& out_instance) {
+	try {
+		static constexpr std::array<std::string_view, 2> extensions = {VK_KHR_SURFACE_EXTENSION_NAME, VK_EXT_HEADLESS_SURFACE_EXTENSION_NAME};
+		graphics::Instance::CreateInfo instanceInfo;
+		instanceInfo.extensions = extensions;
+		out_instance = graphics::Instance(instanceInfo);
+		auto surface = out_instance.instance().createHeadlessSurfaceEXT(vk::HeadlessSurfaceCreateInfoEXT(), nullptr, out_instance.loader());
+		return std::optional<graphics::Device>(std::in_place, &out_instance, surface, graphics::Device::CreateInfo{});
+	} catch (std::exception const& e) {
+		std::cout << "No headless Vulkan device (" << e.what() << "); skipping\n";
+	}
+	return std::nullopt;
+}
+} // namespace le::test
@@ -0,0 +1,32 @@
+#pragma once
+#include <cstring>
+#include <sstream>
+#include <unordered_map>
+#include <core/io/reader.hpp>
+
+namespace le::test {
+// in-memory io::Reader: files keyed on generic path strings
+class MemReader final : public io::Reader {
+  public:
+	std::unordered_map<std::string, std::string> m_files;
+
+	Result<bytearray> bytes(io::Path const& id) const override {
+		if (auto it = m_files.find(id.generic_string()); it != m_files.end()) {
+			bytearray ret(it->second.size());
+			std::memcpy(ret.data(), it->second.data(), ret.size());
+			return ret;
+		}
+		return kt::null_result;
+	}
+	Result<std::stringstream> sstream(io::Path const& id) const override {
+		if (auto it = m_files.find(id.generic_string()); it != m_files.end()) { return std::stringstream(it->second); }
+		return kt::null_result;
+	}
+
+  protected:
+	Result<io::Path> findPrefixed(io::Path const& id) const override {
+		if (m_files.contains(id.generic_string())) { return io::Path(id); }
+		return kt::null_result;
+	}
+};
+} // namespace le::test
@@ -0,0 +1,92 @@
+#include <chrono>
+#include <iostream>
+#include <sstream>
+#include <unordered_map>
+#include <core/ensure.hpp>
+#include <engine/render/model.hpp>
+#include <glm/gtx/hash.hpp>
+#include "mem_reader.hpp"
+
+using namespace le;
+
+namespace {
+using clock_t = std::chrono::steady_clock;
+using test::MemReader;
+
+constexpr u32 side = 708; // (side - 1)^2 * 2 ~= 1M triangles
+
+std::string makeGrid() {
+	std::stringstream str;
+	for (u32 y = 0; y < side; ++y) {
+		for (u32 x = 0; x < side; ++x) { str << "v " << x << ' ' << y << " 0\nvt " << f32(x) / side << ' ' << f32(y) / side << '\n'; }
+	}
+	str << "vn 0 0 1\n";
+	for (u32 y = 0; y + 1 < side; ++y) {
+		for (u32 x = 0; x + 1 < side; ++x) {
+			u32 const i = y * side + x + 1;
+			u32 const j = i + side;
+			str << "f " << i << '/' << i << "/1 " << i + 1 << '/' << i + 1 << "/1 " << j << '/' << j << "/1\n";
+			str << "f " << i + 1 << '/' << i + 1 << "/1 " << j + 1 << '/' << j + 1 << "/1 " << j << '/' << j << "/1\n";
+		}
+	}
+	return str.str();
+}
+
+f32 acmr(graphics::Geometry const& geom) { return graphics::vertexCacheACMR(geom.indices, (u32)geom.vertices.size()); }
+
+graphics::Geometry run(MemReader const& reader, std::string_view name) {
+	auto const start = clock_t::now();
+	auto info = Model::load("grid", "grid/grid.json", reader);
+	f64 const secs = std::chrono::duration<f64>(clock_t::now() - start).count();
+	ensure(info.has_value() && info->meshes.size() == 1, "Load failed");
+	auto geom = std::move(info->meshes.front().geometry);
+	std::cout << name << ": " << secs * 1000.0 << "ms, " << geom.vertices.size() << " vertices, " << geom.indices.size() / 3 << " triangles, ACMR "
+			  << acmr(geom) << "\n";
+	ensure(geom.vertices.size() == side * side, "Vertex dedup failed");
+	return geom;
+}
+
+// previous OBJReader dedup: vertices keyed on a shifting XOR hash of their values, equal hashes merged (even if distinct)
+void runHashed(graphics::Geometry const& source) {
+	struct IncrHasher {
+		std::size_t count = 0;
+
+		template <typename T>
+		std::size_t operator()(T const& t) noexcept {
+			return std::hash<T>{}(t) << count++;
+		}
+	};
+	graphics::Geometry geom;
+	std::unordered_map<std::size_t, u32> vertIndices;
+	std::size_t merged = 0;
+	auto const start = clock_t::now();
+	for (u32 const index : source.indices) {
+		auto const& v = source.vertices[index];
+		IncrHasher inc;
+		std::size_t const hash = inc(v.position) ^ inc(v.colour) ^ inc(v.normal) ^ inc(v.texCoord);
+		if (auto const search = vertIndices.find(hash); search != vertIndices.end()) {
+			auto const& found = geom.vertices[search->second];
+			if (found.position != v.position || found.normal != v.normal || found.texCoord != v.texCoord) { ++merged; }
+			geom.indices.push_back(search->second);
+		} else {
+			auto const idx = geom.addVertex(v);
+			geom.indices.push_back(idx);
+			vertIndices.emplace(hash, idx);
+		}
+	}
+	f64 const secs = std::chrono::duration<f64>(clock_t::now() - start).count();
+	std::cout << "Value hash dedup (previous): " << secs * 1000.0 << "ms, " << geom.vertices.size() << " vertices (" << merged
+			  << " indices merged into distinct vertices), ACMR " << acmr(geom) << "\n";
+}
+} // namespace
+
+int main() {
+	MemReader reader;
+	reader.m_files["grid/grid.obj"] = makeGrid();
+	reader.m_files["grid/grid.json"] = R"({ "obj": "grid.obj" })";
+	auto const geom = run(reader, "OBJ load");
+	runHashed(geom);
+	reader.m_files["grid/grid.json"] = R"({ "obj": "grid.obj", "optimise": true })";
+	auto const optimised = run(reader, "OBJ load (optimised)");
+	std::cout << "ACMR: " << acmr(geom) << " -> " << acmr(optimised) << " (optimiseVertexCache)\n";
+}
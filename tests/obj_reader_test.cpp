@@ -0,0 +1,57 @@
+#include <engine/render/model.hpp>
+#include <ktest/ktest.hpp>
+#include "mem_reader.hpp"
+
+namespace {
+using namespace le;
+
+// one triangle's positions / uvs / normals, followed by a second face (f1)
+constexpr std::string_view obj = R"(v 0 0 0
+v 1 0 0
+v 0 1 0
+vt 0 0
+vt 1 0
+vt 0 1
+vn 0 0 1
+vn 0 0 -1
+f 1/1/1 2/2/1 3/3/1
+)";
+
+graphics::Geometry load(std::string_view f1) {
+	test::MemReader reader;
+	reader.m_files["tri/tri.obj"] = std::string(obj) + std::string(f1);
+	reader.m_files["tri/tri.json"] = R"({ "obj": "tri.obj" })";
+	auto info = Model::load("tri", "tri/tri.json", reader);
+	if (!info || info->meshes.size() != 1) { return {}; }
+	return std::move(info->meshes.front().geometry);
+}
+
+TEST(obj_identical_triples_merge) {
+	auto const geom = load("f 1/1/1 2/2/1 3/3/1\n");
+	EXPECT_EQ(geom.vertices.size(), 3U);
+	ASSERT_EQ(geom.indices.size(), 6U);
+	for (std::size_t i = 0; i < 3; ++i) { EXPECT_EQ(geom.indices[i], geom.indices[i + 3]); }
+}
+
+TEST(obj_distinct_normal_kept) {
+	// vertex 1: same position and uv, different normal
+	auto const geom = load("f 1/1/2 2/2/1 3/3/1\n");
+	ASSERT_EQ(geom.vertices.size(), 4U);
+	ASSERT_EQ(geom.indices.size(), 6U);
+	EXPECT_EQ(geom.indices[0] != geom.indices[3], true);
+	EXPECT_EQ(geom.vertices[geom.indices[0]].position == geom.vertices[geom.indices[3]].position, true);
+	EXPECT_EQ(geom.vertices[geom.indices[0]].normal != geom.vertices[geom.indices[3]].normal, true);
+	EXPECT_EQ(geom.indices[1], geom.indices[4]);
+	EXPECT_EQ(geom.indices[2], geom.indices[5]);
+}
+
+TEST(obj_distinct_uv_kept) {
+	// vertex 1: same position and normal, different uv
+	auto const geom = load("f 1/2/1 2/2/1 3/3/1\n");
+	ASSERT_EQ(geom.vertices.size(), 4U);
+	ASSERT_EQ(geom.indices.size(), 6U);
+	EXPECT_EQ(geom.indices[0] != geom.indices[3], true);
+	EXPECT_EQ(geom.vertices[geom.indices[0]].position == geom.vertices[geom.indices[3]].position, true);
+	EXPECT_EQ(geom.vertices[geom.indices[0]].texCoord != geom.vertices[geom.indices[3]].texCoord, true);
+}
+} // namespace
@@ -0,0 +1,143 @@
+#include <array>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <core/ensure.hpp>
+#include <core/io/pak.hpp>
+#include <core/io/reader.hpp>
+#include <core/os.hpp>
+
+using namespace le;
+
+namespace {
+namespace stdfs = std::filesystem;
+using clock_t = std::chrono::steady_clock;
+
+constexpr std::size_t fileCount = 2000;
+constexpr std::size_t maxFileSize = 64 * 1024;
+
+struct File {
+	std::string id;
+	std::string data;
+};
+
+std::vector<File> makeFiles() {
+	std::mt19937 engine(42);
+	std::uniform_int_distribution<std::size_t> size(1, maxFileSize);
+	std::uniform_int_distribution<int> ch('a', 'z');
+	std::vector<File> ret;
+	for (std::size_t i = 0; i < fileCount; ++i) {
+		File file{"dir_" + std::to_string(i % 16) + "/file_" + std::to_string(i) + ".bin", {}};
+		file.data.resize(size(engine));
+		for (char& c : file.data) { c = (char)ch(engine); }
+		ret.push_back(std::move(file));
+	}
+	return ret;
+}
+
+u32 crc32(std::string_view data) {
+	static auto const table = [] {
+		std::array<u32, 256> ret;
+		for (u32 i = 0; i < 256; ++i) {
+			u32 c = i;
+			for (int k = 0; k < 8; ++k) { c = (c & 1) ? 0xedb88320U ^ (c >> 1) : c >> 1; }
+			ret[i] = c;
+		}
+		return ret;
+	}();
+	u32 ret = 0xffffffffU;
+	for (char const c : data) { ret = table[(ret ^ (u8)c) & 0xff] ^ (ret >> 8); }
+	return ret ^ 0xffffffffU;
+}
+
+// minimal stored (uncompressed) zip writer
+void writeZip(stdfs::path const& path, std::vector<File> const& files) {
+	std::ofstream out(path, std::ios::binary);
+	auto put = [&out](auto t) { out.write(reinterpret_cast<char const*>(&t), sizeof(t)); };
+	std::vector<u32> offsets;
+	for (File const& file : files) {
+		offsets.push_back((u32)out.tellp());
+		put(u32(0x04034b50));
+		put(u16(10));
+		put(u16(0));
+		put(u16(0));
+		put(u32(0));
+		put(crc32(file.data));
+		put(u32(file.data.size()));
+		put(u32(file.data.size()));
+		put(u16(file.id.size()));
+		put(u16(0));
+		out << file.id << file.data;
+	}
+	u32 const cdOffset = (u32)out.tellp();
+	for (std::size_t i = 0; i < files.size(); ++i) {
+		File const& file = files[i];
+		put(u32(0x02014b50));
+		put(u16(20));
+		put(u16(10));
+		put(u16(0));
+		put(u16(0));
+		put(u32(0));
+		put(crc32(file.data));
+		put(u32(file.data.size()));
+		put(u32(file.data.size()));
+		put(u16(file.id.size()));
+		put(u16(0));
+		put(u16(0));
+		put(u16(0));
+		put(u16(0));
+		put(u32(0));
+		put(offsets[i]);
+		out << file.id;
+	}
+	u32 const cdSize = (u32)out.tellp() - cdOffset;
+	put(u32(0x06054b50));
+	put(u16(0));
+	put(u16(0));
+	put(u16(files.size()));
+	put(u16(files.size()));
+	put(cdSize);
+	put(cdOffset);
+	put(u16(0));
+}
+
+template <typename R>
+void run(std::string_view name, io::Path const& mount, std::vector<File> const& files) {
+	auto const start = clock_t::now();
+	R reader;
+	ensure(reader.mount(mount), "Mount failed");
+	auto const mounted = clock_t::now();
+	std::size_t bytes = 0;
+	for (File const& file : files) {
+		ensure(reader.present(file.id), "File not present");
+		auto view = reader.view(file.id);
+		ensure(view && view->bytes.size() == file.data.size(), "Invalid data");
+		bytes += view->bytes.size();
+	}
+	auto const done = clock_t::now();
+	auto const ms = [](auto dt) { return std::chrono::duration<f64, std::milli>(dt).count(); };
+	std::cout << name << ": mount " << ms(mounted - start) << "ms, present + view x" << files.size() << " (" << bytes / 1024 << "KiB) " << ms(done - mounted)
+			  << "ms\n";
+}
+} // namespace
+
+int main(int argc, char const* const argv[]) {
+	os::args(os::Args(argv, (std::size_t)argc));
+	auto const root = stdfs::temp_directory_path() / "levk_pak_bench";
+	std::error_code err;
+	stdfs::remove_all(root, err);
+	auto const files = makeFiles();
+	for (File const& file : files) {
+		auto const path = root / "data" / file.id;
+		stdfs::create_directories(path.parent_path());
+		std::ofstream(path, std::ios::binary) << file.data;
+	}
+	writeZip(root / "data.zip", files);
+	ensure(io::pak::pack((root / "data").string(), (root / "data.pak").string()) == (s64)files.size(), "Pack failed");
+	run<io::FileReader>("FileReader", (root / "data").string(), files);
+	run<io::ZIPReader>("ZIPReader", (root / "data.zip").string(), files);
+	run<io::PakReader>("PakReader", (root / "data.pak").string(), files);
+	stdfs::remove_all(root, err);
+}
@@ -0,0 +1,62 @@
+#include <filesystem>
+#include <fstream>
+#include <core/io/pak.hpp>
+#include <core/io/reader.hpp>
+#include <ktest/ktest.hpp>
+
+namespace {
+using namespace le;
+namespace stdfs = std::filesystem;
+
+constexpr std::string_view name = "a";
+constexpr std::string_view data = "01234567";
+
+// [Header] [data] [names] [Entry]
+stdfs::path write(std::string_view file, io::pak::Entry entry) {
+	auto const path = stdfs::temp_directory_path() / file;
+	io::pak::Header header;
+	header.count = 1;
+	header.namesOffset = sizeof(header) + data.size();
+	header.tableOffset = header.namesOffset + name.size() + 7; // aligned to Entry
+	entry.hash = io::pak::hash(name);
+	std::ofstream out(path, std::ios::binary);
+	out.write(reinterpret_cast<char const*>(&header), sizeof(header));
+	out.write(data.data(), (std::streamsize)data.size());
+	out.write(name.data(), (std::streamsize)name.size());
+	out.write("\0\0\0\0\0\0\0", 7);
+	out.write(reinterpret_cast<char const*>(&entry), sizeof(entry));
+	return path;
+}
+
+io::pak::Entry valid() {
+	io::pak::Entry ret;
+	ret.offset = sizeof(io::pak::Header);
+	ret.size = data.size();
+	ret.nameOffset = 0;
+	ret.nameSize = (u32)name.size();
+	return ret;
+}
+
+bool present(stdfs::path const& path) {
+	io::PakReader reader;
+	bool const ret = reader.mount(path.string()) && reader.present(std::string(name));
+	stdfs::remove(path);
+	return ret;
+}
+
+TEST(pak_valid_entry) { EXPECT_EQ(present(write("levk_pak_valid.pak", valid())), true); }
+
+TEST(pak_overflowing_data_range) {
+	auto entry = valid();
+	// offset + size wraps around to within the data section
+	entry.offset = ~u64(0) - 3;
+	EXPECT_EQ(present(write("levk_pak_data.pak", entry)), false);
+}
+
+TEST(pak_overflowing_name_range) {
+	auto entry = valid();
+	entry.nameOffset = ~u64(0) - 2;
+	entry.nameSize = 4;
+	EXPECT_EQ(present(write("levk_pak_name.pak", entry)), false);
+}
+} // namespace
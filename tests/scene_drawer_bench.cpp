@@ -0,0 +1,109 @@
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <core/ensure.hpp>
+#include <core/maths.hpp>
+#include <dumb_ecf/registry.hpp>
+#include <dumb_tasks/scheduler.hpp>
+#include <engine/scene/scene_drawer.hpp>
+#include <engine/scene/scene_node.hpp>
+
+using namespace le;
+
+namespace {
+using clock_t = std::chrono::steady_clock;
+
+constexpr std::size_t entityCount = 100000;
+constexpr std::size_t frameCount = 30;
+constexpr std::size_t movedPerFrame = entityCount / 100;
+constexpr std::size_t groupCount = 8;
+
+struct Scene {
+	SceneNode::Root root;
+	decf::registry_t registry;
+	std::vector<decf::entity_t> entities;
+	PrimList prims = PrimList(1);
+
+	Scene() {
+		entities.reserve(entityCount);
+		for (std::size_t idx = 0; idx < entityCount; ++idx) {
+			auto entity = registry.spawn<SceneNode>("e" + std::to_string(idx), &root);
+			entity.get<SceneNode>().entity(entity);
+			entity.get<SceneNode>().position({f32(idx % 100), f32(idx / 100), 0.0f});
+			// pipelines are never dereferenced; only used as keys
+			auto const pipe = reinterpret_cast<graphics::Pipeline*>(std::uintptr_t(0x1000 * (idx % groupCount + 1)));
+			SceneDrawer::attach(registry, entity, {pipe, s64(idx % groupCount)}, prims);
+			entities.push_back(entity);
+		}
+	}
+
+	void tick(std::size_t frame) {
+		for (std::size_t idx = 0; idx < movedPerFrame; ++idx) {
+			auto const entity = entities[(frame * movedPerFrame + idx) % entities.size()];
+			registry.get<SceneNode>(entity).rotate(0.01f, {0.0f, 1.0f, 0.0f});
+		}
+	}
+};
+
+std::size_t itemCount(Span<SceneDrawer::Group const> groups) {
+	std::size_t ret = 0;
+	for (auto const& group : groups) { ret += group.items.size(); }
+	return ret;
+}
+
+template <typename F>
+f64 run(std::string_view name, Scene& scene, F&& build) {
+	std::size_t items = 0;
+	auto const start = clock_t::now();
+	for (std::size_t frame = 0; frame < frameCount; ++frame) {
+		scene.tick(frame);
+		items = build();
+	}
+	f64 const ms = std::chrono::duration<f64, std::milli>(clock_t::now() - start).count() / f64(frameCount);
+	ensure(items == entityCount, "Item count mismatch");
+	std::cout << name << ": " << ms << "ms / frame [" << items << " items]\n";
+	return ms;
+}
+
+// item order within a group may differ (after add() / remove() events): compare models ordered by (unique) positions
+bool matches(decf::registry_t const& registry, Span<SceneDrawer::Group const> cached) {
+	auto const models = [](SceneDrawer::Group const& group) {
+		std::vector<glm::mat4> ret;
+		for (auto const& item : group.items) { ret.push_back(item.model); }
+		std::sort(ret.begin(), ret.end(), [](glm::mat4 const& a, glm::mat4 const& b) { return std::pair(a[3].x, a[3].y) < std::pair(b[3].x, b[3].y); });
+		return ret;
+	};
+	auto const fresh = SceneDrawer::groups(registry, true);
+	bool bPass = fresh.size() == cached.size();
+	for (std::size_t idx = 0; bPass && idx < fresh.size(); ++idx) {
+		bPass = fresh[idx].group == cached[idx].group && models(fresh[idx]) == models(cached[idx]);
+	}
+	return bPass;
+}
+} // namespace
+
+int main() {
+	Scene scene;
+	dts::scheduler scheduler;
+	SceneDrawer::Builder serial, parallel;
+	run("SceneDrawer::groups", scene, [&scene]() { return itemCount(SceneDrawer::groups(scene.registry, true)); });
+	run("SceneDrawer::Builder", scene, [&]() { return itemCount(serial.build(scene.registry, true)); });
+	run("SceneDrawer::Builder (scheduler)", scene, [&]() { return itemCount(parallel.build(scene.registry, true, &scheduler)); });
+	bool bPass = matches(scene.registry, parallel.groups());
+	// structural changes are only picked up via add() / remove() events
+	auto const regrouped = DrawGroup{reinterpret_cast<graphics::Pipeline*>(std::uintptr_t(0x1000)), s64(groupCount)};
+	for (std::size_t idx = 0; idx < movedPerFrame; ++idx) {
+		auto const entity = scene.entities[idx * 3];
+		if (idx % 2 == 0) {
+			scene.registry.detach<PrimList>(entity);
+			parallel.remove(entity);
+		} else {
+			scene.registry.get<DrawGroup>(entity) = regrouped;
+			parallel.add(entity);
+		}
+	}
+	scene.tick(0);
+	parallel.build(scene.registry, true, &scheduler);
+	bPass &= matches(scene.registry, parallel.groups());
+	return bPass ? 0 : 1;
+}
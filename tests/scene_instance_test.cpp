@@ -0,0 +1,95 @@
+#include <cstdint>
+#include <engine/scene/scene_drawer.hpp>
+#include <ktest/ktest.hpp>
+
+namespace {
+using namespace le;
+
+// meshes are never dereferenced; only used as keys
+graphics::Mesh const* mesh(std::uintptr_t id) { return reinterpret_cast<graphics::Mesh const*>(0x1000 * id); }
+
+Primitive prim(std::uintptr_t meshID, f32 Ns = 42.0f) {
+	Primitive ret;
+	ret.mesh = mesh(meshID);
+	ret.material.Ns = Ns;
+	return ret;
+}
+
+glm::mat4 model(f32 x) { return glm::mat4(1.0f) + glm::mat4(x); }
+
+struct Items {
+	std::vector<PrimList> prims;
+	std::vector<SceneDrawer::Item> items;
+
+	Items& add(Primitive const& p, f32 x, std::optional<vk::Rect2D> scissor = std::nullopt) {
+		prims.push_back({p});
+		items.push_back({model(x), scissor, {}});
+		return *this;
+	}
+
+	Span<SceneDrawer::Item const> get() {
+		for (std::size_t idx = 0; idx < items.size(); ++idx) { items[idx].primitives = prims[idx]; }
+		return items;
+	}
+};
+
+TEST(instancer_unordered_buckets) {
+	Items items;
+	items.add(prim(1), 0.0f).add(prim(2), 1.0f).add(prim(1), 2.0f).add(prim(1, 8.0f), 3.0f);
+	SceneDrawer::Instancer instancer;
+	std::vector<SceneDrawer::Instances> out;
+	instancer.instance(out, items.get(), false);
+	// A(X), B(Y), C(X), D(X, other material) => {A+C}, B, D
+	EXPECT_EQ(out.size(), 3U);
+	EXPECT_EQ(out[0].primitive->mesh == mesh(1), true);
+	EXPECT_EQ(out[0].models.size(), 2U);
+	EXPECT_EQ(out[0].models[1] == model(2.0f), true);
+	EXPECT_EQ(out[1].primitive->mesh == mesh(2), true);
+	EXPECT_EQ(out[2].models.size(), 1U);
+	EXPECT_EQ(out[2].primitive->material.Ns, 8.0f);
+}
+
+TEST(instancer_ordered_adjacent_runs) {
+	Items items;
+	items.add(prim(1), 0.0f).add(prim(1), 1.0f).add(prim(2), 2.0f).add(prim(1), 3.0f);
+	SceneDrawer::Instancer instancer;
+	std::vector<SceneDrawer::Instances> out;
+	instancer.instance(out, items.get(), true);
+	// A(X), B(X), C(Y), D(X) => {A+B}, C, D: D is still drawn after C
+	EXPECT_EQ(out.size(), 3U);
+	EXPECT_EQ(out[0].models.size(), 2U);
+	EXPECT_EQ(out[1].primitive->mesh == mesh(2), true);
+	EXPECT_EQ(out[2].primitive->mesh == mesh(1), true);
+	EXPECT_EQ(out[2].models[0] == model(3.0f), true);
+}
+
+TEST(instancer_scissored_never_merged) {
+	Items items;
+	vk::Rect2D const rect({0, 0}, {8, 8});
+	items.add(prim(1), 0.0f, rect).add(prim(1), 1.0f).add(prim(1), 2.0f, rect).add(prim(1), 3.0f);
+	SceneDrawer::Instancer instancer;
+	std::vector<SceneDrawer::Instances> out;
+	instancer.instance(out, items.get(), true);
+	EXPECT_EQ(out.size(), 4U);
+	instancer.instance(out, items.get(), false);
+	// unscissored B and D merge, scissored stay separate
+	EXPECT_EQ(out.size(), 3U);
+	EXPECT_EQ(out[1].models.size(), 2U);
+	EXPECT_EQ(out[0].scissor.has_value() && out[2].scissor.has_value(), true);
+}
+
+TEST(instancer_reuse) {
+	Items first, second;
+	first.add(prim(1), 0.0f).add(prim(1), 1.0f);
+	second.add(prim(2), 0.0f).add(prim(1), 1.0f);
+	SceneDrawer::Instancer instancer;
+	std::vector<SceneDrawer::Instances> out;
+	instancer.instance(out, first.get(), false);
+	EXPECT_EQ(out.size(), 1U);
+	// stale bucket indices from the previous call must not leak into this one
+	instancer.instance(out, second.get(), false);
+	EXPECT_EQ(out.size(), 2U);
+	EXPECT_EQ(out[1].primitive->mesh == mesh(1), true);
+	EXPECT_EQ(out[1].models.size(), 1U);
+}
+} // namespace
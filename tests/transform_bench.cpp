@@ -0,0 +1,72 @@
+#include <chrono>
+#include <iostream>
+#include <core/ensure.hpp>
+#include <core/maths.hpp>
+#include <engine/scene/transform_pool.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+using namespace le;
+
+namespace {
+using clock_t = std::chrono::steady_clock;
+
+constexpr std::size_t count = 1 << 18;
+constexpr std::size_t passes = 20;
+
+glm::mat4 glmTRS(SceneTransform const& t) {
+	static constexpr auto base = glm::mat4(1.0f);
+	return glm::translate(base, t.position) * glm::toMat4(t.orientation) * glm::scale(base, t.scale);
+}
+
+template <typename F>
+void run(std::string_view name, F&& compose) {
+	auto const start = clock_t::now();
+	for (std::size_t pass = 0; pass < passes; ++pass) { compose(); }
+	f64 const secs = std::chrono::duration<f64>(clock_t::now() - start).count();
+	std::cout << name << ": " << f64(count * passes) / secs / 1e6 << "M matrices / sec\n";
+}
+
+bool equal(glm::mat4 const& lhs, glm::mat4 const& rhs) {
+	for (int c = 0; c < 4; ++c) {
+		for (int r = 0; r < 4; ++r) {
+			if (!maths::equals(lhs[c][r], rhs[c][r], 0.0001f)) { return false; }
+		}
+	}
+	return true;
+}
+} // namespace
+
+int main() {
+	std::vector<SceneTransform> transforms;
+	TransformPool pool;
+	transforms.reserve(count);
+	pool.reserve(count);
+	for (std::size_t idx = 0; idx < count; ++idx) {
+		SceneTransform t;
+		t.position = {maths::randomRange(-100.0f, 100.0f), maths::randomRange(-100.0f, 100.0f), maths::randomRange(-100.0f, 100.0f)};
+		glm::vec3 const axis = glm::normalize(glm::vec3(maths::randomRange(0.1f, 1.0f), maths::randomRange(0.1f, 1.0f), maths::randomRange(0.1f, 1.0f)));
+		t.orientation = glm::angleAxis(maths::randomRange(0.0f, 6.0f), axis);
+		t.scale = {maths::randomRange(0.5f, 2.0f), maths::randomRange(0.5f, 2.0f), maths::randomRange(0.5f, 2.0f)};
+		transforms.push_back(t);
+		pool.push(t);
+	}
+	std::vector<glm::mat4> glmOut(count), scalarOut(count), poolOut(count);
+	run("glm (T * R * S)", [&]() {
+		for (std::size_t idx = 0; idx < count; ++idx) { glmOut[idx] = glmTRS(transforms[idx]); }
+	});
+	run("SceneTransform::matrix", [&]() {
+		for (std::size_t idx = 0; idx < count; ++idx) { scalarOut[idx] = transforms[idx].matrix(); }
+	});
+	run("TransformPool::compose", [&]() { pool.compose(poolOut); });
+	// SceneNode path: every slot dirty, recomposed into the pool's cached matrices
+	run("TransformPool::update (all dirty)", [&]() {
+		for (std::size_t idx = 0; idx < count; ++idx) { pool.set(idx, transforms[idx]); }
+		pool.update();
+	});
+	bool bPass = true;
+	for (std::size_t idx = 0; idx < count && bPass; ++idx) {
+		bPass = equal(glmOut[idx], scalarOut[idx]) && equal(glmOut[idx], poolOut[idx]) && equal(glmOut[idx], pool.matrix(idx));
+	}
+	ensure(bPass, "Matrix mismatch");
+	return bPass ? 0 : 1;
+}
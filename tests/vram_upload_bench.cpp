@@ -0,0 +1,161 @@
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <core/ensure.hpp>
+#include <graphics/context/vram.hpp>
+#include <graphics/texture.hpp>
+#include "headless_device.hpp"
+
+using namespace le;
+
+namespace {
+using clock_t = std::chrono::steady_clock;
+using test::makeDevice;
+
+constexpr std::size_t uploadCount = 256;
+constexpr std::size_t uploadSize = 1 << 20;
+constexpr std::size_t layerCount = 6;
+constexpr u32 layerExtent = 256;
+constexpr std::size_t textureCount = 500;
+constexpr std::size_t textureThreads = 8;
+constexpr int textureExtent = 128;
+constexpr std::size_t latencyCount = 500;
+constexpr std::size_t latencySize = 64 << 10;
+
+template <typename F>
+f64 run(std::string_view name, graphics::VRAM& vram, F upload) {
+	std::vector<graphics::Buffer> buffers;
+	std::vector<graphics::VRAM::Future> futures;
+	buffers.reserve(uploadCount);
+	futures.reserve(uploadCount);
+	for (std::size_t idx = 0; idx < uploadCount; ++idx) {
+		buffers.push_back(vram.makeBuffer(uploadSize, vk::BufferUsageFlagBits::eVertexBuffer | vk::BufferUsageFlagBits::eTransferDst, false));
+	}
+	auto const start = clock_t::now();
+	for (auto& buffer : buffers) { futures.push_back(upload(buffer)); }
+	vram.wait(futures);
+	f64 const ms = std::chrono::duration<f64, std::milli>(clock_t::now() - start).count();
+	f64 const mbps = f64(uploadCount * uploadSize) / f64(1 << 20) / (ms / 1000.0);
+	std::cout << name << ": " << uploadCount << " x " << (uploadSize >> 10) << "KiB in " << ms << "ms (" << mbps << " MiB/s)\n";
+	return ms;
+}
+
+f64 runImages(graphics::VRAM& vram, bytearray const& pixels) {
+	std::vector<graphics::Image> images;
+	std::vector<graphics::VRAM::Future> futures;
+	graphics::Image::CreateInfo info;
+	info.createInfo.imageType = vk::ImageType::e2D;
+	info.createInfo.format = vk::Format::eR8G8B8A8Unorm;
+	info.createInfo.extent = vk::Extent3D(layerExtent, layerExtent, 1);
+	info.createInfo.mipLevels = 1;
+	info.createInfo.arrayLayers = (u32)layerCount;
+	info.createInfo.flags = vk::ImageCreateFlagBits::eCubeCompatible;
+	info.createInfo.usage = vk::ImageUsageFlagBits::eTransferDst | vk::ImageUsageFlagBits::eSampled;
+	info.queueFlags = QFlags(QType::eGraphics) | QType::eTransfer;
+	info.vmaUsage = VMA_MEMORY_USAGE_GPU_ONLY;
+	std::array<graphics::BMPview, layerCount> layers;
+	for (auto& layer : layers) { layer = pixels; }
+	for (std::size_t idx = 0; idx < uploadCount / layerCount; ++idx) { images.emplace_back(&vram, info); }
+	auto const start = clock_t::now();
+	for (auto& image : images) { futures.push_back(vram.copy(layers, image, {vk::ImageLayout::eUndefined, vk::ImageLayout::eShaderReadOnlyOptimal})); }
+	vram.wait(futures);
+	f64 const ms = std::chrono::duration<f64, std::milli>(clock_t::now() - start).count();
+	f64 const mbps = f64(images.size() * layerCount * pixels.size()) / f64(1 << 20) / (ms / 1000.0);
+	std::cout << "VRAM::copy (cubemaps): " << images.size() << " x " << layerCount << " layers in " << ms << "ms (" << mbps << " MiB/s)\n";
+	return ms;
+}
+
+// textureCount Texture::construct calls across textureThreads threads, until all uploads complete
+f64 runTextures(graphics::Device& device, u8 workers, bool coalesce) {
+	graphics::Transfer::CreateInfo transferInfo;
+	transferInfo.workers = workers;
+	transferInfo.coalesce = coalesce;
+	graphics::VRAM vram(&device, transferInfo);
+	graphics::Sampler sampler(&device, {vk::Filter::eLinear, vk::Filter::eLinear});
+	graphics::Bitmap bitmap;
+	bitmap.size = {textureExtent, textureExtent};
+	bitmap.bytes = bytearray(std::size_t(textureExtent * textureExtent * 4), std::byte(0x3f));
+	std::vector<graphics::Texture> textures;
+	textures.reserve(textureCount);
+	for (std::size_t idx = 0; idx < textureCount; ++idx) { textures.emplace_back(&vram); }
+	auto const start = clock_t::now();
+	std::vector<std::thread> threads;
+	for (std::size_t t = 0; t < textureThreads; ++t) {
+		threads.emplace_back([&, t]() {
+			for (std::size_t idx = t; idx < textures.size(); idx += textureThreads) {
+				graphics::Texture::CreateInfo info;
+				info.sampler = sampler.sampler();
+				info.data = bitmap;
+				[[maybe_unused]] bool const bConstructed = textures[idx].construct(info);
+				ensure(bConstructed, "Texture construction failed");
+			}
+		});
+	}
+	for (auto& thread : threads) { thread.join(); }
+	for (auto const& texture : textures) { texture.wait(); }
+	f64 const ms = std::chrono::duration<f64, std::milli>(clock_t::now() - start).count();
+	auto const stats = vram.transferStats();
+	std::cout << "Texture::construct (" << (coalesce ? "coalesced" : std::to_string(workers) + " workers") << "): " << textureCount << " x " << textureExtent
+			  << "^2 from " << textureThreads << " threads in " << ms << "ms (" << stats.recorded << " copies, " << stats.submitted << " command buffers, "
+			  << stats.batches << " submits)\n";
+	vram.waitIdle();
+	return ms;
+}
+
+// one upload in flight at a time: time from VRAM::stage() until its future is ready
+void runLatency(graphics::Device& device, graphics::Transfer::Completion completion) {
+	graphics::Transfer::CreateInfo transferInfo;
+	transferInfo.completion = completion;
+	graphics::VRAM vram(&device, transferInfo);
+	auto buffer = vram.makeBuffer(latencySize, vk::BufferUsageFlagBits::eVertexBuffer | vk::BufferUsageFlagBits::eTransferDst, false);
+	bytearray const source(latencySize, std::byte(0x5a));
+	std::vector<f64> latencies;
+	latencies.reserve(latencyCount);
+	for (std::size_t idx = 0; idx < latencyCount; ++idx) {
+		auto const start = clock_t::now();
+		vram.stage(buffer, source.data(), source.size()).wait();
+		latencies.push_back(std::chrono::duration<f64, std::micro>(clock_t::now() - start).count());
+	}
+	std::sort(latencies.begin(), latencies.end());
+	auto const pc = [&latencies](f64 p) { return latencies[std::size_t(p * f64(latencies.size() - 1))]; };
+	std::cout << "upload latency (" << (completion == graphics::Transfer::Completion::eWait ? "fence wait" : "3ms poll") << "): p50 " << pc(0.5) << "us, p90 "
+			  << pc(0.9) << "us, p99 " << pc(0.99) << "us, max " << latencies.back() << "us\n";
+	vram.waitIdle();
+}
+} // namespace
+
+int main() {
+	graphics::Instance instance;
+	auto device = makeDevice(instance);
+	if (!device) { return 0; }
+	graphics::VRAM vram(&*device);
+	bytearray source(uploadSize, {});
+	for (std::size_t idx = 0; idx < source.size(); ++idx) { source[idx] = std::byte(idx & 0xff); }
+	// warm up (staging blocks, allocator pools)
+	(void)run("warm up", vram, [&](graphics::Buffer& buffer) { return vram.stage(buffer, source.data(), source.size()); });
+	// cost of one extra host copy per upload (not the previous VRAM::stage, which is no longer in the tree)
+	f64 const copied = run("VRAM::stage (+ host copy)", vram, [&](graphics::Buffer& buffer) {
+		bytearray copy(source.size(), {});
+		std::memcpy(copy.data(), source.data(), copy.size());
+		return vram.stage(buffer, copy.data(), copy.size());
+	});
+	f64 const direct = run("VRAM::stage", vram, [&](graphics::Buffer& buffer) { return vram.stage(buffer, source.data(), source.size()); });
+	runImages(vram, bytearray(layerExtent * layerExtent * 4, std::byte(0x7f)));
+	auto const staging = vram.transferStats().staging;
+	std::cout << "staging: peak " << (staging.peak >> 20) << "MiB / capacity " << (staging.capacity >> 20) << "MiB, " << staging.stalls << " stalls\n";
+	std::cout << "host copy overhead: " << copied - direct << "ms\n";
+	vram.waitIdle();
+	// single worker recording a command buffer per upload (the previous Transfer behaviour)
+	f64 const single = runTextures(*device, 1, false);
+	auto const workers = (u8)std::clamp(std::thread::hardware_concurrency() / 2, 2U, 8U);
+	f64 const multi = runTextures(*device, workers, false);
+	f64 const coalesced = runTextures(*device, 1, true);
+	std::cout << "speedup (workers): " << single / multi << "x\n";
+	std::cout << "speedup (coalesced): " << single / coalesced << "x\n";
+	// batches completed by a 3ms poll (the previous Transfer behaviour)
+	runLatency(*device, graphics::Transfer::Completion::ePoll);
+	runLatency(*device, graphics::Transfer::Completion::eWait);
+}
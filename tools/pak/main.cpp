@@ -0,0 +1,15 @@
+#include <iostream>
+#include <core/io/pak.hpp>
+#include <core/io/path.hpp>
+
+int main(int argc, char const* const argv[]) {
+	using namespace le;
+	if (argc < 3) {
+		std::cerr << "Usage: " << argv[0] << " <source directory> <output .pak>\n";
+		return 1;
+	}
+	auto const count = io::pak::pack(argv[1], argv[2]);
+	if (count < 0) { return 1; }
+	std::cout << "Packed " << count << " files from [" << argv[1] << "] into [" << argv[2] << "]\n";
+	return 0;
+}